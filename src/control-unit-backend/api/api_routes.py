@@ -204,6 +204,47 @@ def reset_alarm():
         return jsonify({"error": "Internal server error"}), 500
 
 
+@api_bp.route('/sampling/override', methods=['POST'])
+def set_sampling_override():
+    """
+    Force the ESP32 sampling interval or return control to its local policy.
+    
+    Expected JSON payload:
+    {
+        "frequency": <seconds between 1 and 600, or 0 to clear the override>
+    }
+    
+    Returns:
+        JSON response indicating success or failure
+    """
+    try:
+        control_logic = get_control_logic()
+
+        data = request.get_json()
+        if not data or 'frequency' not in data:
+            logger.warning("Invalid sampling override request: missing frequency")
+            return jsonify({"message": "Missing 'frequency' in request body"}), 400
+
+        try:
+            frequency = int(data['frequency'])
+            if frequency != 0 and not (1 <= frequency <= 600):
+                logger.warning(f"Invalid sampling frequency: {frequency}")
+                return jsonify({"message": "Frequency must be 0 or between 1 and 600 seconds"}), 400
+        except (ValueError, TypeError):
+            logger.warning(f"Invalid frequency format: {data['frequency']}")
+            return jsonify({"message": "Invalid frequency value"}), 400
+
+        if control_logic.set_sampling_override(frequency):
+            message = f"Sampling interval forced to {frequency}s" if frequency else "Sampling override cleared"
+            return jsonify({"message": message}), 200
+        else:
+            return jsonify({"message": "Failed to publish sampling override"}), 503
+
+    except Exception as e:
+        logger.error(f"Error setting sampling override: {e}", exc_info=True)
+        return jsonify({"error": "Internal server error"}), 500
+
+
 # Error handlers for the API blueprint
 @api_bp.errorhandler(404)
 def not_found(error):
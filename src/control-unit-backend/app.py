@@ -98,6 +98,10 @@ def signal_handler(sig, frame):
     """
     logger.info("Shutdown signal received. Cleaning up...")
     
+    # Stop re-evaluating the held temperature
+    if control_logic_instance:
+        control_logic_instance.stop_heartbeat_monitor()
+
     # Stop MQTT communication
     if mqtt_handler_instance:
         mqtt_handler_instance.stop_listening_loop()
@@ -240,6 +244,7 @@ def main():
         # Initialize system state
         logger.info("Initializing system state...")
         control_logic_instance._initialize_state()
+        control_logic_instance.start_heartbeat_monitor()
 
         # Create Flask application
         flask_app = create_flask_app(control_logic_instance)
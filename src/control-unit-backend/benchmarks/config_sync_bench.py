@@ -0,0 +1,390 @@
+"""
+Benchmark of the time the ESP32 needs to get the current sampling override.
+
+Measures time-to-correct-config - from opening the broker connection to
+receiving the override the backend set last - for the previous MQTT setup
+(clean session, QoS 0 subscription, override not retained) and the current
+one (stable client ID with a persistent session, QoS 1 subscription,
+retained override), in three scenarios:
+
+- live: the backend changes the override while the ESP32 is connected
+- reboot: the override was set before the ESP32 rebooted
+- outage: the backend changed the override while the ESP32 was offline
+
+The device side speaks raw MQTT 3.1.1 the way PubSubClient does: CONNECT,
+then one SUBSCRIBE per config topic. By default the broker is a minimal
+in-process stand-in for Mosquitto (exact-match topics, retained messages,
+persistent sessions with QoS 1 queueing) that delays every packet it sends
+by --latency-ms to model the WiFi link; --broker host:port runs the same
+scenarios against a real Mosquitto instead. A config that has not arrived
+after --timeout-ms is reported as lost.
+
+Run from the control-unit-backend directory:
+    python -m benchmarks.config_sync_bench [--broker host:port] [--latency-ms N] [repeats]
+"""
+
+import argparse
+import queue
+import socket
+import statistics
+import struct
+import threading
+import time
+
+from config.config import MQTT_TOPIC_SAMPLING_POLICY, MQTT_TOPIC_TEMP_CONTROL
+
+DEVICE_CLIENT_ID = "esp32s3-main-mon-bench"
+BACKEND_CLIENT_ID = "control_unit_backend-bench"
+
+CONNECT, CONNACK, PUBLISH, PUBACK = 0x10, 0x20, 0x30, 0x40
+SUBSCRIBE, SUBACK, PINGREQ, PINGRESP, DISCONNECT = 0x80, 0x90, 0xC0, 0xD0, 0xE0
+
+
+# === MQTT 3.1.1 packet helpers ===
+
+def _utf8(text):
+    data = text.encode("utf-8")
+    return struct.pack("!H", len(data)) + data
+
+
+def _packet(kind, body):
+    length, encoded = len(body), b""
+    while True:
+        byte, length = length % 128, length // 128
+        encoded += bytes([byte | (0x80 if length else 0)])
+        if not length:
+            return bytes([kind]) + encoded + body
+
+
+def _read_exact(sock, count):
+    data = b""
+    while len(data) < count:
+        chunk = sock.recv(count - len(data))
+        if not chunk:
+            raise ConnectionError("connection closed")
+        data += chunk
+    return data
+
+
+def _read_packet(sock):
+    """Read one packet, returning (first byte, body)."""
+    header = _read_exact(sock, 1)[0]
+    length, shift = 0, 0
+    while True:
+        byte = _read_exact(sock, 1)[0]
+        length |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return header, _read_exact(sock, length)
+
+
+def _connect_packet(client_id, clean_session):
+    flags = 0x02 if clean_session else 0x00
+    return _packet(CONNECT, _utf8("MQTT") + bytes([4, flags]) + struct.pack("!H", 60) + _utf8(client_id))
+
+
+def _publish_packet(topic, payload, qos, retain, packet_id=1):
+    body = _utf8(topic) + (struct.pack("!H", packet_id) if qos else b"") + payload
+    return _packet(PUBLISH | (qos << 1) | (0x01 if retain else 0), body)
+
+
+def _parse_publish(header, body):
+    """Return (topic, payload, qos, retain, packet id) of a PUBLISH body."""
+    qos = (header >> 1) & 0x03
+    topic_len = struct.unpack_from("!H", body)[0]
+    topic = body[2:2 + topic_len].decode("utf-8")
+    offset = 2 + topic_len
+    packet_id = None
+    if qos:
+        packet_id = struct.unpack_from("!H", body, offset)[0]
+        offset += 2
+    return topic, body[offset:], qos, bool(header & 0x01), packet_id
+
+
+# === Broker stand-in ===
+
+class _Session:
+    def __init__(self):
+        self.subscriptions = {}     # topic -> granted QoS
+        self.queue = []             # (topic, payload) QoS 1 messages received while offline
+        self.connection = None
+
+
+class StandInBroker:
+    """Minimal MQTT 3.1.1 broker with retained messages and persistent sessions."""
+
+    def __init__(self, latency_s):
+        self.latency_s = latency_s
+        self.retained = {}
+        self.sessions = {}
+        self.outboxes = {}          # connection -> queue of (due time, packet)
+        self.lock = threading.Lock()
+        self.server = socket.create_server(("127.0.0.1", 0))
+        self.port = self.server.getsockname()[1]
+        threading.Thread(target=self._accept, daemon=True).start()
+
+    def _accept(self):
+        while True:
+            conn, _ = self.server.accept()
+            conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            threading.Thread(target=self._serve, args=(conn,), daemon=True).start()
+
+    def _sender(self, conn, outbox):
+        """Write each packet latency_s after it was queued, in order."""
+        while True:
+            due, packet = outbox.get()
+            if packet is None:
+                conn.close()
+                return
+            time.sleep(max(0.0, due - time.monotonic()))
+            try:
+                conn.sendall(packet)
+            except OSError:
+                return
+
+    def _send(self, conn, packet):
+        self.outboxes[conn].put((time.monotonic() + self.latency_s, packet))
+
+    def _deliver(self, session, topic, payload, qos):
+        self._send(session.connection, _publish_packet(topic, payload, qos, False))
+
+    def _serve(self, conn):
+        session = None
+        outbox = queue.Queue()
+        with self.lock:
+            self.outboxes[conn] = outbox
+        threading.Thread(target=self._sender, args=(conn, outbox), daemon=True).start()
+        try:
+            header, body = _read_packet(conn)
+            client_id_len = struct.unpack_from("!H", body, 10)[0]
+            client_id = body[12:12 + client_id_len].decode("utf-8")
+            clean = bool(body[7] & 0x02)
+            with self.lock:
+                present = not clean and client_id in self.sessions
+                if not present:
+                    self.sessions[client_id] = _Session()
+                session = self.sessions[client_id]
+                session.connection = conn
+                queued, session.queue = session.queue, []
+                self._send(conn, _packet(CONNACK, bytes([1 if present else 0, 0])))
+                for topic, payload in queued:
+                    self._send(conn, _publish_packet(topic, payload, 1, False))
+
+            while True:
+                header, body = _read_packet(conn)
+                kind = header & 0xF0
+                if kind == SUBSCRIBE:
+                    packet_id = body[:2]
+                    topic_len = struct.unpack_from("!H", body, 2)[0]
+                    topic = body[4:4 + topic_len].decode("utf-8")
+                    qos = min(body[4 + topic_len], 1)
+                    with self.lock:
+                        session.subscriptions[topic] = qos
+                        self._send(conn, _packet(SUBACK, packet_id + bytes([qos])))
+                        if topic in self.retained:
+                            self._send(conn, _publish_packet(topic, self.retained[topic], qos, True))
+                elif kind == PUBLISH:
+                    topic, payload, qos, retain, packet_id = _parse_publish(header, body)
+                    if qos:
+                        self._send(conn, _packet(PUBACK, struct.pack("!H", packet_id)))
+                    with self.lock:
+                        if retain:
+                            if payload:
+                                self.retained[topic] = payload
+                            else:
+                                self.retained.pop(topic, None)
+                        for other in self.sessions.values():
+                            sub_qos = other.subscriptions.get(topic)
+                            if sub_qos is None:
+                                continue
+                            if other.connection:
+                                self._deliver(other, topic, payload, min(qos, sub_qos))
+                            elif qos and sub_qos:
+                                other.queue.append((topic, payload))
+                elif kind == PINGREQ:
+                    self._send(conn, _packet(PINGRESP, b""))
+                elif kind == DISCONNECT:
+                    break
+        except (ConnectionError, OSError):
+            pass
+        finally:
+            with self.lock:
+                if session and session.connection is conn:
+                    session.connection = None
+                    if clean and self.sessions.get(client_id) is session:
+                        del self.sessions[client_id]
+                del self.outboxes[conn]
+            # Packets still queued are written before the connection closes
+            outbox.put((0.0, None))
+
+
+# === Clients ===
+
+class _Client:
+    """Blocking MQTT client that records when each message arrives."""
+
+    def __init__(self, address, client_id, clean_session):
+        self.sock = socket.create_connection(address)
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.sock.sendall(_connect_packet(client_id, clean_session))
+        header, _ = _read_packet(self.sock)
+        assert header & 0xF0 == CONNACK
+
+    def subscribe(self, topic, qos):
+        self.sock.sendall(_packet(SUBSCRIBE | 0x02, struct.pack("!H", 1) + _utf8(topic) + bytes([qos])))
+
+    def publish(self, topic, payload, qos, retain):
+        self.sock.sendall(_publish_packet(topic, payload, qos, retain))
+        if qos:
+            while _read_packet(self.sock)[0] & 0xF0 != PUBACK:
+                pass
+
+    def wait_for(self, topic, payload, deadline):
+        """Return True once payload arrives on topic before the monotonic deadline."""
+        while True:
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                return False
+            self.sock.settimeout(remaining)
+            try:
+                header, body = _read_packet(self.sock)
+            except socket.timeout:
+                return False
+            if header & 0xF0 != PUBLISH:
+                continue
+            got_topic, got_payload, qos, _, packet_id = _parse_publish(header, body)
+            if qos:
+                self.sock.sendall(_packet(PUBACK, struct.pack("!H", packet_id)))
+            if got_topic == topic and got_payload == payload:
+                return True
+
+    def close(self, clean=True):
+        """Disconnect; clean=False drops the link like a WiFi outage, without DISCONNECT."""
+        try:
+            if clean:
+                self.sock.sendall(_packet(DISCONNECT, b""))
+        finally:
+            self.sock.close()
+
+
+class _Setup:
+    """How the device subscribes and how the backend publishes the override."""
+
+    def __init__(self, name, clean_session, sub_qos, retain):
+        self.name = name
+        self.clean_session = clean_session
+        self.sub_qos = sub_qos
+        self.retain = retain
+
+
+SETUPS = (
+    _Setup("clean, QoS 0, not retained", True, 0, False),
+    _Setup("persistent, QoS 1, retained", False, 1, True),
+)
+
+
+def _device_connect(address, setup):
+    """Connect like MqttManagerImpl::connect() and subscribe to both config topics."""
+    device = _Client(address, DEVICE_CLIENT_ID, setup.clean_session)
+    device.subscribe(MQTT_TOPIC_TEMP_CONTROL, setup.sub_qos)
+    device.subscribe(MQTT_TOPIC_SAMPLING_POLICY, setup.sub_qos)
+    return device
+
+
+def _set_override(backend, setup, seconds):
+    payload = ('{"frequency": %d}' % seconds).encode()
+    backend.publish(MQTT_TOPIC_TEMP_CONTROL, payload, 1, setup.retain)
+    return payload
+
+
+def _timed_connect(address, setup, payload, timeout_s):
+    start = time.monotonic()
+    device = _device_connect(address, setup)
+    ok = device.wait_for(MQTT_TOPIC_TEMP_CONTROL, payload, start + timeout_s)
+    elapsed = time.monotonic() - start
+    return device, (elapsed if ok else None)
+
+
+def _scenario_live(address, backend, setup, timeout_s, seconds):
+    device = _device_connect(address, setup)
+    time.sleep(0.05)  # Subscriptions settled, as in steady operation
+    start = time.monotonic()
+    payload = _set_override(backend, setup, seconds)
+    ok = device.wait_for(MQTT_TOPIC_TEMP_CONTROL, payload, start + timeout_s)
+    elapsed = time.monotonic() - start
+    device.close()
+    return elapsed if ok else None
+
+
+def _scenario_reboot(address, backend, setup, timeout_s, seconds):
+    device = _device_connect(address, setup)
+    payload = _set_override(backend, setup, seconds)
+    device.wait_for(MQTT_TOPIC_TEMP_CONTROL, payload, time.monotonic() + timeout_s)
+    device.close(clean=False)  # Power cycle: the RAM copy of the override is gone
+
+    device, elapsed = _timed_connect(address, setup, payload, timeout_s)
+    device.close()
+    return elapsed
+
+
+def _scenario_outage(address, backend, setup, timeout_s, seconds):
+    device = _device_connect(address, setup)
+    time.sleep(0.05)
+    device.close(clean=False)
+    time.sleep(0.05)  # Broker notices the dropped link
+    payload = _set_override(backend, setup, seconds)
+
+    device, elapsed = _timed_connect(address, setup, payload, timeout_s)
+    device.close()
+    return elapsed
+
+
+SCENARIOS = (
+    ("live", _scenario_live),
+    ("reboot", _scenario_reboot),
+    ("outage", _scenario_outage),
+)
+
+
+def _reset_broker_state(address, backend):
+    """Clear the retained override and the device's persistent session."""
+    backend.publish(MQTT_TOPIC_TEMP_CONTROL, b"", 1, True)
+    _Client(address, DEVICE_CLIENT_ID, True).close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("repeats", nargs="?", type=int, default=20)
+    parser.add_argument("--broker", help="host:port of a real broker instead of the stand-in")
+    parser.add_argument("--latency-ms", type=float, default=20.0, help="one-way delay of the stand-in broker")
+    parser.add_argument("--timeout-ms", type=float, default=2000.0, help="time after which a config counts as lost")
+    args = parser.parse_args()
+
+    if args.broker:
+        host, _, port = args.broker.partition(":")
+        address = (host, int(port or 1883))
+        print(f"Broker: {args.broker}")
+    else:
+        broker = StandInBroker(args.latency_ms / 1000)
+        address = ("127.0.0.1", broker.port)
+        print(f"Broker: in-process stand-in, {args.latency_ms:.0f} ms one-way latency")
+    timeout_s = args.timeout_ms / 1000
+
+    backend = _Client(address, BACKEND_CLIENT_ID, True)
+    print(f"{'scenario':<8} {'setup':<29} {'received':>9} {'median ms':>10} {'max ms':>8}")
+    for name, scenario in SCENARIOS:
+        for setup in SETUPS:
+            times = []
+            for i in range(args.repeats):
+                _reset_broker_state(address, backend)
+                times.append(scenario(address, backend, setup, timeout_s, 5 + i % 50))
+            received = [t * 1000 for t in times if t is not None]
+            median = f"{statistics.median(received):.1f}" if received else "-"
+            worst = f"{max(received):.1f}" if received else "-"
+            print(f"{name:<8} {setup.name:<29} {len(received):>4}/{len(times):<4} {median:>10} {worst:>8}")
+    _reset_broker_state(address, backend)
+    backend.close()
+
+
+if __name__ == "__main__":
+    main()
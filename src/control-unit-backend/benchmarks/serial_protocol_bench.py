@@ -0,0 +1,257 @@
+"""
+Benchmark of the text and binary serial protocols to the Arduino.
+
+Runs the real SerialHandler against an emulated window controller on a
+pseudo-terminal pair: the emulator parses commands the way the firmware
+does (SerialCommandParser for text lines, SerialFrame for binary frames),
+answers HELLO only in binary mode and echoes every SET_POS as a POT
+message, which the handler hands to the control logic. Reported per
+protocol:
+
+- negotiation: the protocol SerialHandler.connect() settled on
+- latency: SET_POS sent to POT echo processed, one command at a time
+- throughput: commands echoed per second, sent back to back
+- wire: bytes per SET_POS / TEMP command and the commands per second a
+  115200 baud 8N1 link carries, the real limit on the Arduino link
+- corruption: single-bit errors injected into encoded commands, and how
+  many the controller would still execute with a wrong value
+
+A pty has no baud rate, so latency and throughput are host overhead
+(encoding, pty, listener thread); compare them with each other only.
+
+Run from the control-unit-backend directory:
+    python -m benchmarks.serial_protocol_bench [round trips]
+"""
+
+import os
+import queue
+import random
+import re
+import statistics
+import sys
+import threading
+import time
+
+import communication.serial_handler as serial_handler
+from communication.serial_frames import (
+    FRAME_DELIMITER, PACKET_HELLO, PACKET_HELLO_ACK, PACKET_POT, PACKET_SET_POS, PACKET_TEMP,
+    SERIAL_FRAME_VERSION, SerialFrameError, decode_packet, encode_packet
+)
+from config.config import SERIAL_BAUDRATE
+
+CORRUPTED_COMMANDS = 20000
+BITS_PER_BYTE_8N1 = 10
+
+_INT_PREFIX = re.compile(rb"\s*[+-]?\d*")
+_FLOAT_PREFIX = re.compile(rb"\s*[+-]?(\d+\.?\d*|\.\d+)([eE][+-]?\d+)?")
+
+
+def _atol(text):
+    """Leading integer of text, 0 if none, as avr-libc atol()."""
+    match = _INT_PREFIX.match(text).group().strip()
+    return int(match) if match not in (b"", b"+", b"-") else 0
+
+
+def _atof(text):
+    """Leading decimal of text, 0 if none, as avr-libc atof()."""
+    match = _FLOAT_PREFIX.match(text)
+    return float(match.group()) if match else 0.0
+
+
+def parse_text_command(line):
+    """SerialCommandParser::parse(): (command, value) or None for an unrecognized line."""
+    line = line.split(b"\x00")[0].strip()
+    if line.startswith(b"SET_POS:"):
+        return "SET_POS", _atol(line[8:])
+    if line.startswith(b"TEMP:"):
+        return "TEMP", round(_atof(line[5:]), 2)
+    if line.startswith(b"ALARM_STATE:"):
+        return "ALARM_STATE", _atol(line[12:]) == 1
+    if line.upper() in (b"MODE:AUTOMATIC", b"MODE:MANUAL"):
+        return "MODE", line.upper()[5:].decode()
+    return None
+
+
+def parse_binary_command(frame):
+    """FramedSerialLink::handlePacket(): (command, value) or None for a dropped frame."""
+    try:
+        packet_type, value = decode_packet(frame)
+    except SerialFrameError:
+        return None
+    if packet_type == PACKET_SET_POS:
+        return "SET_POS", value
+    if packet_type == PACKET_TEMP:
+        return "TEMP", round(value / 100, 2)
+    return packet_type, value
+
+
+class ControllerEmulator:
+    """Window controller on the master side of a pty, speaking one protocol."""
+
+    def __init__(self, master_fd, binary):
+        self.master_fd = master_fd
+        self.binary = binary
+        self.buffer = bytearray()
+        self.stopped = threading.Event()
+        self.thread = threading.Thread(target=self._run, daemon=True)
+        self.thread.start()
+
+    def stop(self):
+        self.stopped.set()
+        self.thread.join(timeout=2)
+
+    def _run(self):
+        while not self.stopped.is_set():
+            try:
+                data = os.read(self.master_fd, 4096)
+            except OSError:
+                return
+            self.buffer += data
+            separator = FRAME_DELIMITER if self.binary else b"\n"
+            *messages, rest = self.buffer.split(separator)
+            self.buffer = bytearray(rest)
+            for message in messages:
+                reply = self._handle(bytes(message))
+                if reply:
+                    os.write(self.master_fd, reply)
+
+    def _handle(self, message):
+        if not message:
+            return None
+        if self.binary:
+            try:
+                packet_type, value = decode_packet(message)
+            except SerialFrameError:
+                return None
+            if packet_type == PACKET_HELLO:
+                return encode_packet(PACKET_HELLO_ACK, SERIAL_FRAME_VERSION)
+            if packet_type == PACKET_SET_POS:
+                return encode_packet(PACKET_POT, value)
+            return None
+        command = parse_text_command(message)
+        if command and command[0] == "SET_POS":
+            return b"POT:%d\r\n" % command[1]
+        return None
+
+
+class EchoControlLogic:
+    """Control logic stand-in that records the POT echoes."""
+
+    def __init__(self):
+        self.echoes = queue.Queue()
+
+    def set_manual_window_opening(self, percentage, source="potentiometer"):
+        self.echoes.put((int(percentage), time.perf_counter()))
+
+    def set_mode(self, mode):
+        pass
+
+
+def _connect(binary):
+    master_fd, slave_fd = os.openpty()
+    emulator = ControllerEmulator(master_fd, binary)
+    logic = EchoControlLogic()
+    handler = serial_handler.SerialHandler(logic)
+    serial_handler.SERIAL_PORT = os.ttyname(slave_fd)
+    start = time.perf_counter()
+    if not handler.connect():
+        raise RuntimeError("cannot open the pty")
+    negotiation_s = time.perf_counter() - start - 2  # connect() waits 2 s for the Arduino reset
+    return master_fd, slave_fd, emulator, logic, handler, negotiation_s
+
+
+def _measure(binary, round_trips):
+    master_fd, slave_fd, emulator, logic, handler, negotiation_s = _connect(binary)
+    try:
+        # The text HELLO fallback ends with a newline the emulator must see first
+        time.sleep(0.05)
+
+        latencies = []
+        for i in range(round_trips):
+            sent = time.perf_counter()
+            handler.send_window_command((i % 101) / 100)
+            value, received = logic.echoes.get(timeout=2)
+            if value != i % 101:
+                raise RuntimeError(f"echo {value} for SET_POS {i % 101}")
+            latencies.append((received - sent) * 1e6)
+
+        start = time.perf_counter()
+        for i in range(round_trips):
+            handler.send_window_command((i % 101) / 100)
+        for _ in range(round_trips):
+            logic.echoes.get(timeout=5)
+        throughput = round_trips / (time.perf_counter() - start)
+    finally:
+        handler.stop_listening()
+        emulator.stop()
+        os.close(master_fd)
+        os.close(slave_fd)
+
+    latencies.sort()
+    return {
+        "protocol": handler.protocol,
+        "negotiation_ms": negotiation_s * 1000,
+        "latency_median_us": statistics.median(latencies),
+        "latency_p99_us": latencies[int(len(latencies) * 0.99) - 1],
+        "throughput": throughput,
+    }
+
+
+def _wire(binary):
+    if binary:
+        set_pos = encode_packet(PACKET_SET_POS, 55)
+        temp = encode_packet(PACKET_TEMP, 2345)
+    else:
+        set_pos = b"SET_POS:55\n"
+        temp = b"TEMP:23.4\n"
+    line_rate = SERIAL_BAUDRATE / BITS_PER_BYTE_8N1
+    return len(set_pos), len(temp), line_rate / len(set_pos)
+
+
+def _corruption(binary, rng):
+    """Flip one random bit per command; count commands executed with a wrong value."""
+    wrong = dropped = 0
+    for _ in range(CORRUPTED_COMMANDS):
+        position = rng.randrange(101)
+        temperature = rng.randrange(1500, 3500)
+        if rng.random() < 0.5:
+            expected = ("SET_POS", position)
+            encoded = encode_packet(PACKET_SET_POS, position) if binary else b"SET_POS:%d\n" % position
+        else:
+            expected = ("TEMP", temperature / 100 if binary else round(temperature / 100, 1))
+            encoded = (encode_packet(PACKET_TEMP, temperature) if binary
+                       else b"TEMP:%.1f\n" % (temperature / 100))
+        corrupted = bytearray(encoded)
+        bit = rng.randrange(len(corrupted) * 8)
+        corrupted[bit // 8] ^= 1 << (bit % 8)
+
+        if binary:
+            commands = [parse_binary_command(bytes(f)) for f in corrupted.split(FRAME_DELIMITER) if f]
+        else:
+            commands = [parse_text_command(bytes(l)) for l in re.split(rb"[\r\n]", bytes(corrupted)) if l]
+        commands = [c for c in commands if c is not None]
+        if any(c != expected for c in commands):
+            wrong += 1
+        elif not commands:
+            dropped += 1
+    return wrong, dropped
+
+
+def main():
+    round_trips = int(sys.argv[1]) if len(sys.argv) > 1 else 2000
+    rng = random.Random(42)
+
+    print(f"{round_trips} round trips per protocol over a pty, {CORRUPTED_COMMANDS} corrupted commands")
+    print(f"{'protocol':<8} {'negotiated':>10} {'neg. ms':>8} {'p50 us':>8} {'p99 us':>8} {'cmd/s':>8} "
+          f"{'SET_POS B':>9} {'TEMP B':>7} {'cmd/s @115200':>13} {'wrong':>7} {'dropped':>8}")
+    for binary in (False, True):
+        result = _measure(binary, round_trips)
+        set_pos_bytes, temp_bytes, line_rate = _wire(binary)
+        wrong, dropped = _corruption(binary, rng)
+        print(f"{'binary' if binary else 'text':<8} {result['protocol']:>10} {result['negotiation_ms']:>8.0f} "
+              f"{result['latency_median_us']:>8.0f} {result['latency_p99_us']:>8.0f} {result['throughput']:>8.0f} "
+              f"{set_pos_bytes:>9} {temp_bytes:>7} {line_rate:>13.0f} {wrong:>7} {dropped:>8}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,90 @@
+"""
+Benchmark of the JSON and binary telemetry encodings.
+
+Compares bytes on the wire and backend decode time per message for the
+payloads the ESP32 publishes: a live sample, a full batch of
+TELEMETRY_BATCH_MAX_SAMPLES (10) samples, the plain "online" status and a
+full status report. Payloads are built exactly as MqttManagerImpl formats
+them; wire size is the MQTT PUBLISH packet (fixed header, topic, payload,
+QoS 0) without TCP/IP overhead.
+
+Run from the control-unit-backend directory:
+    python -m benchmarks.telemetry_codec_bench [repeats]
+"""
+
+import json
+import struct
+import sys
+import timeit
+
+from communication.binary_telemetry import decode_status, decode_temperature
+from config.config import MQTT_TOPIC_BINARY_SUFFIX, MQTT_TOPIC_ESP_STATUS, MQTT_TOPIC_TEMP_DATA
+
+BATCH_SAMPLES = 10
+
+
+def _sample_json(ts, seq, t, sup):
+    return '{"temperature":%.2f,"ts":%d,"seq":%d,"sup":%d}' % (t, ts, seq, sup)
+
+
+def _batch_json(samples):
+    entries = ",".join('{"ts":%d,"seq":%d,"t":%.2f}' % (ts, seq, t) for ts, seq, t in samples)
+    return '{"backlog":false,"samples":[%s]}' % entries
+
+
+def _report_json(fields):
+    return (
+        '{"status":"online","uptime_ms":%d,"boot_to_operational_ms":%d,"connect_to_operational_ms":%d,'
+        '"backlog_samples":%d,"lost_samples":%d,"sampling_overruns":%d,"free_heap":%d,"min_free_heap":%d,'
+        '"max_alloc_heap":%d,"wifi":{"fast_path":true,"fallback":false,"association_ms":%d,'
+        '"ip_config_ms":%d,"total_ms":%d},"deep_sleep":{"cycles":%d,"wake_to_publish_ms":%d,'
+        '"budget_overruns":%d},"reconnect":{"failures":%d,"backoff_ms":%d},"suppressed_samples":%d}'
+        % tuple(fields[:15] + fields[16:] + fields[15:16])
+    )
+
+
+def _samples_binary(samples, flags, sup):
+    body = b"".join(struct.pack("<IIh", seq, ts, round(t * 100)) for ts, seq, t in samples)
+    return struct.pack("<BBH", 3, flags, sup) + body
+
+
+def _wire_bytes(topic, payload):
+    remaining = 2 + len(topic) + len(payload)
+    length_bytes = 1 if remaining < 128 else 2 if remaining < 16384 else 3
+    return 1 + length_bytes + remaining
+
+
+def _cases():
+    samples = [(3600000 + 10000 * i, 360 + i, 23.45 + 0.01 * i) for i in range(BATCH_SAMPLES)]
+    report = [3600000, 4200, 1800, 0, 0, 0, 201344, 187520, 110580, 950, 240, 1190, 0, 0, 0, 17, 3, 7300]
+    temp_bin = MQTT_TOPIC_TEMP_DATA + MQTT_TOPIC_BINARY_SUFFIX
+    status_bin = MQTT_TOPIC_ESP_STATUS + MQTT_TOPIC_BINARY_SUFFIX
+    return [
+        ("sample", MQTT_TOPIC_TEMP_DATA, _sample_json(*samples[0], 3).encode(),
+         temp_bin, _samples_binary(samples[:1], 0, 3), decode_temperature),
+        ("batch x%d" % BATCH_SAMPLES, MQTT_TOPIC_TEMP_DATA, _batch_json(samples).encode(),
+         temp_bin, _samples_binary(samples, 0x02, 0), decode_temperature),
+        ("status", MQTT_TOPIC_ESP_STATUS, b'{"status":"online"}',
+         status_bin, bytes([2, 1, 0, 0]), decode_status),
+        ("status report", MQTT_TOPIC_ESP_STATUS, _report_json(report).encode(),
+         status_bin, bytes([3, 1, 1, 0]) + struct.pack("<18I", *report), decode_status),
+    ]
+
+
+def main():
+    repeats = int(sys.argv[1]) if len(sys.argv) > 1 else 100000
+    print(f"{'message':<16}{'JSON B':>8}{'bin B':>8}{'wire %':>8}{'JSON us':>10}{'bin us':>10}{'speedup':>9}")
+    for name, json_topic, json_payload, bin_topic, bin_payload, decode in _cases():
+        # Decoding has to yield the same dictionary for both encodings of a case
+        assert decode(bin_payload) == json.loads(json_payload.decode("utf-8")), name
+
+        json_s = timeit.timeit(lambda: json.loads(json_payload.decode("utf-8")), number=repeats)
+        bin_s = timeit.timeit(lambda: decode(bin_payload), number=repeats)
+        json_wire = _wire_bytes(json_topic, json_payload)
+        bin_wire = _wire_bytes(bin_topic, bin_payload)
+        print(f"{name:<16}{len(json_payload):>8}{len(bin_payload):>8}{100 * bin_wire / json_wire:>7.0f}%"
+              f"{1e6 * json_s / repeats:>10.2f}{1e6 * bin_s / repeats:>10.2f}{json_s / bin_s:>8.1f}x")
+
+
+if __name__ == "__main__":
+    main()
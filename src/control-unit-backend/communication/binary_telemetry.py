@@ -0,0 +1,138 @@
+"""
+Binary Telemetry Decoder for Control Unit Backend.
+
+This module decodes the fixed-layout little-endian records the ESP32
+publishes on the "/bin" temperature and status topics when it is built with
+TELEMETRY_BINARY_ENABLED (layout in BinaryTelemetry.h). Records are turned
+into the same dictionaries the JSON payloads parse to, so the message
+processing is shared between both encodings.
+"""
+
+import struct
+
+BINARY_TELEMETRY_VERSION = 3
+
+_TEMPERATURE_HEADER = struct.Struct("<BBH")     # version, flags, suppressed
+_SAMPLE_ENTRY = struct.Struct("<IIh")           # sequence, timestamp ms, centi-degrees (control temperature)
+_CHANNEL_READING = struct.Struct("<h")          # centi-degrees of one channel, after each entry from version 3
+_STATUS_HEADER = struct.Struct("<BBBx")         # version, status code, wifi flags
+
+FLAG_BACKLOG = 0x01
+FLAG_BATCH = 0x02
+FLAG_CHANNELS_SHIFT = 4                         # Bits 4..7: channel readings per entry, 0 for a single sensor
+FLAG_WIFI_FAST_PATH = 0x01
+FLAG_WIFI_FALLBACK = 0x02
+
+_STATUS_KEYWORDS = {1: "online", 2: "offline"}
+
+# u32 fields of a full status report, in BinaryStatusField order
+_STATUS_FIELDS_V1 = (
+    "uptime_ms", "boot_to_operational_ms", "connect_to_operational_ms",
+    "backlog_samples", "lost_samples", "sampling_overruns",
+    "free_heap", "min_free_heap", "max_alloc_heap",
+    "wifi.association_ms", "wifi.ip_config_ms", "wifi.total_ms",
+    "deep_sleep.cycles", "deep_sleep.wake_to_publish_ms", "deep_sleep.budget_overruns",
+    "suppressed_samples",
+)
+# Version 2 appended the reconnect backoff; devices not yet updated still send version 1
+_STATUS_FIELDS = {
+    1: _STATUS_FIELDS_V1,
+    2: _STATUS_FIELDS_V1 + ("reconnect.failures", "reconnect.backoff_ms"),
+}
+# Version 3 added the channel readings to temperature records only
+_STATUS_FIELDS[3] = _STATUS_FIELDS[2]
+_STATUS_REPORT = {version: struct.Struct("<" + "I" * len(fields)) for version, fields in _STATUS_FIELDS.items()}
+
+
+class BinaryTelemetryError(ValueError):
+    """Raised for a truncated record or a record of an unknown layout version."""
+
+
+def _check_version(payload):
+    """Raise BinaryTelemetryError unless the record starts with a known layout version."""
+    if not payload:
+        raise BinaryTelemetryError("empty binary record")
+    if payload[0] not in _STATUS_FIELDS:
+        raise BinaryTelemetryError(f"unsupported binary record version {payload[0]}")
+
+
+def decode_temperature(payload):
+    """
+    Decode a binary temperature record.
+
+    Args:
+        payload: Raw MQTT payload (bytes)
+
+    Returns:
+        dict: {"temperature", "ts", "seq", "sup"} for a live sample, or
+              {"backlog", "samples": [{"ts", "seq", "t"}, ...]} for a batch;
+              samples of a multi-channel device also carry "ch", the
+              reading of each channel
+
+    Raises:
+        BinaryTelemetryError: If the record is truncated or of an unknown version
+    """
+    _check_version(payload)
+    if len(payload) < _TEMPERATURE_HEADER.size:
+        raise BinaryTelemetryError(f"malformed binary temperature record of {len(payload)} bytes")
+    _, flags, suppressed = _TEMPERATURE_HEADER.unpack_from(payload)
+    channels = flags >> FLAG_CHANNELS_SHIFT
+    entry_size = _SAMPLE_ENTRY.size + channels * _CHANNEL_READING.size
+    body_len = len(payload) - _TEMPERATURE_HEADER.size
+    if body_len <= 0 or body_len % entry_size:
+        raise BinaryTelemetryError(f"malformed binary temperature record of {len(payload)} bytes")
+
+    if channels:
+        entry = struct.Struct(_SAMPLE_ENTRY.format + "h" * channels)
+        samples = [
+            {"ts": ts, "seq": seq, "t": centi / 100, "ch": [reading / 100 for reading in readings]}
+            for seq, ts, centi, *readings in entry.iter_unpack(memoryview(payload)[_TEMPERATURE_HEADER.size:])
+        ]
+    else:
+        samples = [
+            {"ts": ts, "seq": seq, "t": centi / 100}
+            for seq, ts, centi in _SAMPLE_ENTRY.iter_unpack(memoryview(payload)[_TEMPERATURE_HEADER.size:])
+        ]
+
+    if flags & FLAG_BATCH:
+        return {"backlog": bool(flags & FLAG_BACKLOG), "samples": samples}
+    sample = samples[0]
+    data = {"temperature": sample["t"], "ts": sample["ts"], "seq": sample["seq"], "sup": suppressed}
+    if channels:
+        data["ch"] = sample["ch"]
+    return data
+
+
+def decode_status(payload):
+    """
+    Decode a binary status record.
+
+    Args:
+        payload: Raw MQTT payload (bytes)
+
+    Returns:
+        dict: {"status"} for a plain status, plus the report fields (with
+              nested "wifi", "deep_sleep" and, from version 2, "reconnect"
+              blocks) for a full report
+
+    Raises:
+        BinaryTelemetryError: If the record is truncated or of an unknown version
+    """
+    _check_version(payload)
+    report = _STATUS_REPORT[payload[0]]
+    if len(payload) not in (_STATUS_HEADER.size, _STATUS_HEADER.size + report.size):
+        raise BinaryTelemetryError(f"malformed binary status record of {len(payload)} bytes")
+
+    version, code, flags = _STATUS_HEADER.unpack_from(payload)
+    data = {"status": _STATUS_KEYWORDS.get(code, "unknown")}
+    if len(payload) == _STATUS_HEADER.size:
+        return data
+
+    data["wifi"] = {
+        "fast_path": bool(flags & FLAG_WIFI_FAST_PATH),
+        "fallback": bool(flags & FLAG_WIFI_FALLBACK),
+    }
+    for name, value in zip(_STATUS_FIELDS[version], report.unpack_from(payload, _STATUS_HEADER.size)):
+        block, _, field = name.rpartition(".")
+        (data.setdefault(block, {}) if block else data)[field] = value
+    return data
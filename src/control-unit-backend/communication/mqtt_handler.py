@@ -14,8 +14,14 @@ from config.config import (
     MQTT_BROKER_PORT, 
     MQTT_TOPIC_TEMP_DATA, 
     MQTT_TOPIC_TEMP_CONTROL,
-    MQTT_TOPIC_ESP_STATUS
+    MQTT_TOPIC_ESP_STATUS,
+    MQTT_TOPIC_SAMPLING_POLICY,
+    MQTT_TOPIC_ESP_METRICS,
+    MQTT_TOPIC_ESP_STATS,
+    MQTT_TOPIC_BINARY_SUFFIX,
+    ESP_LOOP_STALL_WARN_US
 )
+from communication.binary_telemetry import BinaryTelemetryError, decode_temperature, decode_status
 
 logger = logging.getLogger(__name__)
 
@@ -60,16 +66,30 @@ class MqttHandler:
         if rc == 0:
             logger.info(f"Successfully connected to MQTT Broker at {MQTT_BROKER_ADDRESS}:{MQTT_BROKER_PORT}")
             
-            # Subscribe to temperature data topic
+            # Subscribe to temperature data topic, JSON and binary encoding
             self.client.subscribe(MQTT_TOPIC_TEMP_DATA)
-            logger.info(f"Subscribed to temperature topic: {MQTT_TOPIC_TEMP_DATA}")
+            self.client.subscribe(MQTT_TOPIC_TEMP_DATA + MQTT_TOPIC_BINARY_SUFFIX)
+            logger.info(f"Subscribed to temperature topic: {MQTT_TOPIC_TEMP_DATA}[{MQTT_TOPIC_BINARY_SUFFIX}]")
             
             # Subscribe to ESP status topic if configured
             if MQTT_TOPIC_ESP_STATUS:
                 self.client.subscribe(MQTT_TOPIC_ESP_STATUS)
-                logger.info(f"Subscribed to ESP status topic: {MQTT_TOPIC_ESP_STATUS}")
+                self.client.subscribe(MQTT_TOPIC_ESP_STATUS + MQTT_TOPIC_BINARY_SUFFIX)
+                logger.info(f"Subscribed to ESP status topic: {MQTT_TOPIC_ESP_STATUS}[{MQTT_TOPIC_BINARY_SUFFIX}]")
+
+            self.client.subscribe(MQTT_TOPIC_ESP_METRICS)
+            logger.info(f"Subscribed to ESP metrics topic: {MQTT_TOPIC_ESP_METRICS}")
+
+            self.client.subscribe(MQTT_TOPIC_ESP_STATS)
+            logger.info(f"Subscribed to ESP statistics topic: {MQTT_TOPIC_ESP_STATS}")
             
             self.connected = True
+
+            # Retained: the ESP32 receives the policy and the override on every (re)connect and
+            # waits for both before sampling; republishing replaces a previous run's override
+            thresholds, intervals = self.control_logic.get_sampling_policy()
+            self.publish_sampling_policy(thresholds, intervals)
+            self.publish_sampling_frequency(self.control_logic.sampling_override_s or 0)
         else:
             logger.error(f"Failed to connect to MQTT Broker, return code {rc}")
             self.connected = False
@@ -90,25 +110,46 @@ class MqttHandler:
         """
         Callback executed when a message is received on a subscribed topic.
         
+        Topics ending in MQTT_TOPIC_BINARY_SUFFIX carry binary records, which
+        are decoded into the same dictionaries as their JSON counterparts.
+        
         Args:
             client: The MQTT client instance
             userdata: User-defined data passed to callbacks
             msg: The received message object containing topic and payload
         """
         try:
-            payload_str = msg.payload.decode('utf-8')
-            logger.debug(f"Received MQTT message on topic '{msg.topic}': {payload_str}")
-            data = json.loads(payload_str)
+            topic = msg.topic
+            if topic.endswith(MQTT_TOPIC_BINARY_SUFFIX):
+                topic = topic[:-len(MQTT_TOPIC_BINARY_SUFFIX)]
+                logger.debug(f"Received binary MQTT message on topic '{msg.topic}': {msg.payload.hex()}")
+                if topic == MQTT_TOPIC_TEMP_DATA:
+                    data = decode_temperature(msg.payload)
+                elif topic == MQTT_TOPIC_ESP_STATUS:
+                    data = decode_status(msg.payload)
+                else:
+                    logger.debug(f"Binary message received on unhandled topic: {msg.topic}")
+                    return
+            else:
+                payload_str = msg.payload.decode('utf-8')
+                logger.debug(f"Received MQTT message on topic '{msg.topic}': {payload_str}")
+                data = json.loads(payload_str)
 
-            if msg.topic == MQTT_TOPIC_TEMP_DATA:
+            if topic == MQTT_TOPIC_TEMP_DATA:
                 self._process_temperature_data(data)
-            elif msg.topic == MQTT_TOPIC_ESP_STATUS:
+            elif topic == MQTT_TOPIC_ESP_STATUS:
                 self._process_esp_status(data)
+            elif msg.topic == MQTT_TOPIC_ESP_METRICS:
+                self._process_loop_metrics(data)
+            elif msg.topic == MQTT_TOPIC_ESP_STATS:
+                self._process_temperature_summary(data)
             else:
                 logger.debug(f"Message received on unhandled topic: {msg.topic}")
 
         except json.JSONDecodeError:
             logger.error(f"Failed to decode JSON from MQTT message: {msg.payload.decode('utf-8')}")
+        except BinaryTelemetryError as e:
+            logger.error(f"Failed to decode binary MQTT message on '{msg.topic}': {e}")
         except Exception as e:
             logger.error(f"Error processing MQTT message: {e}", exc_info=True)
 
@@ -116,16 +157,88 @@ class MqttHandler:
         """
         Process incoming temperature data from ESP32.
         
+        Accepts both single-sample messages ({"temperature": XX.YY, "ts": T, "seq": N, "sup": S})
+        and batched messages ({"backlog": false, "samples": [{"ts": T, "seq": N, "t": XX.YY}, ...]}).
+        Multi-channel ESP32 builds add "ch": [XX.YY, ...], the reading of each channel, to every sample.
+        
         Args:
             data: Dictionary containing temperature data from JSON payload
         """
-        if "temperature" in data:
+        if "samples" in data:
+            self._process_temperature_batch(data["samples"], data.get("backlog", False))
+        elif "temperature" in data:
             temperature = data["temperature"]
             logger.debug(f"Processing temperature data: {temperature}°C")
-            self.control_logic.process_new_temperature(temperature)
+            # "sup": samples held back in the ESP32 deadband since the previous publish
+            self.control_logic.record_sample_timing(data.get("ts"), data.get("seq"), suppressed=data.get("sup", 0))
+            self.control_logic.process_new_temperature(temperature, self._channel_readings(data))
         else:
             logger.warning(f"Received temperature data without 'temperature' field: {data}")
 
+    def _process_temperature_batch(self, samples, backlog=False):
+        """
+        Unpack a batch of temperature samples and process them in order.
+        
+        Backlog batches carry samples queued by the ESP32 during a network
+        outage: they only fill the history and statistics, since acting on
+        stale readings would move the window based on past conditions.
+        
+        Args:
+            samples: List of {"ts": device_millis, "seq": sequence, "t": temperature, "ch": [readings]}
+                     entries, oldest first ("ch" from multi-channel ESP32 builds only)
+            backlog: True if the samples were queued during a network outage
+        """
+        if not isinstance(samples, list):
+            logger.warning(f"Received malformed temperature batch: {samples}")
+            return
+
+        logger.debug(f"Processing {'backlog' if backlog else 'temperature'} batch of {len(samples)} samples")
+        for sample in samples:
+            if isinstance(sample, dict) and "t" in sample:
+                self.control_logic.record_sample_timing(sample.get("ts"), sample.get("seq"), backlog)
+                if backlog:
+                    self.control_logic.process_backlog_temperature(sample["t"], self._channel_readings(sample))
+                else:
+                    self.control_logic.process_new_temperature(sample["t"], self._channel_readings(sample))
+            else:
+                logger.warning(f"Skipping malformed sample in temperature batch: {sample}")
+
+    @staticmethod
+    def _channel_readings(sample):
+        """Return the per-channel readings of a sample, or None if absent or malformed."""
+        channels = sample.get("ch")
+        if isinstance(channels, list) and channels and all(isinstance(c, (int, float)) for c in channels):
+            return channels
+        if channels is not None:
+            logger.warning(f"Ignoring malformed channel readings: {channels}")
+        return None
+
+    def _process_temperature_summary(self, data):
+        """
+        Process a windowed temperature summary from the ESP32.
+        
+        The ESP32 aggregates every sample it takes, including the ones held
+        back by its deadband or queued during an outage, so the summary
+        covers readings the backend never received individually. With
+        "raw": false the summaries are the only temperatures published and
+        the last reading of the window also drives the control logic.
+        
+        Args:
+            data: Dictionary {"ts": [first, last], "seq": [first, last], "n": N, "mean": M,
+                  "var": V, "min": MIN, "max": MAX, "last": T, "raw": bool} from the JSON payload
+        """
+        required = ("n", "mean", "var", "min", "max")
+        if not all(isinstance(data.get(key), (int, float)) for key in required) or data["n"] < 1:
+            logger.warning(f"Received malformed temperature summary: {data}")
+            return
+
+        logger.debug(f"Processing temperature summary of {data['n']} samples, seq {data.get('seq')}")
+        self.control_logic.process_temperature_summary(
+            data["n"], data["mean"], data["var"], data["min"], data["max"]
+        )
+        if data.get("raw") is False and "last" in data:
+            self.control_logic.process_new_temperature(data["last"])
+
     def _process_esp_status(self, data):
         """
         Process ESP32 status updates.
@@ -136,10 +249,71 @@ class MqttHandler:
         if "status" in data:
             esp_status = data["status"]
             logger.debug(f"Processing ESP status update: {esp_status}")
+            if "connect_to_operational_ms" in data:
+                wifi = data.get("wifi", {})
+                logger.info(
+                    f"ESP connection metrics: connect->operational={data['connect_to_operational_ms']}ms, "
+                    f"boot->operational={data.get('boot_to_operational_ms')}ms, "
+                    f"association={wifi.get('association_ms')}ms, ip_config={wifi.get('ip_config_ms')}ms, "
+                    f"fast_path={wifi.get('fast_path')}"
+                )
+            if "min_free_heap" in data:
+                logger.info(
+                    f"ESP heap: free={data.get('free_heap')} bytes, "
+                    f"min_free={data['min_free_heap']} bytes, max_alloc={data.get('max_alloc_heap')} bytes"
+                )
+            deep_sleep = data.get("deep_sleep", {})
+            if deep_sleep.get("cycles"):
+                logger.info(
+                    f"ESP duty cycle: sleeps={deep_sleep['cycles']}, "
+                    f"wake->publish={deep_sleep.get('wake_to_publish_ms')}ms, "
+                    f"over budget={deep_sleep.get('budget_overruns')}"
+                )
+            reconnect = data.get("reconnect", {})
+            if reconnect.get("failures"):
+                logger.info(
+                    f"ESP recovered after {reconnect['failures']} failed reconnects, "
+                    f"longest backoff={reconnect.get('backoff_ms')}ms"
+                )
+            if data.get("suppressed_samples"):
+                logger.info(f"ESP deadband suppressed {data['suppressed_samples']} unchanged samples since boot")
+            if data.get("sampling_overruns"):
+                logger.warning(f"ESP dropped {data['sampling_overruns']} samples: FSM fell behind the sampling task")
             self.control_logic.update_esp_status(esp_status, data)
         else:
             logger.warning(f"Received ESP status without 'status' field: {data}")
 
+    def _process_loop_metrics(self, data):
+        """
+        Process the ESP32 loop timing histograms.
+        
+        Each slot is an FSM state (time spent in run()), "mqtt_loop"
+        (time spent in PubSubClient::loop()) or "config_wake" (idle sleep a
+        config message arrived in, i.e. its worst-case wake-up latency),
+        summarized as [count, min_us, p50_us, p99_us, max_us] over the
+        reporting window.
+        
+        Args:
+            data: Dictionary with "window_ms" and "slots" from the JSON payload
+        """
+        slots = data.get("slots")
+        if not isinstance(slots, dict):
+            logger.warning(f"Received malformed loop metrics: {data}")
+            return
+
+        metrics = {}
+        for name, values in slots.items():
+            if not isinstance(values, list) or len(values) != 5:
+                logger.warning(f"Skipping malformed loop metrics slot '{name}': {values}")
+                continue
+            count, min_us, p50_us, p99_us, max_us = values
+            metrics[name] = {"count": count, "min_us": min_us, "p50_us": p50_us, "p99_us": p99_us, "max_us": max_us}
+            if max_us >= ESP_LOOP_STALL_WARN_US:
+                logger.warning(f"ESP loop stall in '{name}': max={max_us}us, p99<={p99_us}us over {count} cycles")
+
+        logger.debug(f"ESP loop metrics over {data.get('window_ms')}ms: {metrics}")
+        self.control_logic.update_loop_metrics(data.get("window_ms"), metrics)
+
     def connect(self):
         """
         Establish connection to the MQTT broker.
@@ -186,17 +360,46 @@ class MqttHandler:
         
         self.connected = False
 
+    def publish_sampling_policy(self, thresholds, intervals):
+        """
+        Publish the retained sampling policy to the ESP32.
+        
+        The ESP32 switches its sampling interval locally whenever a sample
+        falls into another band, without waiting for the backend.
+        
+        Args:
+            thresholds: Ascending temperature band boundaries in °C
+            intervals: Sampling interval in seconds per band (one more than thresholds)
+        """
+        if self.client and self.connected:
+            try:
+                payload = json.dumps({"thresholds": thresholds, "intervals": intervals})
+                result = self.client.publish(MQTT_TOPIC_SAMPLING_POLICY, payload, qos=1, retain=True)
+                logger.info(f"Published sampling policy {payload} to {MQTT_TOPIC_SAMPLING_POLICY}")
+                return result.rc == mqtt.MQTT_ERR_SUCCESS
+            except Exception as e:
+                logger.error(f"Error publishing sampling policy: {e}", exc_info=True)
+                return False
+        else:
+            logger.warning("Cannot publish sampling policy: MQTT client not connected or not initialized.")
+            return False
+
     def publish_sampling_frequency(self, frequency_seconds):
         """
-        Publish sampling frequency command to ESP32.
+        Publish the retained sampling frequency override to the ESP32.
+        
+        The override takes precedence over the sampling policy until it is
+        cleared by publishing a frequency of 0. Retained and QoS 1, so an
+        ESP32 that reboots receives it on subscribing and one that was offline
+        receives it from its persistent session.
         
         Args:
-            frequency_seconds: Sampling interval in seconds to send to ESP32
+            frequency_seconds: Sampling interval in seconds to send to ESP32, 0 to clear the override
         """
         if self.client and self.connected:
             try:
                 payload = json.dumps({"frequency": frequency_seconds})
-                result = self.client.publish(MQTT_TOPIC_TEMP_CONTROL, payload, qos=1)
+                result = self.client.publish(MQTT_TOPIC_TEMP_CONTROL, payload, qos=1, retain=True)
                 logger.info(f"Published sampling frequency {frequency_seconds}s to {MQTT_TOPIC_TEMP_CONTROL}")
                 return result.rc == mqtt.MQTT_ERR_SUCCESS
             except Exception as e:
@@ -0,0 +1,122 @@
+"""
+Binary Serial Frames for Control Unit Backend.
+
+This module encodes and decodes the packets of the binary protocol the
+Arduino window controller speaks when it is built with
+SERIAL_BINARY_PROTOCOL (layout in SerialFrame.h): a type byte, a
+fixed-width little-endian payload and a CRC-8, COBS-encoded and sent as
+0x00 <frame> 0x00.
+"""
+
+import struct
+
+SERIAL_FRAME_VERSION = 1
+FRAME_DELIMITER = b"\x00"
+
+# Control Unit -> window controller
+PACKET_HELLO = 0x01
+PACKET_SET_POS = 0x02
+PACKET_TEMP = 0x03
+PACKET_ALARM_STATE = 0x04
+PACKET_MODE = 0x05
+# Window controller -> Control Unit
+PACKET_HELLO_ACK = 0x81
+PACKET_POT = 0x82
+PACKET_MODE_CHANGED = 0x83
+PACKET_ACK_MODE = 0x84
+
+SERIAL_MODE_AUTOMATIC = 0
+SERIAL_MODE_MANUAL = 1
+
+# Payload layout per packet type
+_PAYLOADS = {
+    PACKET_HELLO: struct.Struct("<B"),
+    PACKET_SET_POS: struct.Struct("<B"),
+    PACKET_TEMP: struct.Struct("<h"),           # centi-degrees Celsius
+    PACKET_ALARM_STATE: struct.Struct("<B"),
+    PACKET_MODE: struct.Struct("<B"),
+    PACKET_HELLO_ACK: struct.Struct("<B"),
+    PACKET_POT: struct.Struct("<B"),
+    PACKET_MODE_CHANGED: struct.Struct("<B"),
+    PACKET_ACK_MODE: struct.Struct("<B"),
+}
+
+
+class SerialFrameError(ValueError):
+    """Raised for a frame that is not valid COBS, fails its CRC or has an unknown layout."""
+
+
+def crc8(data):
+    """CRC-8 with polynomial 0x07 and initial value 0 (CRC-8/SMBUS)."""
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def cobs_encode(data):
+    """COBS-encode data, removing every zero byte."""
+    out = bytearray()
+    for block in bytes(data).split(b"\x00"):
+        # Blocks longer than 254 bytes continue under a 0xFF code, without an implied zero
+        while len(block) >= 0xFE:
+            out.append(0xFF)
+            out += block[:0xFE]
+            block = block[0xFE:]
+        out.append(len(block) + 1)
+        out += block
+    return bytes(out)
+
+
+def cobs_decode(frame):
+    """Decode a COBS frame (without delimiters)."""
+    out = bytearray()
+    index = 0
+    while index < len(frame):
+        code = frame[index]
+        if code == 0 or index + code > len(frame):
+            raise SerialFrameError(f"malformed COBS frame {bytes(frame).hex()}")
+        out += frame[index + 1:index + code]
+        index += code
+        if code < 0xFF and index < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_packet(packet_type, value):
+    """
+    Build the delimited frame of a packet.
+
+    Args:
+        packet_type: One of the PACKET_* types
+        value: Payload value of the type
+
+    Returns:
+        bytes: 0x00 <COBS frame> 0x00, ready to write
+    """
+    packet = bytes([packet_type]) + _PAYLOADS[packet_type].pack(value)
+    return FRAME_DELIMITER + cobs_encode(packet + bytes([crc8(packet)])) + FRAME_DELIMITER
+
+
+def decode_packet(frame):
+    """
+    Decode one frame received between two delimiters.
+
+    Args:
+        frame: Frame bytes without delimiters
+
+    Returns:
+        tuple: (packet type, payload value)
+
+    Raises:
+        SerialFrameError: If the frame is malformed, fails its CRC or has an unknown layout
+    """
+    packet = cobs_decode(frame)
+    if len(packet) < 2 or crc8(packet[:-1]) != packet[-1]:
+        raise SerialFrameError(f"CRC mismatch in frame {bytes(frame).hex()}")
+    layout = _PAYLOADS.get(packet[0])
+    if layout is None or len(packet) - 2 != layout.size:
+        raise SerialFrameError(f"unknown packet type 0x{packet[0]:02x} of {len(packet) - 2} payload bytes")
+    return packet[0], layout.unpack_from(packet, 1)[0]
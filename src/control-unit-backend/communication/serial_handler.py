@@ -3,16 +3,25 @@ Serial Communication Handler for Control Unit Backend.
 
 This module provides serial communication functionality for interfacing with
 the Arduino-based window controller. It handles bidirectional communication
-including command sending and status/event receiving.
+including command sending and status/event receiving, as text lines or as
+the binary frames of communication.serial_frames, negotiated at connect time.
 """
 
 import serial
 import threading
 import time
 import logging
+from communication.serial_frames import (
+    FRAME_DELIMITER, SERIAL_FRAME_VERSION, SerialFrameError, decode_packet, encode_packet,
+    PACKET_HELLO, PACKET_SET_POS, PACKET_TEMP, PACKET_ALARM_STATE, PACKET_MODE,
+    PACKET_HELLO_ACK, PACKET_POT, PACKET_MODE_CHANGED, PACKET_ACK_MODE,
+    SERIAL_MODE_AUTOMATIC, SERIAL_MODE_MANUAL
+)
 from config.config import (
     SERIAL_PORT, 
     SERIAL_BAUDRATE, 
+    SERIAL_PROTOCOL,
+    SERIAL_NEGOTIATION_TIMEOUT_S,
     MODE_MANUAL, 
     MODE_AUTOMATIC
 )
@@ -40,6 +49,8 @@ class SerialHandler:
         self.ser = None
         self.is_running = False
         self.thread = None
+        self.protocol = "text"          # "text" or "binary", set by connect()
+        self._rx_frame = bytearray()    # Binary bytes received since the last frame delimiter
 
     def connect(self):
         """
@@ -54,6 +65,7 @@ class SerialHandler:
             
             if self.ser.is_open:
                 logger.info(f"Successfully connected to Arduino on {SERIAL_PORT} at {SERIAL_BAUDRATE} baud.")
+                self.protocol = self._negotiate_protocol(SERIAL_PROTOCOL)
                 self.is_running = True
                 # Start listening thread
                 self.thread = threading.Thread(target=self._listen_for_data, daemon=True)
@@ -68,6 +80,53 @@ class SerialHandler:
             self.ser = None
             return False
 
+    def _negotiate_protocol(self, requested):
+        """
+        Choose the protocol to speak with the Arduino.
+        
+        Sends HELLO and waits up to SERIAL_NEGOTIATION_TIMEOUT_S for
+        HELLO_ACK, which only a controller built with SERIAL_BINARY_PROTOCOL
+        sends. A text controller sees the HELLO frame as a line of garbage:
+        a newline ends that line so the next command is parsed cleanly.
+        
+        Args:
+            requested: SERIAL_PROTOCOL setting ("text", "binary" or "auto")
+            
+        Returns:
+            str: "binary" or "text"
+        """
+        if requested == "text":
+            return "text"
+
+        self.ser.reset_input_buffer()
+        self.ser.write(encode_packet(PACKET_HELLO, SERIAL_FRAME_VERSION))
+        deadline = time.monotonic() + SERIAL_NEGOTIATION_TIMEOUT_S
+        timeout = self.ser.timeout
+        try:
+            while time.monotonic() < deadline:
+                self.ser.timeout = max(0.0, deadline - time.monotonic())
+                chunk = self.ser.read_until(FRAME_DELIMITER)
+                if not chunk.endswith(FRAME_DELIMITER):
+                    break  # Timed out
+                if len(chunk) == 1:
+                    continue  # Leading delimiter of a frame
+                try:
+                    packet_type, version = decode_packet(chunk[:-1])
+                except SerialFrameError:
+                    continue  # Boot log lines of the Arduino
+                if packet_type == PACKET_HELLO_ACK and version == SERIAL_FRAME_VERSION:
+                    logger.info(f"Arduino speaks binary serial protocol version {version}.")
+                    return "binary"
+        finally:
+            self.ser.timeout = timeout
+
+        if requested == "binary":
+            logger.warning("No binary protocol answer from Arduino; sending binary frames as configured.")
+            return "binary"
+        self.ser.write(b"\n")
+        logger.info("Arduino did not answer HELLO: using text serial protocol.")
+        return "text"
+
     def _listen_for_data(self):
         """
         Background thread function for listening to incoming serial data.
@@ -81,6 +140,9 @@ class SerialHandler:
             line = ""
             try:
                 if self.ser.in_waiting > 0:
+                    if self.protocol == "binary":
+                        self._receive_frames(self.ser.read(self.ser.in_waiting))
+                        continue
                     line = self.ser.readline().decode('utf-8').strip()
                     if line:
                         logger.debug(f"Received from Arduino: '{line}'")
@@ -96,6 +158,50 @@ class SerialHandler:
             
         logger.info("Serial listening thread stopped.")
 
+    def _receive_frames(self, data):
+        """
+        Split received binary data into frames and process the complete ones.
+        
+        Args:
+            data: Bytes read from the serial port
+        """
+        self._rx_frame += data
+        *frames, self._rx_frame = self._rx_frame.split(FRAME_DELIMITER)
+        for frame in frames:
+            if frame:
+                self._process_serial_frame(bytes(frame))
+
+    def _process_serial_frame(self, frame):
+        """
+        Process one binary frame received from Arduino.
+        
+        Log lines the Arduino writes between frames arrive as chunks that
+        are not frames; they end with a newline and are only logged.
+        
+        Args:
+            frame: Frame bytes between two delimiters
+        """
+        try:
+            packet_type, value = decode_packet(frame)
+        except SerialFrameError as e:
+            if frame.endswith(b"\n"):
+                logger.debug(f"Arduino log: {frame.decode('utf-8', 'replace').strip()}")
+            else:
+                logger.warning(f"Dropped serial frame from Arduino: {e}")
+            return
+
+        logger.debug(f"Received packet 0x{packet_type:02x} from Arduino: {value}")
+        if packet_type == PACKET_POT:
+            self.control_logic.set_manual_window_opening(value, source="potentiometer")
+        elif packet_type == PACKET_MODE_CHANGED:
+            new_mode = MODE_MANUAL if value == SERIAL_MODE_MANUAL else MODE_AUTOMATIC
+            logger.info(f"Mode change notification from Arduino: {new_mode}")
+            self.control_logic.set_mode(new_mode)
+        elif packet_type in (PACKET_ACK_MODE, PACKET_HELLO_ACK):
+            pass
+        else:
+            logger.debug(f"Unexpected packet 0x{packet_type:02x} from Arduino")
+
     def _process_serial_data(self, data_line):
         """
         Process a single line of data received from Arduino.
@@ -166,24 +272,49 @@ class SerialHandler:
         Returns:
             bool: True if command sent successfully, False otherwise
         """
+        # Ensure command ends with newline as required by Arduino
+        if not command_str.endswith('\n'):
+            command_str += '\n'
+        return self._write(command_str.encode('utf-8'), command_str.strip())
+
+    def _send_frame(self, packet_type, value):
+        """
+        Send a binary packet to the Arduino via serial.
+        
+        Args:
+            packet_type: One of the serial_frames PACKET_* types
+            value: Payload value of the packet
+            
+        Returns:
+            bool: True if the packet was sent successfully, False otherwise
+        """
+        return self._write(encode_packet(packet_type, value), f"packet 0x{packet_type:02x} {value}")
+
+    def _write(self, data, description):
+        """
+        Write encoded command bytes to the serial port.
+        
+        Args:
+            data: Bytes to write
+            description: Command description for the log
+            
+        Returns:
+            bool: True if written successfully, False otherwise
+        """
         if self.ser and self.ser.is_open:
             try:
-                # Ensure command ends with newline as required by Arduino
-                if not command_str.endswith('\n'):
-                    command_str += '\n'
-                    
-                self.ser.write(command_str.encode('utf-8'))
-                logger.debug(f"Sent to Arduino: {command_str.strip()}")
+                self.ser.write(data)
+                logger.debug(f"Sent to Arduino: {description}")
                 return True
                 
             except serial.SerialException as e:
                 logger.error(f"Serial error during send: {e}")
                 return False
             except Exception as e:
-                logger.error(f"Unexpected error sending serial command '{command_str.strip()}': {e}")
+                logger.error(f"Unexpected error sending serial command '{description}': {e}")
                 return False
         else:
-            logger.warning(f"Cannot send command '{command_str.strip()}': Serial port not open or not initialized.")
+            logger.warning(f"Cannot send command '{description}': Serial port not open or not initialized.")
             return False
 
     def send_window_command(self, percentage):
@@ -194,6 +325,9 @@ class SerialHandler:
             percentage: Window opening percentage as float (0.0 to 1.0)
         """
         percent_int = int(round(percentage * 100))  # Convert 0.0-1.0 to 0-100 integer
+        if self.protocol == "binary":
+            self._send_frame(PACKET_SET_POS, max(0, min(100, percent_int)))
+            return
         command = f"SET_POS:{percent_int}"
         self._send_command(command)
 
@@ -204,6 +338,10 @@ class SerialHandler:
         Args:
             mode_string: Mode string ("AUTOMATIC" or "MANUAL")
         """
+        if self.protocol == "binary":
+            manual = mode_string.upper() == MODE_MANUAL.upper()
+            self._send_frame(PACKET_MODE, SERIAL_MODE_MANUAL if manual else SERIAL_MODE_AUTOMATIC)
+            return
         command = f"MODE:{mode_string.upper()}"
         self._send_command(command)
 
@@ -214,13 +352,21 @@ class SerialHandler:
         Args:
             temperature: Temperature value in Celsius (float)
         """
-        if temperature is not None:
-            command = f"TEMP:{temperature:.1f}"
-            self._send_command(command)
+        if temperature is None:
+            return
+        if self.protocol == "binary":
+            # Centi-degrees: the Arduino needs no float parsing
+            self._send_frame(PACKET_TEMP, max(-32768, min(32767, int(round(temperature * 100)))))
+            return
+        command = f"TEMP:{temperature:.1f}"
+        self._send_command(command)
 
     def send_alarm_state(self, is_alarm):
         """Send alarm state to Arduino."""
         alarm_value = 1 if is_alarm else 0
+        if self.protocol == "binary":
+            self._send_frame(PACKET_ALARM_STATE, alarm_value)
+            return
         command = f"ALARM_STATE:{alarm_value}"
         self._send_command(command)
 
@@ -13,19 +13,30 @@ MQTT_BROKER_PORT = 1883                     # MQTT broker port
 MQTT_TOPIC_TEMP_DATA = "assignment3/temperature"        # Topic for receiving temperature data from ESP32
 MQTT_TOPIC_TEMP_CONTROL = "assignment3/frequency"       # Topic for sending control commands (sampling frequency) to ESP32
 MQTT_TOPIC_ESP_STATUS = "assignment3/status"            # Topic for ESP32 status updates
+MQTT_TOPIC_SAMPLING_POLICY = "assignment3/policy"       # Retained topic for the threshold -> sampling interval policy
+MQTT_TOPIC_ESP_METRICS = "assignment3/metrics"          # Topic for ESP32 loop timing histograms
+MQTT_TOPIC_ESP_STATS = "assignment3/stats"              # Topic for ESP32 windowed temperature statistics
+MQTT_TOPIC_BINARY_SUFFIX = "/bin"                       # Suffix of the temperature/status topics carrying binary records
+ESP_LOOP_STALL_WARN_US = 100000             # Loop iterations longer than this (µs) are logged as stalls
 
 # === Serial Communication Configuration ===
 # Serial port settings for communication with the Arduino window controller.
 SERIAL_PORT = "COM4"                        # Serial port identifier
 SERIAL_BAUDRATE = 115200                    # Serial communication baud rate
+SERIAL_PROTOCOL = "auto"                    # "text" lines, "binary" COBS frames with CRC-8, or "auto": binary if the Arduino answers HELLO
+SERIAL_NEGOTIATION_TIMEOUT_S = 0.5          # Wait for the Arduino's HELLO answer before falling back to text commands
 
 # === Control Logic Parameters ===
 # Temperature thresholds that define system state transitions.
 T1_THRESHOLD = 20                           # Temperature threshold (°C) for NORMAL -> HOT transition
 T2_THRESHOLD = 27                           # Temperature threshold (°C) for HOT -> TOO_HOT transition
 
+# Multi-channel ESP32 builds also send the reading of each channel ("ch"); the control temperature is taken from them.
+CONTROL_CHANNEL_AGGREGATION = "max"         # "max" (warmest channel) or "mean" of the channel readings
+
 # Data management and statistics configuration.
 N_LAST_MEASUREMENTS = 10                    # Number of recent temperature measurements to keep for statistics
+N_LAST_STATS_WINDOWS = 12                   # Number of ESP32 statistics windows merged into avg/min/max once summaries arrive
 
 # Alarm system configuration.
 DT_ALARM_DURATION_S = 5                     # Duration (seconds) system must remain in TOO_HOT state before triggering ALARM
@@ -35,6 +46,11 @@ DT_ALARM_DURATION_S = 5                     # Duration (seconds) system must rem
 SAMPLING_FREQUENCY_F1_S = 60                # Low frequency sampling interval (seconds) for NORMAL state
 SAMPLING_FREQUENCY_F2_S = 10                # High frequency sampling interval (seconds) for HOT/TOO_HOT states
 
+# Report-by-exception: the ESP32 skips samples within its deadband but publishes at least once per heartbeat.
+ESP_HEARTBEAT_S = 60                        # Longest ESP32 silence for an unchanged temperature (PUBLISH_HEARTBEAT_MS)
+ESP_HEARTBEAT_MARGIN_S = 10                 # Network and scheduling slack before a missing heartbeat marks the temperature stale
+HELD_TEMPERATURE_CHECK_S = 1                # Interval (seconds) at which the held temperature is re-evaluated between publishes
+
 # === Window Control Parameters ===
 # Window opening percentages as floating point values (0.0 to 1.0).
 WINDOW_CLOSED_PERCENTAGE = 0.0              # Fully closed window position (0%)
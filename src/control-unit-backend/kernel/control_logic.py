@@ -13,11 +13,14 @@ The control logic implements a finite state machine with the following states:
 """
 
 import time
+import threading
 from collections import deque
 import logging
+from kernel.sampling_monitor import SamplingMonitor
 from config.config import (
-    T1_THRESHOLD, T2_THRESHOLD, N_LAST_MEASUREMENTS, DT_ALARM_DURATION_S,
+    T1_THRESHOLD, T2_THRESHOLD, CONTROL_CHANNEL_AGGREGATION, N_LAST_MEASUREMENTS, N_LAST_STATS_WINDOWS, DT_ALARM_DURATION_S,
     SAMPLING_FREQUENCY_F1_S, SAMPLING_FREQUENCY_F2_S,
+    ESP_HEARTBEAT_S, ESP_HEARTBEAT_MARGIN_S, HELD_TEMPERATURE_CHECK_S,
     WINDOW_CLOSED_PERCENTAGE, WINDOW_FULLY_OPEN_PERCENTAGE,
     MODE_AUTOMATIC, MODE_MANUAL,
     STATE_NORMAL, STATE_HOT, STATE_TOO_HOT, STATE_ALARM
@@ -52,13 +55,26 @@ class ControlLogic:
         self.system_state = STATE_NORMAL
         self.esp_status = "UNKNOWN"
         self.esp_last_status_data = {}
+        self.esp_loop_metrics = None
 
         # Temperature tracking and statistics
         self.current_temperature = None
+        self.current_temperature_time = None  # Backend time of the last live reading
+        self.temperature_stale = False
+        self.current_channel_temperatures = None  # Per-channel readings of the last live sample, multi-channel ESP32 only
+        self.channel_aggregation = CONTROL_CHANNEL_AGGREGATION
+        if self.channel_aggregation not in ("max", "mean"):
+            logger.warning(f"Unknown CONTROL_CHANNEL_AGGREGATION '{self.channel_aggregation}', using 'max'")
+            self.channel_aggregation = "max"
         self.last_n_temperatures = deque(maxlen=N_LAST_MEASUREMENTS)
         self.avg_temp = None
         self.min_temp = None
         self.max_temp = None
+        self.stddev_temp = None
+        self.stats_sample_count = 0
+        # (count, mean, variance, min, max) of the ESP32 statistics windows, newest last
+        self.stats_windows = deque(maxlen=N_LAST_STATS_WINDOWS)
+        self.sampling_monitor = SamplingMonitor()
 
         # Window control
         self.window_opening_percentage = WINDOW_CLOSED_PERCENTAGE  # 0.0 to 1.0
@@ -66,6 +82,15 @@ class ControlLogic:
         # Alarm system
         self.too_hot_start_time = None
 
+        # Sampling interval forced by an operator, None while the ESP32 policy applies
+        self.sampling_override_s = None
+
+        # The MQTT, serial, Flask and held-temperature monitor threads all change the control state;
+        # reentrant so that a locked method may call another one
+        self._state_lock = threading.RLock()
+        self._heartbeat_stop = threading.Event()
+        self._heartbeat_thread = None
+
         logger.info(f"ControlLogic initialized. Mode: {self.current_mode}, State: {self.system_state}")
 
     def update_esp_status(self, status, full_data_payload=None):
@@ -82,20 +107,27 @@ class ControlLogic:
             
         logger.debug(f"ESP status updated: {status}")
 
+    def update_loop_metrics(self, window_ms, slots):
+        """
+        Store the latest ESP32 loop timing histograms for the dashboard.
+        
+        Args:
+            window_ms: Time covered by the histograms in milliseconds
+            slots: Latency figures in microseconds per FSM state and for the MQTT loop
+        """
+        self.esp_loop_metrics = {"window_ms": window_ms, "slots": slots}
+
     def _initialize_state(self):
         """
         Initialize system state and send initial commands to external devices.
         
         Called during system startup when communication handlers are ready.
-        Sets initial sampling frequency, system mode, and window position.
+        Sets system mode and window position. The sampling policy and the
+        (cleared) sampling override are published retained by the MQTT
+        handler on connect, replacing any override a previous run left.
         """
         logger.info("Initializing system state...")
         
-        # Set initial MQTT sampling frequency if connected
-        if self.mqtt_handler and self.mqtt_handler.connected:
-            self.mqtt_handler.publish_sampling_frequency(SAMPLING_FREQUENCY_F1_S)
-            logger.info(f"Initial sampling frequency set: {SAMPLING_FREQUENCY_F1_S}s")
-        
         # Initialize Arduino with current system mode and window position
         if self.serial_handler:
             self.serial_handler.send_system_mode(self.current_mode)
@@ -108,31 +140,162 @@ class ControlLogic:
             self.serial_handler.send_window_command(self.window_opening_percentage)
             logger.info(f"Arduino initialized: mode={self.current_mode}, window={self.window_opening_percentage*100:.0f}%")
 
-    def process_new_temperature(self, temp_value):
+    def _aggregate_channels(self, temp_value, channels):
+        """
+        Control temperature of a sample: the configured aggregate of its channel readings.
+        
+        Args:
+            temp_value: Control temperature computed by the ESP32, used without channel readings
+            channels: Per-channel readings in Celsius, or None for a single-sensor device
+        
+        Returns:
+            float: Temperature in Celsius the control logic acts on
+        """
+        if not channels:
+            return float(temp_value)
+        readings = [float(reading) for reading in channels]
+        if self.channel_aggregation == "mean":
+            return sum(readings) / len(readings)
+        return max(readings)
+
+    def process_new_temperature(self, temp_value, channels=None):
         """
         Process a new temperature reading from the ESP32 sensor.
         
         Args:
             temp_value: Temperature value in Celsius (float)
+            channels: Optional per-channel readings in Celsius of a multi-channel ESP32,
+                      aggregated according to CONTROL_CHANNEL_AGGREGATION
+        """
+        with self._state_lock:
+            self.current_temperature = self._aggregate_channels(temp_value, channels)
+            self.current_channel_temperatures = [float(reading) for reading in channels] if channels else None
+            self.current_temperature_time = time.time()
+            if self.temperature_stale:
+                logger.info("ESP32 temperature heartbeat restored")
+                self.temperature_stale = False
+            self.last_n_temperatures.append(self.current_temperature)
+            self._update_temperature_statistics()
+
+            logger.info(f"New temperature: {self.current_temperature}°C (Mode: {self.current_mode})")
+
+            if self.current_mode == MODE_AUTOMATIC:
+                self._evaluate_automatic_mode()
+            else:
+                # In manual mode, only send temperature to Arduino for LCD display
+                if self.serial_handler and self.current_temperature is not None:
+                    self.serial_handler.send_temperature_to_arduino(self.current_temperature)
+                # Keep evaluating system state for sampling frequency
+                self._evaluate_system_state_for_sampling()
+
+    def check_held_temperature(self):
         """
-        self.current_temperature = float(temp_value)
-        self.last_n_temperatures.append(self.current_temperature)
-        self._update_temperature_statistics()
+        Re-evaluate the last live reading while the ESP32 stays silent.
         
-        logger.info(f"New temperature: {self.current_temperature}°C (Mode: {self.current_mode})")
+        The ESP32 only publishes when the temperature leaves its deadband or
+        its heartbeat interval expires, so silence means "unchanged". Holding
+        the last reading keeps the time-based TOO_HOT -> ALARM transition on
+        schedule. Once the heartbeat is overdue the reading is stale and is
+        no longer acted on.
+        """
+        with self._state_lock:
+            if self.current_temperature_time is None:
+                return
+
+            # The heartbeat goes out with the first sample after it expires
+            interval_s = self.sampling_override_s or SAMPLING_FREQUENCY_F1_S
+            stale_after_s = ESP_HEARTBEAT_S + interval_s + ESP_HEARTBEAT_MARGIN_S
+            silence_s = time.time() - self.current_temperature_time
+            if silence_s > stale_after_s:
+                if not self.temperature_stale:
+                    logger.warning(f"No ESP32 temperature for {silence_s:.0f}s (heartbeat {ESP_HEARTBEAT_S}s): reading is stale")
+                    self.temperature_stale = True
+                return
+
+            if self.system_state == STATE_TOO_HOT:
+                if self.current_mode == MODE_AUTOMATIC:
+                    self._evaluate_automatic_mode()
+                else:
+                    self._evaluate_system_state_for_sampling()
+
+    def start_heartbeat_monitor(self):
+        """Start re-evaluating the held temperature every HELD_TEMPERATURE_CHECK_S in a daemon thread."""
+        if self._heartbeat_thread is not None:
+            return
+        self._heartbeat_stop.clear()
+        self._heartbeat_thread = threading.Thread(target=self._heartbeat_loop, daemon=True)
+        self._heartbeat_thread.start()
+        logger.info("Held temperature monitor started.")
+
+    def stop_heartbeat_monitor(self):
+        """Stop the held temperature monitor thread."""
+        if self._heartbeat_thread is None:
+            return
+        self._heartbeat_stop.set()
+        self._heartbeat_thread.join(timeout=2)
+        self._heartbeat_thread = None
+
+    def _heartbeat_loop(self):
+        """Body of the held temperature monitor thread."""
+        while not self._heartbeat_stop.wait(HELD_TEMPERATURE_CHECK_S):
+            try:
+                self.check_held_temperature()
+            except Exception as e:
+                logger.error(f"Error checking held temperature: {e}", exc_info=True)
+
+    def process_backlog_temperature(self, temp_value, channels=None):
+        """
+        Record a temperature reading that was queued by the ESP32 during a network outage.
+        
+        The reading fills the history and statistics but does not drive state
+        transitions or window control, which only act on live readings.
+        
+        Args:
+            temp_value: Temperature value in Celsius (float)
+            channels: Optional per-channel readings in Celsius of a multi-channel ESP32
+        """
+        with self._state_lock:
+            temp_value = self._aggregate_channels(temp_value, channels)
+            self.last_n_temperatures.append(temp_value)
+            self._update_temperature_statistics()
+            logger.debug(f"Backlog temperature recorded: {temp_value}°C")
 
-        if self.current_mode == MODE_AUTOMATIC:
-            self._evaluate_automatic_mode()
-        else:
-            # In manual mode, only send temperature to Arduino for LCD display
-            if self.serial_handler and self.current_temperature is not None:
-                self.serial_handler.send_temperature_to_arduino(self.current_temperature)
-            # Keep evaluating system state for sampling frequency
-            self._evaluate_system_state_for_sampling()
+    def process_temperature_summary(self, count, mean, variance, min_value, max_value):
+        """
+        Record the statistics of one ESP32 window of samples.
+        
+        From the first summary on, avg/min/max are taken from the last
+        N_LAST_STATS_WINDOWS summaries instead of the received readings,
+        which miss the samples the ESP32 held back in its deadband.
+        
+        Args:
+            count: Number of samples in the window
+            mean: Mean temperature in Celsius
+            variance: Sample variance in Celsius squared
+            min_value: Lowest temperature in Celsius
+            max_value: Highest temperature in Celsius
+        """
+        with self._state_lock:
+            self.stats_windows.append((int(count), float(mean), float(variance), float(min_value), float(max_value)))
+            self._update_temperature_statistics()
+
+    def record_sample_timing(self, timestamp_ms, sequence, backlog=False, suppressed=0):
+        """
+        Record the device timestamp and sequence number of a received sample.
+        
+        Args:
+            timestamp_ms: Device time since boot (ms) at which the sample was taken
+            sequence: Device sampling period number
+            backlog: True if the sample was queued during a network outage
+            suppressed: Samples the ESP32 held back in its deadband since the previous one
+        """
+        self.sampling_monitor.record_sample(timestamp_ms, sequence, backlog, suppressed)
 
     def _update_temperature_statistics(self):
-        """ Update temperature statistics (average, min, max) from recent readings."""
-        if self.last_n_temperatures:
+        """ Update temperature statistics (average, min, max) from the ESP32 summaries or recent readings."""
+        if self.stats_windows:
+            self._merge_stats_windows()
+        elif self.last_n_temperatures:
             self.avg_temp = sum(self.last_n_temperatures) / len(self.last_n_temperatures)
             self.min_temp = min(self.last_n_temperatures)
             self.max_temp = max(self.last_n_temperatures)
@@ -142,6 +305,24 @@ class ControlLogic:
             self.min_temp = None
             self.max_temp = None
 
+    def _merge_stats_windows(self):
+        """Combine the kept ESP32 summaries into one mean and variance (Chan et al. pairwise update)."""
+        total, mean, m2 = 0, 0.0, 0.0
+        for count, window_mean, variance, _, _ in self.stats_windows:
+            delta = window_mean - mean
+            combined = total + count
+            mean += delta * count / combined
+            m2 += variance * (count - 1) + delta * delta * total * count / combined
+            total = combined
+
+        self.stats_sample_count = total
+        self.avg_temp = mean
+        self.stddev_temp = (m2 / (total - 1)) ** 0.5 if total > 1 else 0.0
+        self.min_temp = min(window[3] for window in self.stats_windows)
+        self.max_temp = max(window[4] for window in self.stats_windows)
+        logger.debug(f"Temperature stats from {len(self.stats_windows)} ESP32 windows ({total} samples): "
+                     f"avg={self.avg_temp:.1f}°C, min={self.min_temp:.1f}°C, max={self.max_temp:.1f}°C")
+
     def _evaluate_automatic_mode(self):
         """Evaluate system state and control actions in automatic mode."""
         if self.system_state == STATE_ALARM:
@@ -166,7 +347,12 @@ class ControlLogic:
                 self.serial_handler.send_window_command(self.window_opening_percentage)
 
     def _evaluate_system_state_for_sampling(self):
-        """Evaluate system state and manage sampling frequency (used in both modes)."""
+        """
+        Evaluate system state from the current temperature (used in both modes).
+        
+        The sampling frequency follows the same thresholds but is switched
+        on the ESP32 itself, from the policy returned by get_sampling_policy().
+        """
         if self.current_temperature is None:
             logger.warning("Cannot evaluate system state: current_temperature is None")
             return
@@ -178,20 +364,16 @@ class ControlLogic:
 
         # Store previous state for change detection
         previous_state = self.system_state
-        new_sampling_freq = None
 
         # State machine logic based on temperature thresholds
         if self.current_temperature < T1_THRESHOLD:
             self._transition_to_normal_state()
-            new_sampling_freq = SAMPLING_FREQUENCY_F1_S
             
         elif T1_THRESHOLD <= self.current_temperature <= T2_THRESHOLD:
             self._transition_to_hot_state()
-            new_sampling_freq = SAMPLING_FREQUENCY_F2_S
             
         else:  # Temperature > T2_THRESHOLD
             self._transition_to_too_hot_state()
-            new_sampling_freq = SAMPLING_FREQUENCY_F2_S
 
         if previous_state != self.system_state:
             logger.info(f"System state changed: {previous_state} -> {self.system_state}")
@@ -200,10 +382,6 @@ class ControlLogic:
             if self.serial_handler:
                 self.serial_handler.send_alarm_state(self.system_state == STATE_ALARM)
 
-        # Update MQTT sampling frequency if changed
-        if self.mqtt_handler and new_sampling_freq:
-            self.mqtt_handler.publish_sampling_frequency(new_sampling_freq)
-
     def _transition_to_normal_state(self):
         """Handle transition to NORMAL state."""
         self.system_state = STATE_NORMAL
@@ -260,31 +438,32 @@ class ControlLogic:
         Returns:
             bool: True if mode change successful, False otherwise
         """
-        if mode not in [MODE_AUTOMATIC, MODE_MANUAL]:
-            logger.error(f"Invalid mode requested: {mode}")
-            return False
+        with self._state_lock:
+            if mode not in [MODE_AUTOMATIC, MODE_MANUAL]:
+                logger.error(f"Invalid mode requested: {mode}")
+                return False
         
-        # Block mode changes if system is in ALARM state
-        if self.system_state == STATE_ALARM:
-            logger.warning("Cannot change mode: system in ALARM state")
-            return False
-
-        if self.current_mode != mode:
-            previous_mode = self.current_mode
-            self.current_mode = mode
-            logger.info(f"Mode changed: {previous_mode} -> {self.current_mode}")
+            # Block mode changes if system is in ALARM state
+            if self.system_state == STATE_ALARM:
+                logger.warning("Cannot change mode: system in ALARM state")
+                return False
+
+            if self.current_mode != mode:
+                previous_mode = self.current_mode
+                self.current_mode = mode
+                logger.info(f"Mode changed: {previous_mode} -> {self.current_mode}")
             
-            # Handle mode-specific initialization
-            if self.current_mode == MODE_AUTOMATIC:
-                self._on_enter_automatic_mode()
-            else:  # MODE_MANUAL
-                self._on_enter_manual_mode()
+                # Handle mode-specific initialization
+                if self.current_mode == MODE_AUTOMATIC:
+                    self._on_enter_automatic_mode()
+                else:  # MODE_MANUAL
+                    self._on_enter_manual_mode()
                 
-            # Update Arduino with new mode
-            if self.serial_handler:
-                self.serial_handler.send_system_mode(self.current_mode)
+                # Update Arduino with new mode
+                if self.serial_handler:
+                    self.serial_handler.send_system_mode(self.current_mode)
                 
-        return True
+            return True
 
     def _on_enter_automatic_mode(self):
         """Actions to perform when entering AUTOMATIC mode."""
@@ -292,12 +471,6 @@ class ControlLogic:
         
         # Re-evaluate system state and apply automatic control
         self._evaluate_automatic_mode()
-        
-        # Set appropriate sampling frequency for ESP32
-        if self.mqtt_handler:
-            # Use high frequency if system is not in normal state
-            freq = SAMPLING_FREQUENCY_F2_S if self.system_state != STATE_NORMAL else SAMPLING_FREQUENCY_F1_S
-            self.mqtt_handler.publish_sampling_frequency(freq)
 
     def _on_enter_manual_mode(self):
         """Actions to perform when entering MANUAL mode."""
@@ -318,37 +491,38 @@ class ControlLogic:
         Returns:
             bool: True if command successful, False otherwise
         """
-        if self.current_mode != MODE_MANUAL:
-            logger.warning("Cannot set manual window opening: system not in MANUAL mode")
-            return False
-
-        # Block manual control if system is in ALARM state
-        if self.system_state == STATE_ALARM:
-            logger.warning("Cannot set manual window opening: system in ALARM state")
-            return False
-
-        try:
-            # Convert string percentage to float (0.0-1.0)
-            percentage = max(0.0, min(100.0, float(percentage_str))) / 100.0
+        with self._state_lock:
+            if self.current_mode != MODE_MANUAL:
+                logger.warning("Cannot set manual window opening: system not in MANUAL mode")
+                return False
+
+            # Block manual control if system is in ALARM state
+            if self.system_state == STATE_ALARM:
+                logger.warning("Cannot set manual window opening: system in ALARM state")
+                return False
+
+            try:
+                # Convert string percentage to float (0.0-1.0)
+                percentage = max(0.0, min(100.0, float(percentage_str))) / 100.0
             
-            # Only update if significantly different
-            if abs(self.window_opening_percentage - percentage) > 0.001:
-                self.window_opening_percentage = percentage
-                logger.info(f"Manual window opening set to {percentage*100:.0f}% (source: {source})")
+                # Only update if significantly different
+                if abs(self.window_opening_percentage - percentage) > 0.001:
+                    self.window_opening_percentage = percentage
+                    logger.info(f"Manual window opening set to {percentage*100:.0f}% (source: {source})")
                 
-                # Send SET_POS command only if request comes from Dashboard
-                if source == "dashboard" and self.serial_handler:
-                    self.serial_handler.send_window_command(self.window_opening_percentage)
+                    # Send SET_POS command only if request comes from Dashboard
+                    if source == "dashboard" and self.serial_handler:
+                        self.serial_handler.send_window_command(self.window_opening_percentage)
                 
-                # Send temperature update for LCD display
-                if self.serial_handler and self.current_temperature is not None:
-                    self.serial_handler.send_temperature_to_arduino(self.current_temperature)
+                    # Send temperature update for LCD display
+                    if self.serial_handler and self.current_temperature is not None:
+                        self.serial_handler.send_temperature_to_arduino(self.current_temperature)
                     
-            return True
+                return True
             
-        except ValueError:
-            logger.error(f"Invalid percentage value for manual window opening: {percentage_str}")
-            return False
+            except ValueError:
+                logger.error(f"Invalid percentage value for manual window opening: {percentage_str}")
+                return False
 
     def handle_alarm_reset(self):
         """
@@ -357,41 +531,70 @@ class ControlLogic:
         Returns:
             bool: True if alarm reset successful, False if system not in alarm
         """
-        if self.system_state != STATE_ALARM:
-            logger.info("Alarm reset requested, but system not in ALARM state")
-            return False
+        with self._state_lock:
+            if self.system_state != STATE_ALARM:
+                logger.info("Alarm reset requested, but system not in ALARM state")
+                return False
 
-        logger.info("ALARM state reset by operator")
+            logger.info("ALARM state reset by operator")
         
-        # Reset alarm timer and force return to NORMAL state
-        self.system_state = STATE_NORMAL
-        self.too_hot_start_time = None
+            # Reset alarm timer and force return to NORMAL state
+            self.system_state = STATE_NORMAL
+            self.too_hot_start_time = None
 
-        # Send alarm state reset to Arduino
-        if self.serial_handler:
-            self.serial_handler.send_alarm_state(False)
+            # Send alarm state reset to Arduino
+            if self.serial_handler:
+                self.serial_handler.send_alarm_state(False)
         
-        # In AUTOMATIC mode, set window to closed position (NORMAL state behavior)
-        if self.current_mode == MODE_AUTOMATIC:
-            self.window_opening_percentage = WINDOW_CLOSED_PERCENTAGE
+            # In AUTOMATIC mode, set window to closed position (NORMAL state behavior)
+            if self.current_mode == MODE_AUTOMATIC:
+                self.window_opening_percentage = WINDOW_CLOSED_PERCENTAGE
             
-        # Update Arduino with current system state
-        if self.serial_handler:
-            self.serial_handler.send_system_mode(self.current_mode)
+            # Update Arduino with current system state
+            if self.serial_handler:
+                self.serial_handler.send_system_mode(self.current_mode)
             
-            # Send window command if in automatic mode
-            if self.current_mode == MODE_AUTOMATIC:
-                self.serial_handler.send_window_command(self.window_opening_percentage)
+                # Send window command if in automatic mode
+                if self.current_mode == MODE_AUTOMATIC:
+                    self.serial_handler.send_window_command(self.window_opening_percentage)
             
-            # Send temperature if in manual mode
-            if self.current_mode == MODE_MANUAL and self.current_temperature is not None:
-                self.serial_handler.send_temperature_to_arduino(self.current_temperature)
-                
-        # Set low frequency sampling for NORMAL state
-        if self.mqtt_handler:
-            self.mqtt_handler.publish_sampling_frequency(SAMPLING_FREQUENCY_F1_S)
+                # Send temperature if in manual mode
+                if self.current_mode == MODE_MANUAL and self.current_temperature is not None:
+                    self.serial_handler.send_temperature_to_arduino(self.current_temperature)
                 
-        return True
+            return True
+
+    def get_sampling_policy(self):
+        """
+        Build the sampling policy applied locally by the ESP32.
+        
+        Mirrors the state thresholds: NORMAL samples at F1, HOT and TOO_HOT at F2.
+        
+        Returns:
+            tuple: (thresholds in °C, sampling interval in seconds per band)
+        """
+        return [T1_THRESHOLD, T2_THRESHOLD], [SAMPLING_FREQUENCY_F1_S, SAMPLING_FREQUENCY_F2_S, SAMPLING_FREQUENCY_F2_S]
+
+    def set_sampling_override(self, frequency_seconds):
+        """
+        Force the ESP32 sampling interval, or hand control back to its policy.
+        
+        Args:
+            frequency_seconds: Sampling interval in seconds, or None/0 to clear the override
+            
+        Returns:
+            bool: True if the command was published
+        """
+        with self._state_lock:
+            if not self.mqtt_handler:
+                return False
+
+            if not self.mqtt_handler.publish_sampling_frequency(frequency_seconds or 0):
+                return False
+
+            self.sampling_override_s = frequency_seconds or None
+            logger.info(f"Sampling override: {self.sampling_override_s or 'cleared'}")
+            return True
 
     def get_dashboard_data(self):
         """
@@ -400,15 +603,24 @@ class ControlLogic:
         Returns:
             dict: Complete system status including temperatures, mode, state, and window position
         """
-        return {
-            "esp_status": self.esp_status,
-            "current_temperature": self.current_temperature,
-            "last_n_temperatures": list(self.last_n_temperatures),
-            "average_temperature": round(self.avg_temp, 2) if self.avg_temp is not None else None,
-            "min_temperature": round(self.min_temp, 2) if self.min_temp is not None else None,
-            "max_temperature": round(self.max_temp, 2) if self.max_temp is not None else None,
-            "system_mode": self.current_mode,
-            "system_state": self.system_state,
-            "window_opening_percentage": round(self.window_opening_percentage * 100, 1),  # Convert to 0-100 range
-            "alarm_active": self.system_state == STATE_ALARM
-        }
\ No newline at end of file
+        with self._state_lock:
+            return {
+                "esp_status": self.esp_status,
+                "current_temperature": self.current_temperature,
+                "channel_temperatures": self.current_channel_temperatures,
+                "temperature_age_s": round(time.time() - self.current_temperature_time, 1) if self.current_temperature_time else None,
+                "temperature_stale": self.temperature_stale,
+                "last_n_temperatures": list(self.last_n_temperatures),
+                "average_temperature": round(self.avg_temp, 2) if self.avg_temp is not None else None,
+                "min_temperature": round(self.min_temp, 2) if self.min_temp is not None else None,
+                "max_temperature": round(self.max_temp, 2) if self.max_temp is not None else None,
+                "stddev_temperature": round(self.stddev_temp, 3) if self.stddev_temp is not None else None,
+                "statistics_sample_count": self.stats_sample_count if self.stats_windows else len(self.last_n_temperatures),
+                "system_mode": self.current_mode,
+                "system_state": self.system_state,
+                "window_opening_percentage": round(self.window_opening_percentage * 100, 1),  # Convert to 0-100 range
+                "alarm_active": self.system_state == STATE_ALARM,
+                "sampling": self.sampling_monitor.get_stats(),
+                "sampling_override_s": self.sampling_override_s,
+                "esp_loop_metrics": self.esp_loop_metrics
+            }
\ No newline at end of file
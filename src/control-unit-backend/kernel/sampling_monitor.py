@@ -0,0 +1,101 @@
+"""
+Sampling Quality Monitor for Control Unit Backend.
+
+This module tracks the timestamps and sequence numbers attached to every
+temperature sample by the ESP32, so the backend can measure the real
+sampling jitter and detect samples lost between the sensor and the broker.
+"""
+
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+class SamplingMonitor:
+    """
+    Measures sampling jitter and dropped samples from device timestamps.
+
+    Jitter is measured period-to-period: for consecutive live samples the
+    device-side interval per sequence step is compared with the previous
+    interval, so the figure does not depend on which sampling frequency the
+    ESP32 is currently using. A sequence gap counts as missing samples until
+    the same samples arrive as store-and-forward backlog. Samples the ESP32
+    held back inside its publish deadband are reported with the next sample
+    and are not counted as missing.
+    """
+
+    def __init__(self):
+        """Initialize an empty monitor."""
+        self.reset()
+
+    def reset(self):
+        """Forget all history, e.g. after the ESP32 rebooted."""
+        self.last_sequence = None
+        self.last_timestamp_ms = None
+        self.last_interval_ms = None
+        self.samples_received = 0
+        self.missing_samples = 0
+        self.suppressed_samples = 0
+        self.jitter_count = 0
+        self.jitter_sum_ms = 0
+        self.max_jitter_ms = 0
+
+    def record_sample(self, timestamp_ms, sequence, backlog=False, suppressed=0):
+        """
+        Record the timing of one received sample.
+
+        Args:
+            timestamp_ms: Device time since boot (ms) at which the sample was taken
+            sequence: Device sampling period number
+            backlog: True if the sample was queued during a network outage
+            suppressed: Samples the ESP32 did not publish since the previous one (deadband)
+        """
+        if timestamp_ms is None or sequence is None:
+            return
+
+        if backlog:
+            # Late delivery of a sample previously counted as missing
+            if self.missing_samples > 0:
+                self.missing_samples -= 1
+            return
+
+        if self.last_sequence is not None and sequence <= self.last_sequence:
+            logger.info(f"Sample sequence restarted ({self.last_sequence} -> {sequence}), ESP32 probably rebooted")
+            self.reset()
+
+        self.samples_received += 1
+        self.suppressed_samples += suppressed
+
+        if self.last_sequence is not None:
+            steps = sequence - self.last_sequence
+            missing = steps - 1 - suppressed
+            if missing > 0:
+                self.missing_samples += missing
+                logger.warning(f"Sequence gap: {missing} samples missing before #{sequence}")
+
+            interval_ms = (timestamp_ms - self.last_timestamp_ms) / steps
+            if self.last_interval_ms is not None:
+                jitter_ms = abs(interval_ms - self.last_interval_ms)
+                self.jitter_count += 1
+                self.jitter_sum_ms += jitter_ms
+                self.max_jitter_ms = max(self.max_jitter_ms, jitter_ms)
+            self.last_interval_ms = interval_ms
+
+        self.last_sequence = sequence
+        self.last_timestamp_ms = timestamp_ms
+
+    def get_stats(self):
+        """
+        Summarize the sampling quality for the dashboard.
+
+        Returns:
+            dict: Received, missing and suppressed sample counts and jitter figures in milliseconds
+        """
+        return {
+            "samples_received": self.samples_received,
+            "missing_samples": self.missing_samples,
+            "suppressed_samples": self.suppressed_samples,
+            "last_interval_ms": round(self.last_interval_ms, 1) if self.last_interval_ms is not None else None,
+            "mean_jitter_ms": round(self.jitter_sum_ms / self.jitter_count, 2) if self.jitter_count else None,
+            "max_jitter_ms": round(self.max_jitter_ms, 2) if self.jitter_count else None,
+        }
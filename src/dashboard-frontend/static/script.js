@@ -40,6 +40,8 @@ class TemperatureDashboard {
     cacheElements() {
         // Status display elements
         this.elements.currentTemp = document.getElementById('current-temp');
+        this.elements.channelTempsRow = document.getElementById('channel-temps-row');
+        this.elements.channelTemps = document.getElementById('channel-temps');
         this.elements.avgTemp = document.getElementById('avg-temp');
         this.elements.minTemp = document.getElementById('min-temp');
         this.elements.maxTemp = document.getElementById('max-temp');
@@ -262,6 +264,15 @@ class TemperatureDashboard {
         this.elements.currentTemp.textContent = 
             data.current_temperature !== null ? data.current_temperature.toFixed(1) : '-';
         
+        // Per-channel readings of a multi-channel ESP32; the current temperature aggregates them
+        if (Array.isArray(data.channel_temperatures) && data.channel_temperatures.length > 1) {
+            this.elements.channelTemps.textContent =
+                data.channel_temperatures.map(reading => reading.toFixed(1)).join(' / ');
+            this.elements.channelTempsRow.classList.remove('hidden');
+        } else {
+            this.elements.channelTempsRow.classList.add('hidden');
+        }
+        
         this.elements.avgTemp.textContent = 
             data.average_temperature !== null ? data.average_temperature.toFixed(1) : '-';
         
@@ -0,0 +1,173 @@
+/**
+ * @file filter_bench.cpp
+ * @brief Host-side benchmark of the SampleFilter stage.
+ *
+ * Measures the CPU cost per temperature sample and the noise reduction of
+ * several filter configurations, and counts how often the filtered value
+ * crosses the backend's NORMAL/HOT threshold (each crossing costs a
+ * frequency publish and a servo move).
+ *
+ * Build and run from the temperature-monitoring-subsystem directory:
+ *   g++ -O2 -std=c++17 -Isrc benchmarks/filter_bench.cpp src/devices/impl/SampleFilter.cpp -o filter_bench
+ *   ./filter_bench [trace.csv]
+ *
+ * A trace is one ADC reading in millivolts per line, in acquisition order
+ * (e.g. logged with analogReadMilliVolts()). Without a trace, a synthetic
+ * one is generated: a slow ramp across the threshold with Gaussian ADC
+ * noise and occasional spikes, whose noise-free value is known.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "devices/api/SampleFilter.h"
+
+namespace {
+
+const size_t OVERSAMPLES = 16;              ///< Readings per burst, as TEMP_FILTER_OVERSAMPLES.
+const double THRESHOLD_MV = 700.0;          ///< T1_THRESHOLD (20 °C) as TMP36 output voltage.
+const int TIMING_REPEATS = 200;             ///< Passes over the trace when timing.
+
+volatile int32_t sink; ///< Keeps the optimizer from discarding the timed work.
+
+struct FilterConfig {
+    const char* name;
+    size_t oversamples;
+    size_t window;
+    uint8_t emaShift;
+};
+
+const FilterConfig CONFIGS[] = {
+    {"single read (baseline)", 1, 1, 0},
+    {"average of 16", OVERSAMPLES, OVERSAMPLES, 0},
+    {"median of 16", OVERSAMPLES, 1, 0},
+    {"trimmed mean 8 of 16", OVERSAMPLES, 8, 0},
+    {"trimmed mean 8 of 16 + EMA 1/4", OVERSAMPLES, 8, 2},
+    {"trimmed mean 8 of 16 + EMA 1/8", OVERSAMPLES, 8, 3},
+};
+
+struct Trace {
+    std::vector<int32_t> readings;  ///< Raw readings in millivolts.
+    std::vector<double> truth;      ///< Noise-free value per reading, empty for recorded traces.
+};
+
+Trace syntheticTrace(size_t bursts) {
+    Trace trace;
+    std::mt19937 rng(42);
+    std::normal_distribution<double> noise(0.0, 6.0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    for (size_t b = 0; b < bursts; b++) {
+        // Ramp from 19.5 °C to 20.5 °C and back, across T1_THRESHOLD
+        double phase = (double)b / bursts;
+        double value = 695.0 + 10.0 * (phase < 0.5 ? 2.0 * phase : 2.0 - 2.0 * phase);
+        for (size_t i = 0; i < OVERSAMPLES; i++) {
+            double reading = value + noise(rng);
+            if (uniform(rng) < 0.01) {
+                reading += (uniform(rng) < 0.5 ? -1.0 : 1.0) * 120.0; // WiFi TX burst spike
+            }
+            trace.readings.push_back((int32_t)std::lround(reading));
+            trace.truth.push_back(value);
+        }
+    }
+    return trace;
+}
+
+bool loadTrace(const char* path, Trace& trace) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    double value;
+    while (file >> value) {
+        trace.readings.push_back((int32_t)std::lround(value));
+    }
+    return !trace.readings.empty();
+}
+
+/** @brief Runs one configuration over the trace, one output per burst of OVERSAMPLES readings. */
+std::vector<int32_t> runFilter(const FilterConfig& config, const Trace& trace) {
+    SampleFilter filter(config.window, config.emaShift);
+    std::vector<int32_t> outputs;
+    int32_t burst[OVERSAMPLES];
+
+    for (size_t start = 0; start + OVERSAMPLES <= trace.readings.size(); start += OVERSAMPLES) {
+        for (size_t i = 0; i < config.oversamples; i++) {
+            burst[i] = trace.readings[start + i];
+        }
+        outputs.push_back(filter.smooth(filter.reduce(burst, config.oversamples)));
+    }
+    return outputs;
+}
+
+double nanosecondsPerSample(const FilterConfig& config, const Trace& trace) {
+    size_t samples = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < TIMING_REPEATS; r++) {
+        std::vector<int32_t> outputs = runFilter(config, trace);
+        samples += outputs.size();
+        sink = outputs.empty() ? 0 : outputs.back();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / samples;
+}
+
+/** @brief RMS error against the noise-free value, or RMS of successive differences / sqrt(2) without one. */
+double noiseMillivolts(const std::vector<int32_t>& outputs, const Trace& trace) {
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < outputs.size(); i++) {
+        double error;
+        if (!trace.truth.empty()) {
+            error = outputs[i] - trace.truth[i * OVERSAMPLES];
+        } else if (i > 0) {
+            error = (outputs[i] - outputs[i - 1]) / std::sqrt(2.0);
+        } else {
+            continue;
+        }
+        sum += error * error;
+        count++;
+    }
+    return count ? std::sqrt(sum / count) : 0.0;
+}
+
+int thresholdCrossings(const std::vector<int32_t>& outputs) {
+    int crossings = 0;
+    for (size_t i = 1; i < outputs.size(); i++) {
+        // The backend compares against T1_THRESHOLD without hysteresis
+        bool wasHot = outputs[i - 1] > THRESHOLD_MV;
+        bool isHot = outputs[i] > THRESHOLD_MV;
+        crossings += (wasHot != isHot) ? 1 : 0;
+    }
+    return crossings;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Trace trace;
+    if (argc > 1) {
+        if (!loadTrace(argv[1], trace)) {
+            std::fprintf(stderr, "Cannot read trace %s\n", argv[1]);
+            return 1;
+        }
+        std::printf("Recorded trace: %zu readings (noise = RMS of successive differences / sqrt 2)\n",
+                    trace.readings.size());
+    } else {
+        trace = syntheticTrace(2000);
+        std::printf("Synthetic trace: %zu readings (noise = RMS error against the noise-free ramp)\n",
+                    trace.readings.size());
+    }
+
+    std::printf("%-32s %12s %12s %12s\n", "configuration", "ns/sample", "noise mV", "crossings");
+    for (const FilterConfig& config : CONFIGS) {
+        std::vector<int32_t> outputs = runFilter(config, trace);
+        std::printf("%-32s %12.1f %12.2f %12d\n", config.name, nanosecondsPerSample(config, trace),
+                    noiseMillivolts(outputs, trace), thresholdCrossings(outputs));
+    }
+    return 0;
+}
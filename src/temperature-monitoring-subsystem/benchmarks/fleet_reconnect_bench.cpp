@@ -0,0 +1,270 @@
+/**
+ * @file fleet_reconnect_bench.cpp
+ * @brief Host-side simulation of a fleet reconnecting after a broker restart.
+ *
+ * Runs hundreds of real FsmManagerImpl instances against the HAL fakes of the
+ * native test environment, in virtual time: each device runs when its
+ * getNextDeadline() is due, as main.cpp does with IDLE_SLEEP_ENABLED. Once
+ * the whole fleet is operational the broker goes down, restarts after
+ * BROKER_DOWN_MS and then accepts a limited number of connections per second
+ * (CONNACK refused beyond that, as an overloaded broker or its
+ * max-connection-rate limit would). The report gives the time from the
+ * restart until every device is operational again, the busiest second of
+ * connection attempts and the attempts in total.
+ *
+ * Compared policies:
+ *  - fixed: the retry schedule before the backoff (WiFi wait of
+ *    WIFI_RECONNECT_INTERVAL_MS, then an MQTT attempt every
+ *    MQTT_RECONNECT_INTERVAL_MS), modeled directly since the FSM no longer
+ *    implements it;
+ *  - backoff, same seed: the FSM with every device seeded alike, i.e.
+ *    exponential backoff without effective jitter;
+ *  - backoff, chip ID seed: the FSM as shipped, each device with its own MAC.
+ *
+ * All devices share the RtcSampleStoreImpl queue (it models RTC memory as a
+ * static); the queue only takes the offline samples and does not affect the
+ * connection timing.
+ *
+ * Build and run from the temperature-monitoring-subsystem directory:
+ *   g++ -O2 -std=gnu++17 -Isrc -Itest/fakes benchmarks/fleet_reconnect_bench.cpp \
+ *       src/kernel/impl/FsmManagerImpl.cpp src/kernel/impl/PolledSampleSourceImpl.cpp \
+ *       src/kernel/impl/RtcSampleStoreImpl.cpp src/kernel/impl/ReconnectBackoff.cpp \
+ *       src/kernel/impl/LoopProfiler.cpp src/kernel/impl/Log.cpp -o fleet_reconnect_bench
+ *   ./fleet_reconnect_bench [devices] [accepts per second]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <Arduino.h>
+#include "FakeLedStatus.h"
+#include "FakeMqttManager.h"
+#include "FakeTemperatureManager.h"
+#include "FakeWifiManager.h"
+#include "kernel/api/FsmManagerImpl.h"
+#include "kernel/api/PolledSampleSourceImpl.h"
+#include "kernel/api/RtcSampleStoreImpl.h"
+
+namespace {
+
+const unsigned long DEFAULT_DEVICES = 500;
+const unsigned long DEFAULT_ACCEPTS_PER_S = 50;
+const unsigned long BOOT_SPREAD_MS = 2000;      ///< Devices power up across this window.
+const unsigned long CRASH_TIME_MS = 10000;      ///< Broker goes down, the fleet being operational.
+const unsigned long BROKER_DOWN_MS = 30000;     ///< Broker restart time.
+const unsigned long SIMULATED_MS = 30UL * 60 * 1000;
+const uint64_t BASE_MAC = 0x0000A1B2C3D4E5F6ULL;
+
+/**
+ * @class BrokerModel
+ * @brief Down until upAt, then accepts at most acceptsPerS connections per second.
+ */
+class BrokerModel {
+public:
+    BrokerModel(unsigned long upAt, unsigned long acceptsPerS)
+        : _upAt(upAt), _acceptsPerS(acceptsPerS), _bucket(0), _accepted(0), _attempts(0),
+          _bucketAttempts(0), _peakAttempts(0) {}
+
+    bool connect(unsigned long now) {
+        unsigned long bucket = now / 1000;
+        if (bucket != _bucket) {
+            _bucket = bucket;
+            _accepted = 0;
+            _bucketAttempts = 0;
+        }
+        _attempts++;
+        if (++_bucketAttempts > _peakAttempts) {
+            _peakAttempts = _bucketAttempts;
+        }
+        if (now < _upAt || _accepted >= _acceptsPerS) {
+            return false;
+        }
+        _accepted++;
+        return true;
+    }
+
+    unsigned long attempts() const { return _attempts; }
+    unsigned long peakAttempts() const { return _peakAttempts; }
+
+private:
+    unsigned long _upAt;
+    unsigned long _acceptsPerS;
+    unsigned long _bucket;
+    unsigned long _accepted;
+    unsigned long _attempts;
+    unsigned long _bucketAttempts;
+    unsigned long _peakAttempts;
+};
+
+/** @brief Session that asks the broker model; connects always succeed before the crash. */
+class BrokerMqttManager : public FakeMqttManager {
+public:
+    BrokerModel* broker = nullptr;
+
+    bool connect() override {
+        connectCalls++;
+        connected = broker ? broker->connect(millis()) : true;
+        return connected;
+    }
+};
+
+/**
+ * @struct Device
+ * @brief One FSM and its fakes.
+ */
+struct Device {
+    FakeLedStatus led;
+    FakeTemperatureManager temperature;
+    FakeWifiManager wifi;
+    BrokerMqttManager mqtt;
+    PolledSampleSourceImpl source{temperature};
+    RtcSampleStoreImpl store;
+    FsmManagerImpl fsm{led, source, wifi, mqtt, store};
+};
+
+struct Result {
+    unsigned long recoveryMs;   ///< From the broker restart to the last device operational, 0 if never.
+    unsigned long peakAttempts; ///< Connection attempts in the busiest second.
+    unsigned long attempts;     ///< Connection attempts after the crash.
+};
+
+/** @brief Boot time of a device, spread evenly over BOOT_SPREAD_MS. */
+unsigned long bootTime(unsigned long index, unsigned long devices) {
+    return 1 + index * BOOT_SPREAD_MS / devices;
+}
+
+/**
+ * @brief Factory MAC of a device, as consecutive serials in the last two MAC bytes.
+ * getEfuseMac() holds the MAC bytes in reverse order, the last one on top.
+ */
+uint64_t macFor(unsigned long index) {
+    return BASE_MAC + ((uint64_t)(index & 0xff) << 40) + ((uint64_t)((index >> 8) & 0xff) << 32);
+}
+
+/**
+ * @brief The pre-backoff schedule: every device retries on the same fixed intervals.
+ */
+Result runFixed(unsigned long devices, unsigned long acceptsPerS) {
+    BrokerModel broker(CRASH_TIME_MS + BROKER_DOWN_MS, acceptsPerS);
+    unsigned long lastUp = 0;
+    unsigned long connectedDevices = 0;
+
+    // Attempts must reach the broker in time order for its per-second buckets
+    typedef std::pair<unsigned long, unsigned long> Attempt;
+    std::priority_queue<Attempt, std::vector<Attempt>, std::greater<Attempt>> pending;
+    for (unsigned long i = 0; i < devices; i++) {
+        // Polling in OPERATIONAL sees the loss within one idle poll of the crash
+        unsigned long detect = CRASH_TIME_MS + bootTime(i, devices) % IDLE_POLL_INTERVAL_MS;
+        pending.push(Attempt(detect + WIFI_RECONNECT_INTERVAL_MS, i));
+    }
+    while (!pending.empty() && pending.top().first < SIMULATED_MS) {
+        Attempt attempt = pending.top();
+        pending.pop();
+        if (broker.connect(attempt.first)) {
+            connectedDevices++;
+            lastUp = attempt.first;
+        } else {
+            pending.push(Attempt(attempt.first + MQTT_RECONNECT_INTERVAL_MS, attempt.second));
+        }
+    }
+
+    Result result;
+    result.recoveryMs = connectedDevices == devices ? lastUp - (CRASH_TIME_MS + BROKER_DOWN_MS) : 0;
+    result.peakAttempts = broker.peakAttempts();
+    result.attempts = broker.attempts();
+    return result;
+}
+
+/**
+ * @brief Runs the real FSMs through the crash and the restart.
+ * @param chipIdSeeds True for a MAC per device, false for one MAC shared by the fleet.
+ */
+Result runFleet(unsigned long devices, unsigned long acceptsPerS, bool chipIdSeeds) {
+    fake::reset();
+    BrokerModel broker(CRASH_TIME_MS + BROKER_DOWN_MS, acceptsPerS);
+
+    std::vector<std::unique_ptr<Device>> fleet;
+    typedef std::pair<unsigned long, unsigned long> Wake;
+    std::priority_queue<Wake, std::vector<Wake>, std::greater<Wake>> wakes;
+    for (unsigned long i = 0; i < devices; i++) {
+        fake::setMillis(bootTime(i, devices));
+        fake::efuseMac = chipIdSeeds ? macFor(i) : BASE_MAC;
+        fleet.emplace_back(new Device());
+        Device& device = *fleet.back();
+        device.wifi.pollResult = WIFI_CONNECT_SUCCESS;
+        device.store.setup();
+        device.fsm.setup();
+        device.source.setup();
+        wakes.push(Wake(millis(), i));
+    }
+
+    bool crashed = false;
+    unsigned long operational = 0;
+    unsigned long lastUp = 0;
+    while (!wakes.empty() && wakes.top().first < SIMULATED_MS) {
+        Wake wake = wakes.top();
+        wakes.pop();
+
+        if (!crashed && wake.first >= CRASH_TIME_MS) {
+            // Every session drops at once; later connects go through the broker model
+            crashed = true;
+            for (auto& device : fleet) {
+                device->mqtt.connected = false;
+                device->mqtt.broker = &broker;
+            }
+        }
+
+        Device& device = *fleet[wake.second];
+        fake::setMillis(wake.first);
+        // Only a reconnect enters OPERATIONAL from MQTT_CONNECTING; sending states return to it directly
+        bool wasConnecting = device.fsm.getCurrentState() == STATE_MQTT_CONNECTING;
+        device.fsm.run();
+        if (crashed && wasConnecting && device.fsm.getCurrentState() == STATE_OPERATIONAL) {
+            operational++;
+            lastUp = wake.first;
+            if (operational == devices) {
+                break;
+            }
+        }
+        wakes.push(Wake(device.fsm.getNextDeadline(wake.first), wake.second));
+    }
+
+    Result result;
+    result.recoveryMs = operational == devices ? lastUp - (CRASH_TIME_MS + BROKER_DOWN_MS) : 0;
+    result.peakAttempts = broker.peakAttempts();
+    result.attempts = broker.attempts();
+    return result;
+}
+
+void print(const char* name, const Result& result) {
+    if (result.recoveryMs > 0) {
+        std::printf("%-28s %12.1f", name, result.recoveryMs / 1000.0);
+    } else {
+        std::printf("%-28s %12s", name, "never");
+    }
+    std::printf(" %14lu %14lu\n", result.peakAttempts, result.attempts);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned long devices = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : DEFAULT_DEVICES;
+    unsigned long acceptsPerS = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : DEFAULT_ACCEPTS_PER_S;
+    if (devices == 0 || acceptsPerS == 0) {
+        std::fprintf(stderr, "Usage: %s [devices] [accepts per second]\n", argv[0]);
+        return 1;
+    }
+
+    std::printf("%lu devices, broker down %lu s, then %lu connections/s\n",
+                devices, BROKER_DOWN_MS / 1000, acceptsPerS);
+    std::printf("%-28s %12s %14s %14s\n", "policy", "recovery s", "peak attempts/s", "attempts");
+    print("fixed intervals", runFixed(devices, acceptsPerS));
+    print("backoff, same seed", runFleet(devices, acceptsPerS, false));
+    print("backoff, chip ID seed", runFleet(devices, acceptsPerS, true));
+    return 0;
+}
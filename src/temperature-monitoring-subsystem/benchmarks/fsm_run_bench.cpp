@@ -0,0 +1,175 @@
+/**
+ * @file fsm_run_bench.cpp
+ * @brief Host-side benchmark of one FsmManagerImpl::run() cycle.
+ *
+ * Runs the real FSM, sample source and store against the HAL fakes of the
+ * native test environment and reports the cost per loop() iteration in the
+ * states the firmware spends its time in. Absolute figures are host CPU
+ * time; use them to compare changes to the FSM, not to predict ESP32 timing.
+ * The profiled scenario wraps run() the way main.cpp does when
+ * LOOP_PROFILING_ENABLED is set, with the host steady clock standing in for
+ * esp_timer_get_time(), to bound the cost of the instrumentation.
+ * The idle sleep figures jump the fake clock to getNextDeadline() after each
+ * run(), as main.cpp does with IDLE_SLEEP_ENABLED, and count the wake-ups.
+ *
+ * Build and run from the temperature-monitoring-subsystem directory:
+ *   g++ -O2 -std=gnu++17 -Isrc -Itest/fakes benchmarks/fsm_run_bench.cpp src/kernel/impl/FsmManagerImpl.cpp \
+ *       src/kernel/impl/PolledSampleSourceImpl.cpp src/kernel/impl/RtcSampleStoreImpl.cpp src/kernel/impl/ReconnectBackoff.cpp \
+ *       src/kernel/impl/LoopProfiler.cpp src/kernel/impl/Log.cpp -o fsm_run_bench
+ *   ./fsm_run_bench [cycles]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include <Arduino.h>
+#include "FakeLedStatus.h"
+#include "FakeMqttManager.h"
+#include "FakeTemperatureManager.h"
+#include "FakeWifiManager.h"
+#include "kernel/api/FsmManagerImpl.h"
+#include "kernel/api/LoopProfiler.h"
+#include "kernel/api/PolledSampleSourceImpl.h"
+#include "kernel/api/RtcSampleStoreImpl.h"
+
+namespace {
+
+const unsigned long DEFAULT_CYCLES = 5000000;   ///< run() calls per scenario.
+const unsigned long SAMPLE_INTERVAL_MS = 1000;  ///< Fastest interval the backend policy uses.
+
+/**
+ * @struct Scenario
+ * @brief Where the FSM is parked and how fast the fake clock moves per cycle.
+ */
+struct Scenario {
+    const char* name;
+    bool online;                ///< Connect before timing, else stay in WAIT_RECONNECT.
+    unsigned long msPerCycle;   ///< Fake clock advance per run() call.
+    bool profiled;              ///< Time every run() into a LoopProfiler.
+};
+
+const Scenario SCENARIOS[] = {
+    {"operational, idle", true, 0, false},
+    {"operational, idle, profiled", true, 0, true},
+    {"operational, 1 ms/cycle", true, 1, false},
+    {"operational, 1 ms/cycle, profiled", true, 1, true},
+    {"operational, 100 ms/cycle", true, 100, false},
+    {"offline, 1 ms/cycle", false, 1, false},
+};
+
+struct Result {
+    double nsPerCycle;
+    size_t published;
+};
+
+/** @brief Host stand-in for esp_timer_get_time(). */
+int64_t timerMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Result runScenario(const Scenario& scenario, unsigned long cycles) {
+    fake::reset();
+    fake::setMillis(1);
+
+    FakeLedStatus led;
+    FakeTemperatureManager temperature;
+    FakeWifiManager wifi;
+    FakeMqttManager mqtt;
+    PolledSampleSourceImpl source(temperature);
+    RtcSampleStoreImpl store;
+    LoopProfiler profiler;
+    FsmManagerImpl fsm(led, source, wifi, mqtt, store, &profiler);
+
+    store.setup();
+    store.discard(store.size());
+    fsm.setup();
+    source.setup();
+
+    wifi.acceptBegin = scenario.online;
+    wifi.pollResult = WIFI_CONNECT_SUCCESS;
+    for (int i = 0; i < 10 && fsm.getCurrentState() != STATE_OPERATIONAL; i++) {
+        fsm.run();
+    }
+    mqtt.intervalMs = SAMPLE_INTERVAL_MS;
+    mqtt.hasInterval = true;
+    fsm.run();
+
+    // Reserve up front so recording the publishes does not reallocate inside the timed loop
+    mqtt.samples.reserve(cycles * scenario.msPerCycle / SAMPLE_INTERVAL_MS + 16);
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < cycles; i++) {
+        fake::advanceMillis(scenario.msPerCycle);
+        if (scenario.profiled) {
+            uint8_t slot = fsm.getCurrentState();
+            int64_t cycleStart = timerMicros();
+            fsm.run();
+            profiler.record(slot, (uint32_t)(timerMicros() - cycleStart));
+        } else {
+            fsm.run();
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    Result result;
+    result.nsPerCycle = std::chrono::duration<double, std::nano>(elapsed).count() / cycles;
+    result.published = mqtt.samples.size() + mqtt.batched.size();
+    return result;
+}
+
+/**
+ * @brief Counts run() calls over a simulated minute when loop() sleeps until each deadline.
+ */
+unsigned long wakeupsPerMinute(bool online) {
+    fake::reset();
+    fake::setMillis(1);
+
+    FakeLedStatus led;
+    FakeTemperatureManager temperature;
+    FakeWifiManager wifi;
+    FakeMqttManager mqtt;
+    PolledSampleSourceImpl source(temperature);
+    RtcSampleStoreImpl store;
+    FsmManagerImpl fsm(led, source, wifi, mqtt, store);
+
+    store.setup();
+    store.discard(store.size());
+    fsm.setup();
+    source.setup();
+    wifi.acceptBegin = online;
+    wifi.pollResult = WIFI_CONNECT_SUCCESS;
+
+    unsigned long end = millis() + 60000;
+    unsigned long wakeups = 0;
+    while ((long)(millis() - end) < 0) {
+        fsm.run();
+        wakeups++;
+        // Transient states return the current time and run again at once
+        fake::setMillis(fsm.getNextDeadline(millis()));
+    }
+    return wakeups;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned long cycles = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : DEFAULT_CYCLES;
+    if (cycles == 0) {
+        std::fprintf(stderr, "Usage: %s [cycles]\n", argv[0]);
+        return 1;
+    }
+
+    std::printf("%lu run() cycles per scenario, sampling every %lu ms\n", cycles, SAMPLE_INTERVAL_MS);
+    std::printf("%-36s %12s %12s\n", "scenario", "ns/cycle", "published");
+    for (const Scenario& scenario : SCENARIOS) {
+        Result result = runScenario(scenario, cycles);
+        std::printf("%-36s %12.1f %12zu\n", scenario.name, result.nsPerCycle, result.published);
+    }
+
+    std::printf("\nrun() calls per simulated minute with idle sleep\n");
+    std::printf("%-36s %12lu\n", "operational", wakeupsPerMinute(true));
+    std::printf("%-36s %12lu\n", "offline", wakeupsPerMinute(false));
+    return 0;
+}
@@ -14,28 +14,66 @@
 #define MQTT_SERVER_PORT 1883
 /** @brief Prefix for generating unique MQTT client IDs. */
 #define MQTT_CLIENT_ID_PREFIX "esp32s3-main-mon-"
+/** @brief Size of the PubSubClient packet buffer in bytes (library default is 256). */
+#define MQTT_PACKET_BUFFER_SIZE 1024
+/** @brief Capacity in bytes of the static JSON document used to parse configuration messages. */
+#define MQTT_CONFIG_JSON_CAPACITY 192
+/** @brief Set to 1 to keep the MQTT session across reconnects, so QoS 1 config commands sent while offline are queued by the broker. */
+#define MQTT_PERSISTENT_SESSION 1
+/** @brief Longest wait after connecting for the retained frequency and policy before going operational without them. */
+#define MQTT_CONFIG_SYNC_TIMEOUT_MS 1000
 
 // === MQTT Topic Configuration ===
 /** @brief Topic for publishing temperature data to the Control Unit. */
 #define MQTT_TOPIC_TEMPERATURE "assignment3/temperature"
 /** @brief Topic for publishing system status messages. */
 #define MQTT_TOPIC_STATUS "assignment3/status"
-/** @brief Topic for receiving sampling frequency configuration from the Control Unit. */
+/** @brief Retained topic for receiving the sampling frequency override from the Control Unit. */
 #define MQTT_TOPIC_CONFIG_F "assignment3/frequency"
+/** @brief MQTT topic for the retained threshold-to-interval sampling policy. */
+#define MQTT_TOPIC_CONFIG_POLICY "assignment3/policy"
+/** @brief Topic for publishing loop timing histograms. */
+#define MQTT_TOPIC_METRICS "assignment3/metrics"
+/** @brief Topic for publishing windowed temperature statistics. */
+#define MQTT_TOPIC_STATS "assignment3/stats"
+/** @brief Topic for temperature data in the binary record layout of BinaryTelemetry.h. */
+#define MQTT_TOPIC_TEMPERATURE_BINARY MQTT_TOPIC_TEMPERATURE "/bin"
+/** @brief Topic for status messages in the binary record layout of BinaryTelemetry.h. */
+#define MQTT_TOPIC_STATUS_BINARY MQTT_TOPIC_STATUS "/bin"
 
 // === Hardware Pin Configuration ===
-/** @brief Analog GPIO pin connected to the TMP36 temperature sensor. */
+/** @brief Analog GPIO pin connected to the TMP36 temperature sensor (channel 0). */
 #define TEMP_SENSOR_PIN 4
 /** @brief Digital GPIO pin for the green status LED. */
 #define GREEN_LED_PIN 18
 /** @brief Digital GPIO pin for the red status LED. */
 #define RED_LED_PIN 19
 
+// === Status LED Configuration ===
+/** @brief Duration of one step of the LED blink patterns in milliseconds. */
+#define LED_BLINK_STEP_MS 100
+/** @brief Steps per blink code period: one red blink while WiFi connects, two while MQTT connects. */
+#define LED_BLINK_PERIOD_STEPS 20
+/** @brief Duration of the both-LEDs flash at boot in milliseconds, played without blocking setup(). */
+#define LED_BOOT_FLASH_MS 250
+
+// === Multi-Channel Sampling Configuration ===
+/** @brief Number of TMP36 sensors read per sample frame (e.g. ceiling, floor, near the window), 1 to 10. */
+#ifndef TEMP_CHANNEL_COUNT
+#define TEMP_CHANNEL_COUNT 1
+#endif
+/** @brief ADC1 GPIO pins of the channels in frame order, TEMP_CHANNEL_COUNT entries (e.g. {4, 5, 6}). */
+#ifndef TEMP_CHANNEL_PINS
+#define TEMP_CHANNEL_PINS { TEMP_SENSOR_PIN }
+#endif
+/** @brief Control temperature of a frame (deadband, policy bands, statistics): 1 the warmest channel, 0 the mean. */
+#define TEMP_CHANNEL_AGGREGATE_MAX 1
+/** @brief Worst-case length of the ,"ch":[-999.99,...] list appended to each JSON sample of a multi-channel frame. */
+#define TEMP_CHANNEL_JSON_MAX_LEN (TEMP_CHANNEL_COUNT > 1 ? 8 + 8 * TEMP_CHANNEL_COUNT : 0)
+
 // === Temperature Sensor Configuration ===
-/** @brief ESP32 ADC resolution in bits (12-bit = 4096 levels, 0-4095). */
-#define ESP32_ADC_RESOLUTION 4095.0f
-/** @brief ESP32 ADC reference voltage in volts. */
-#define ESP32_ADC_VREF 3.3f
+/** @brief ADC reference voltage assumed by the calibration when the chip has no eFuse calibration data (mV). */
+#define ADC_DEFAULT_VREF_MV 1100
 /** @brief TMP36 voltage-to-temperature conversion factor (mV/°C). */
 #define TMP36_MV_PER_CELSIUS 10.0f
 /** @brief TMP36 voltage offset at 0°C in mV. */
@@ -46,17 +84,132 @@
 #define TEMP_MIN_VALID -10.0f
 /** @brief Maximum reasonable temperature for indoor monitoring (°C). */
 #define TEMP_MAX_VALID 60.0f
-/** @brief Delay in milliseconds before re-reading anomalous temperature values. */
-#define TEMP_REREAD_DELAY_MS 10
+
+// === Temperature Filter Configuration ===
+/** @brief Number of ADC readings taken back-to-back for each temperature sample. */
+#define TEMP_FILTER_OVERSAMPLES 16
+/** @brief Middle readings averaged after sorting the burst (1 = median, TEMP_FILTER_OVERSAMPLES = plain average). */
+#define TEMP_FILTER_MEDIAN_WINDOW 8
+/** @brief EMA weight of a new sample is 1/2^shift (0 disables the moving average). */
+#define TEMP_FILTER_EMA_SHIFT 2
 
 // === Timing and Interval Configuration ===
 /** @brief Default temperature sampling interval in milliseconds. */
 #define TEMP_SAMPLE_INTERVAL_DEFAULT_MS 10000
-/** @brief Interval between MQTT reconnection attempts in milliseconds. */
+/** @brief Maximum number of temperature bands in a sampling policy. */
+#define SAMPLING_POLICY_MAX_BANDS 4
+/** @brief Shortest sampling interval accepted from MQTT, in seconds. */
+#define SAMPLING_INTERVAL_MIN_S 1
+/** @brief Longest sampling interval accepted from MQTT, in seconds. */
+#define SAMPLING_INTERVAL_MAX_S 600
+/** @brief Longest wait after the first failed MQTT attempt in milliseconds; the jittered wait doubles per failure. */
 #define MQTT_RECONNECT_INTERVAL_MS 5000
+/** @brief Cap of the MQTT reconnection backoff in milliseconds. */
+#define MQTT_RECONNECT_MAX_INTERVAL_MS 60000
 /** @brief Timeout for WiFi connection attempts in milliseconds. */
 #define WIFI_CONNECT_TIMEOUT_MS 15000
-/** @brief Interval between WiFi reconnection attempts in milliseconds. */
+/** @brief Longest wait after the first network error in milliseconds; the jittered wait doubles per error. */
 #define WIFI_RECONNECT_INTERVAL_MS 10000
+/** @brief Cap of the network error backoff in milliseconds. */
+#define WIFI_RECONNECT_MAX_INTERVAL_MS 120000
+/** @brief Timeout for a fast-path WiFi attempt using cached BSSID/channel/IP before falling back to a full scan. */
+#define WIFI_FAST_CONNECT_TIMEOUT_MS 3000
+/** @brief Interval in milliseconds between periodic status reports while operational. */
+#define STATUS_REPORT_INTERVAL_MS 300000
+
+// === Sampling Task Configuration ===
+/** @brief Set to 1 to sample from a timer-driven FreeRTOS task, 0 to sample inline from the FSM loop. */
+#define SAMPLING_TASK_ENABLED 1
+/** @brief Core the sampling task is pinned to (the Arduino loop, WiFi and MQTT run on core 1). */
+#define SAMPLING_TASK_CORE 0
+/** @brief FreeRTOS priority of the sampling task, above the WiFi/LwIP tasks sharing its core. */
+#define SAMPLING_TASK_PRIORITY 20
+/** @brief Stack size of the sampling task in bytes. */
+#define SAMPLING_TASK_STACK_SIZE 4096
+/** @brief Samples buffered between the sampling task and the FSM before new samples are dropped. */
+#define SAMPLING_QUEUE_CAPACITY 16
+
+// === Loop Profiling Configuration ===
+/** @brief Set to 1 to time FsmManager::run() per state and MqttManager::loop(), 0 to compile the profiling out. */
+#define LOOP_PROFILING_ENABLED 1
+/** @brief Interval in milliseconds between loop timing reports; the histograms restart after each report. */
+#define LOOP_METRICS_INTERVAL_MS 300000
+
+// === Idle Sleep Configuration ===
+/** @brief Set to 1 to block loop() until the FSM's next deadline, 0 to run it back to back. */
+#define IDLE_SLEEP_ENABLED 1
+/** @brief Longest idle sleep while waiting on polled events (incoming MQTT data, WiFi progress, link loss). */
+#define IDLE_POLL_INTERVAL_MS 20
+
+// === Deep Sleep Configuration ===
+/** @brief Set to 1 to deep sleep between samples once published (battery nodes), 0 to stay connected. */
+#define DEEP_SLEEP_ENABLED 0
+/** @brief Shortest time until the next sample worth a deep sleep; shorter gaps are idled through awake. */
+#define DEEP_SLEEP_MIN_DURATION_MS 5000
+/** @brief Time kept connected after MQTT connects so retained configuration arrives before sleeping. */
+#define DEEP_SLEEP_CONFIG_LINGER_MS 300
+/** @brief Target time from wake-up to the first sample publish; slower wakes are counted as overruns. */
+#define DEEP_SLEEP_WAKE_BUDGET_MS 2000
+
+// === Logging Configuration ===
+/** @brief Most verbose level compiled in: 0 none, 1 error, 2 warning, 3 info, 4 debug. */
+#ifndef LOG_LEVEL
+#define LOG_LEVEL 3
+#endif
+/** @brief Log messages queued between drains before the oldest are dropped (32 bytes each). */
+#define LOG_BUFFER_RECORDS 64
+/** @brief Maximum length of one formatted log line; longer lines are truncated. */
+#define LOG_LINE_MAX_LEN 160
+/** @brief Maximum number of log lines written to Serial per loop() iteration. */
+#define LOG_DRAIN_MAX_RECORDS 8
+
+// === Persistent Storage Configuration ===
+/** @brief NVS namespace holding the cached parameters of the last good WiFi connection. */
+#define WIFI_NVS_NAMESPACE "wifi-cache"
+/** @brief NVS namespace holding the calibrated ADC-to-temperature lookup table. */
+#define ADC_CAL_NVS_NAMESPACE "adc-cal"
+
+// === Report-by-Exception Configuration ===
+/**
+ * @brief Smallest temperature change in Celsius published right away; 0 publishes every sample (not applied to batches).
+ *
+ * Has no effect with DEEP_SLEEP_ENABLED: every wake reconnects, which restarts the deadband, and the
+ * wake's sample is taken while connecting and published with the backlog, which the deadband never filters.
+ */
+#define PUBLISH_DEADBAND_C 0.2f
+/** @brief Longest time in milliseconds between published samples; an unchanged sample is sent as heartbeat then. */
+#define PUBLISH_HEARTBEAT_MS 60000
+
+// === Windowed Statistics Configuration ===
+/** @brief Set to 1 to publish count/mean/variance/min/max of every sample taken per window, 0 to compile it out. */
+#define STATS_WINDOW_ENABLED 1
+/** @brief Length of a statistics window in milliseconds, counted from its first sample (deep sleeps included). */
+#define STATS_WINDOW_MS 300000
+/** @brief Set to 1 to publish raw samples alongside the summaries, 0 to publish the summaries only. */
+#define STATS_RAW_SAMPLES_ENABLED 1
+
+// === Telemetry Encoding Configuration ===
+/** @brief Set to 1 to publish temperature and status as binary records on the "/bin" topics, 0 for JSON. */
+#define TELEMETRY_BINARY_ENABLED 0
+
+// === Telemetry Batching Configuration ===
+/** @brief Set to 1 to publish samples in batches, 0 to publish one message per sample. */
+#define TELEMETRY_BATCH_ENABLED 0
+/** @brief Number of samples that triggers a batch publish (also the batch buffer capacity). */
+#define TELEMETRY_BATCH_MAX_SAMPLES 10
+/** @brief Maximum age in milliseconds of the oldest buffered sample before the batch is published. */
+#define TELEMETRY_BATCH_MAX_AGE_MS 60000
+/** @brief Worst-case encoded size of one batch entry: {"ts":4294967295,"seq":4294967295,"t":-999.99}, plus the channels. */
+#define TELEMETRY_BATCH_ENTRY_MAX_LEN (48 + TEMP_CHANNEL_JSON_MAX_LEN)
+
+// === Store-and-Forward Configuration ===
+/** @brief Maximum number of samples queued in RTC memory while the network is down (12 bytes each, 2 more per channel beyond one, rounded up to 4). */
+#define STORE_FORWARD_CAPACITY 480
+/** @brief Overflow policy: 1 drops the oldest queued sample, 0 drops the incoming sample. */
+#define STORE_FORWARD_DROP_OLDEST 1
+/** @brief Interval in milliseconds between backlog publishes once the connection is restored. */
+#define STORE_FORWARD_DRAIN_INTERVAL_MS 1000
+/** @brief Maximum number of queued samples published per backlog message. */
+#define STORE_FORWARD_DRAIN_BATCH 10
 
 #endif // CONFIG_H
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef LED_PATTERN_PLAYER_H
+#define LED_PATTERN_PLAYER_H
+
+#include <stdint.h>
+
+/** @brief Bit of LedPatternPlayer::levels() for the green LED. */
+const uint8_t LED_LEVEL_GREEN = 0x01;
+/** @brief Bit of LedPatternPlayer::levels() for the red LED. */
+const uint8_t LED_LEVEL_RED = 0x02;
+
+/**
+ * @struct LedPattern
+ * @brief Declarative blink pattern of the two status LEDs.
+ *
+ * The pattern is a sequence of equal-length steps; bit i of a mask turns
+ * its LED on during step i. Patterns are compared by address, so define
+ * them with static storage.
+ */
+struct LedPattern {
+    uint16_t stepMs;        ///< Duration of one step in milliseconds.
+    uint8_t stepCount;      ///< Number of steps, 1 to 32.
+    uint32_t greenSteps;    ///< Steps during which the green LED is on.
+    uint32_t redSteps;      ///< Steps during which the red LED is on.
+    bool repeat;            ///< True to loop forever, false to play once and then hand over.
+};
+
+/**
+ * @class LedPatternPlayer
+ * @brief Steps through LED patterns from one level change to the next.
+ *
+ * Hardware-independent: the owner writes levels() to the pins and schedules
+ * a timer for holdMs(), then calls advance() when it fires. Steps with the
+ * same levels are merged, so the timer only fires on an actual change and a
+ * steady pattern needs no timer at all.
+ */
+class LedPatternPlayer {
+public:
+    LedPatternPlayer();
+
+    /**
+     * @brief Requests a pattern.
+     *
+     * Requesting the pattern already playing or queued does nothing. A
+     * non-repeating pattern plays to its end first unless preempted; the
+     * latest request made meanwhile follows it.
+     *
+     * @param pattern Pattern with static storage.
+     * @param preempt True to switch immediately even during a non-repeating pattern.
+     * @return True if the levels and the timer must be refreshed now.
+     */
+    bool request(const LedPattern& pattern, bool preempt = false);
+
+    /**
+     * @brief Moves past the current level run, to the next level change.
+     * At the end of a non-repeating pattern, the queued pattern starts (all off if none).
+     */
+    void advance();
+
+    /**
+     * @brief LED levels of the current step as LED_LEVEL_* bits.
+     */
+    uint8_t levels() const;
+
+    /**
+     * @brief Time in milliseconds until the levels change, 0 if they never do.
+     */
+    uint32_t holdMs() const;
+
+    /**
+     * @brief The pattern playing, nullptr while all LEDs are off after a non-repeating pattern.
+     */
+    const LedPattern* current() const { return _pattern; }
+
+private:
+    const LedPattern* _pattern;     ///< Pattern playing.
+    const LedPattern* _next;        ///< Pattern queued behind a non-repeating one.
+    uint8_t _step;                  ///< Current step of _pattern.
+
+    /**
+     * @brief Number of consecutive steps from the current one with its levels, 0 for a steady pattern.
+     */
+    uint8_t runLength() const;
+
+    /**
+     * @brief LED levels of a step of the current pattern.
+     */
+    uint8_t levelsAt(uint8_t step) const;
+};
+
+#endif // LED_PATTERN_PLAYER_H
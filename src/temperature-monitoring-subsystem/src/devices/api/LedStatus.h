@@ -36,17 +36,19 @@ public:
 
   /**
    * @brief Provides a visual cue for system boot-up sequence.
-   * A brief blink pattern to confirm system startup.
+   * A brief flash to confirm system startup; does not block, the next indication follows it.
    */
   virtual void indicateSystemBoot() = 0;
 
   /**
    * @brief Sets LEDs to indicate WiFi connection attempt.
+   * Single red blink per period.
    */
   virtual void indicateWifiConnecting() = 0;
 
   /**
    * @brief Sets LEDs to indicate MQTT connection attempt.
+   * Double red blink per period.
    */
   virtual void indicateMqttConnecting() = 0;
 
@@ -1,15 +1,20 @@
 #ifndef LED_STATUS_IMPL_H
 #define LED_STATUS_IMPL_H
 
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
 #include "LedStatus.h"
+#include "LedPatternPlayer.h"
 #include "config/config.h"
 
 /**
  * @class LedStatusImpl
  * @brief Implements LedStatus for two standard (green/red) LEDs.
  * 
- * Manages GPIO pins to provide visual feedback on system status using
- * standard digital LEDs connected to ESP32 GPIO pins.
+ * Each indication is a declarative LedPattern played in the background by a
+ * one-shot esp_timer that is armed only until the next level change. The
+ * indicate methods return immediately, and repeating the current indication
+ * (as the FSM does on every cycle) touches neither the pins nor the timer.
  */
 class LedStatusImpl : public LedStatus {
 public:
@@ -34,8 +39,34 @@ public:
   void turnLedsOff() override;
 
 private:
-  int _greenLedPin;   ///< GPIO pin assigned to the green LED.
-  int _redLedPin;     ///< GPIO pin assigned to the red LED.
+  int _greenLedPin;           ///< GPIO pin assigned to the green LED.
+  int _redLedPin;             ///< GPIO pin assigned to the red LED.
+  LedPatternPlayer _player;   ///< Pattern state, shared with the timer callback under _lock.
+  uint8_t _levels;            ///< LED_LEVEL_* bits last written to the pins.
+  int64_t _changeDueUs;       ///< esp_timer time of the next level change, INT64_MAX if none.
+  esp_timer_handle_t _timer;  ///< One-shot timer firing at the next level change.
+  portMUX_TYPE _lock;         ///< Guards the player against the timer callback.
+
+  /**
+   * @brief Requests a pattern and, if it starts now, writes its levels and re-arms the timer.
+   */
+  void show(const LedPattern& pattern, bool preempt = false);
+
+  /**
+   * @brief Writes the player's levels to the pins that differ and arms the timer for the next change.
+   * Must be called with _lock held.
+   */
+  void applyLocked();
+
+  /**
+   * @brief esp_timer callback, forwards to onTimer().
+   */
+  static void timerCallback(void* param);
+
+  /**
+   * @brief Advances the pattern to its next level change.
+   */
+  void onTimer();
 };
 
-#endif // LED_STATUS_IMPL_H
\ No newline at end of file
+#endif // LED_STATUS_IMPL_H
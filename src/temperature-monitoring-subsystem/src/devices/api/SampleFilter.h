@@ -0,0 +1,70 @@
+#ifndef SAMPLE_FILTER_H
+#define SAMPLE_FILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @class SampleFilter
+ * @brief Integer filter stage for oversampled sensor readings.
+ *
+ * Each call reduces a burst of oversampled readings to one value with a
+ * trimmed mean: the readings are sorted, the extremes are discarded and
+ * the middle window is averaged. A window of 1 is a pure median (best
+ * spike rejection), a window equal to the burst length is a plain average
+ * (best white-noise reduction). The result can then be smoothed across
+ * calls with an exponential moving average whose weight is a power of two.
+ *
+ * The filter is unit-agnostic and uses integer arithmetic only, so it runs
+ * on raw ADC counts or millivolts and can be benchmarked on the host.
+ */
+class SampleFilter {
+public:
+    /**
+     * @brief Constructor for SampleFilter.
+     * @param window Number of middle readings averaged per burst (1 = median).
+     * @param emaShift EMA weight of a new value is 1/2^emaShift (0 disables the EMA).
+     */
+    SampleFilter(size_t window, uint8_t emaShift);
+
+    /**
+     * @brief Constructs a pure median filter without EMA, e.g. for arrays assigned a configured filter later.
+     */
+    SampleFilter();
+
+    /**
+     * @brief Reduces one burst of readings to a single value with the trimmed mean.
+     * @param readings Oversampled readings; sorted in place.
+     * @param count Number of readings in the burst (must be greater than zero).
+     * @return Mean of the middle window, in the unit of the readings.
+     */
+    int32_t reduce(int32_t* readings, size_t count) const;
+
+    /**
+     * @brief Feeds a reduced value through the exponential moving average.
+     * @param value Reduced value of the latest burst.
+     * @return Smoothed value, or value itself if the EMA is disabled.
+     */
+    int32_t smooth(int32_t value);
+
+    /**
+     * @brief Clears the EMA state so the next value is taken as is.
+     */
+    void reset();
+
+    /**
+     * @brief Computes the mean of the middle window of sorted readings.
+     * @param readings Readings; sorted in place.
+     * @param count Number of readings.
+     * @param window Number of middle readings to average, clamped to count.
+     */
+    static int32_t trimmedMean(int32_t* readings, size_t count, size_t window);
+
+private:
+    size_t _window;         ///< Middle readings averaged per burst.
+    uint8_t _emaShift;      ///< EMA weight exponent, 0 when disabled.
+    int32_t _emaState;      ///< EMA accumulator, scaled by 2^_emaShift.
+    bool _emaValid;         ///< True once the accumulator holds a value.
+};
+
+#endif // SAMPLE_FILTER_H
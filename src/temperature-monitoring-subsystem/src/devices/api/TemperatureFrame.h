@@ -0,0 +1,32 @@
+#ifndef TEMPERATURE_FRAME_H
+#define TEMPERATURE_FRAME_H
+
+#include <stdint.h>
+#include "config/config.h"
+
+/**
+ * @struct TemperatureFrame
+ * @brief Readings of every temperature channel taken in one sampling pass.
+ *
+ * Fixed size: one entry per pin of TEMP_CHANNEL_PINS, in that order, as
+ * hundredths of a degree Celsius (the resolution of the calibration table).
+ */
+struct TemperatureFrame {
+    int16_t centiDegrees[TEMP_CHANNEL_COUNT];  ///< Temperature per channel in centi-degrees Celsius.
+
+    /**
+     * @brief Control temperature of the frame in Celsius.
+     * The warmest channel, or the mean of the channels with TEMP_CHANNEL_AGGREGATE_MAX 0.
+     */
+    float aggregate() const {
+        int32_t warmest = centiDegrees[0];
+        int32_t sum = 0;
+        for (int i = 0; i < TEMP_CHANNEL_COUNT; i++) {
+            if (centiDegrees[i] > warmest) warmest = centiDegrees[i];
+            sum += centiDegrees[i];
+        }
+        return TEMP_CHANNEL_AGGREGATE_MAX ? warmest / 100.0f : sum / (100.0f * TEMP_CHANNEL_COUNT);
+    }
+};
+
+#endif // TEMPERATURE_FRAME_H
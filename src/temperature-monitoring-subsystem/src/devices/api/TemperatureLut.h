@@ -0,0 +1,67 @@
+#ifndef TEMPERATURE_LUT_H
+#define TEMPERATURE_LUT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @class TemperatureLut
+ * @brief Lookup table from raw 12-bit ADC codes to centi-degrees Celsius.
+ *
+ * The table is generated once from a per-chip raw-to-millivolt conversion
+ * (the eFuse ADC calibration on the target) and the sensor's linear
+ * voltage/temperature characteristic. Afterwards a conversion is a single
+ * array access with no floating-point work. The generator does not depend
+ * on the Arduino framework, so it can be unit tested on the host.
+ */
+class TemperatureLut {
+public:
+    static const size_t RAW_LEVELS = 4096;                          ///< Codes of a 12-bit ADC.
+    static const size_t SIZE_BYTES = RAW_LEVELS * sizeof(int16_t);  ///< Size of the table data.
+
+    /**
+     * @brief Converts a raw ADC code to millivolts.
+     * @param raw Raw ADC code.
+     * @param context Calibration data passed to build().
+     */
+    typedef uint32_t (*MillivoltsFn)(uint32_t raw, const void* context);
+
+    /**
+     * @brief Constructor for TemperatureLut. The table is empty until built or loaded.
+     */
+    TemperatureLut();
+
+    /**
+     * @brief Generates the table.
+     * @param toMillivolts Calibrated raw-to-millivolt conversion.
+     * @param context Calibration data forwarded to toMillivolts.
+     * @param offsetMv Sensor output voltage at 0 °C.
+     * @param mvPerCelsius Sensor sensitivity in mV/°C.
+     */
+    void build(MillivoltsFn toMillivolts, const void* context, float offsetMv, float mvPerCelsius);
+
+    /**
+     * @brief Converts a raw ADC code. Codes above the table are clamped to the last entry.
+     * @return Temperature in hundredths of a degree Celsius.
+     */
+    int16_t toCentiDegrees(uint32_t raw) const {
+        return _table[raw < RAW_LEVELS ? raw : RAW_LEVELS - 1];
+    }
+
+    /**
+     * @brief Checks that the table never decreases, as any valid calibration must.
+     * Used to reject corrupted cached tables.
+     */
+    bool isMonotonic() const;
+
+    /**
+     * @brief Raw table storage, for loading from and saving to a cache.
+     */
+    int16_t* data() { return _table; }
+    const int16_t* data() const { return _table; }
+
+private:
+    int16_t _table[RAW_LEVELS];     ///< Centi-degrees per raw ADC code.
+};
+
+#endif // TEMPERATURE_LUT_H
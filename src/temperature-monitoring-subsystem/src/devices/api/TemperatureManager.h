@@ -1,12 +1,15 @@
 #ifndef TEMPERATURE_MANAGER_H
 #define TEMPERATURE_MANAGER_H
 
+#include "TemperatureFrame.h"
+
 /**
  * @class TemperatureManager
- * @brief Interface for reading temperature data from a sensor.
+ * @brief Interface for reading temperature data from a set of sensors.
  * 
- * Provides a contract for initializing a temperature sensor and reading
- * temperature values. Abstracts the underlying sensor hardware implementation.
+ * Provides a contract for initializing the temperature sensors and reading
+ * one frame of temperature values from all of them. Abstracts the
+ * underlying sensor hardware implementation.
  */
 class TemperatureManager {
 public:
@@ -22,10 +25,10 @@ public:
     virtual void setup() = 0;
 
     /**
-     * @brief Reads the current temperature from the sensor.
-     * @return The current temperature value in Celsius.
-     */      
-    virtual float readTemperature() = 0;
+     * @brief Reads the current temperature of every channel in one pass.
+     * @param frame Receives the temperature of each channel.
+     */
+    virtual void readFrame(TemperatureFrame& frame) = 0;
 };
 
 #endif // TEMPERATURE_MANAGER_H
\ No newline at end of file
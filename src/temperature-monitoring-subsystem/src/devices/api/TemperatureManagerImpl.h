@@ -2,23 +2,29 @@
 #define TEMPERATURE_MANAGER_IMPL_H
 
 #include "../api/TemperatureManager.h"
+#include "SampleFilter.h"
+#include "TemperatureLut.h"
 #include "config/config.h"
 
 /**
  * @class TemperatureManagerImpl
- * @brief Implements TemperatureManager for a TMP36 analog sensor.
+ * @brief Implements TemperatureManager for TMP36 analog sensors.
  * 
  * Handles GPIO pin setup and analog-to-digital conversion for temperature readings
- * from a TMP36 temperature sensor connected to an ESP32 analog input pin.
+ * from TMP36 temperature sensors connected to the ESP32 analog input pins of
+ * TEMP_CHANNEL_PINS. Each frame is a burst of TEMP_FILTER_OVERSAMPLES raw
+ * conversions per channel, interleaved across the channels so that all of
+ * them cover the same instant, without blocking delays. Every channel's
+ * burst is reduced by its own SampleFilter. The filtered codes are converted
+ * with one lookup table generated from the chip's eFuse ADC calibration and
+ * cached in NVS, so no floating-point conversion runs per reading.
  */
 class TemperatureManagerImpl : public TemperatureManager {
 public:
     /**
-     * @brief Constructor for TemperatureManagerImpl.
-     * @param sensorPin Analog GPIO pin connected to the TMP36 sensor's Vout. 
-     *                  Defaults to TEMP_SENSOR_PIN from config.
+     * @brief Constructor for TemperatureManagerImpl, reading the pins of TEMP_CHANNEL_PINS.
      */
-    TemperatureManagerImpl(int sensorPin = TEMP_SENSOR_PIN);
+    TemperatureManagerImpl();
 
     /**
      * @brief Virtual destructor.
@@ -26,10 +32,28 @@ public:
     virtual ~TemperatureManagerImpl() {}
 
     void setup() override;
-    float readTemperature() override;
+    void readFrame(TemperatureFrame& frame) override;
 
 private:
-    int _sensorPin;  ///< Analog GPIO pin connected to the temperature sensor.
+    int _sensorPins[TEMP_CHANNEL_COUNT];        ///< Analog GPIO pin of each channel.
+    SampleFilter _filters[TEMP_CHANNEL_COUNT];  ///< Oversampling, median and EMA stage of each channel.
+    TemperatureLut _lut;                        ///< Calibrated raw code to centi-degree table, shared by the channels.
+
+    /**
+     * @brief Reduces one channel's burst and converts it, keeping out-of-range values out of its average.
+     */
+    int16_t filterChannel(int channel, int32_t* readings);
+
+    /**
+     * @brief Loads the lookup table from NVS if it matches the calibration fingerprint.
+     * @return True if a valid cached table was loaded.
+     */
+    bool loadLut(uint32_t fingerprint);
+
+    /**
+     * @brief Stores the lookup table and its calibration fingerprint in NVS.
+     */
+    void saveLut(uint32_t fingerprint);
 };
 
 #endif // TEMPERATURE_MANAGER_IMPL_H
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "../api/LedPatternPlayer.h"
+
+LedPatternPlayer::LedPatternPlayer()
+    : _pattern(nullptr),
+      _next(nullptr),
+      _step(0) {}
+
+bool LedPatternPlayer::request(const LedPattern& pattern, bool preempt) {
+    if (_pattern == &pattern && !_next) {
+        return false;
+    }
+    if (!preempt && _pattern && !_pattern->repeat) {
+        // Let a boot flash finish; only the latest request follows it
+        _next = (_pattern == &pattern) ? nullptr : &pattern;
+        return false;
+    }
+
+    _pattern = &pattern;
+    _next = nullptr;
+    _step = 0;
+    return true;
+}
+
+void LedPatternPlayer::advance() {
+    if (!_pattern) {
+        return;
+    }
+    uint8_t run = runLength();
+    if (run == 0) {
+        return; // Steady, nothing to move past
+    }
+
+    _step += run;
+    if (_step < _pattern->stepCount) {
+        return;
+    }
+    if (_pattern->repeat) {
+        _step %= _pattern->stepCount;
+    } else {
+        _pattern = _next;
+        _next = nullptr;
+        _step = 0;
+    }
+}
+
+uint8_t LedPatternPlayer::levels() const {
+    return _pattern ? levelsAt(_step) : 0;
+}
+
+uint32_t LedPatternPlayer::holdMs() const {
+    return _pattern ? (uint32_t)runLength() * _pattern->stepMs : 0;
+}
+
+uint8_t LedPatternPlayer::runLength() const {
+    uint8_t levelsNow = levelsAt(_step);
+    uint8_t run = 1;
+
+    if (_pattern->repeat) {
+        // Wraps around: a pattern whose steps all match never changes
+        while (run < _pattern->stepCount && levelsAt((_step + run) % _pattern->stepCount) == levelsNow) {
+            run++;
+        }
+        return run == _pattern->stepCount ? 0 : run;
+    }
+
+    // A non-repeating pattern always ends, even if its levels never change
+    while (_step + run < _pattern->stepCount && levelsAt(_step + run) == levelsNow) {
+        run++;
+    }
+    return run;
+}
+
+uint8_t LedPatternPlayer::levelsAt(uint8_t step) const {
+    uint8_t levels = 0;
+    if (_pattern->greenSteps & (1UL << step)) levels |= LED_LEVEL_GREEN;
+    if (_pattern->redSteps & (1UL << step)) levels |= LED_LEVEL_RED;
+    return levels;
+}
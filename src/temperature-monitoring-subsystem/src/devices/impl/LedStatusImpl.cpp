@@ -1,51 +1,123 @@
 #include "../api/LedStatusImpl.h"
+#include "../../kernel/api/Log.h"
 #include <Arduino.h>
 
+namespace {
+
+// Blink codes: one red blink per period while WiFi connects, two while MQTT connects
+const LedPattern BOOT_PATTERN = {LED_BOOT_FLASH_MS, 1, 0x1, 0x1, false};
+const LedPattern OPERATIONAL_PATTERN = {LED_BLINK_STEP_MS, 1, 0x1, 0x0, true};
+const LedPattern NETWORK_ERROR_PATTERN = {LED_BLINK_STEP_MS, 1, 0x0, 0x1, true};
+const LedPattern WIFI_CONNECTING_PATTERN = {LED_BLINK_STEP_MS, LED_BLINK_PERIOD_STEPS, 0x0, 0x1, true};
+const LedPattern MQTT_CONNECTING_PATTERN = {LED_BLINK_STEP_MS, LED_BLINK_PERIOD_STEPS, 0x0, 0x5, true};
+const LedPattern OFF_PATTERN = {LED_BLINK_STEP_MS, 1, 0x0, 0x0, true};
+
+static_assert(LED_BLINK_PERIOD_STEPS >= 4 && LED_BLINK_PERIOD_STEPS <= 32,
+              "LED_BLINK_PERIOD_STEPS must fit the blink codes and a 32-bit step mask");
+
+} // namespace
+
 LedStatusImpl::LedStatusImpl(int greenLedPin, int redLedPin)
-    : _greenLedPin(greenLedPin), _redLedPin(redLedPin) {
-    // Constructor initializes pin member variables.
+    : _greenLedPin(greenLedPin),
+      _redLedPin(redLedPin),
+      _levels(0),
+      _changeDueUs(INT64_MAX),
+      _timer(nullptr),
+      _lock(portMUX_INITIALIZER_UNLOCKED) {
     // Actual hardware pin configuration is performed in setup().
 }
 
 void LedStatusImpl::setup() {
     pinMode(_greenLedPin, OUTPUT);
     pinMode(_redLedPin, OUTPUT);
-    turnLedsOff(); // Set initial state: LEDs off
+    digitalWrite(_greenLedPin, LOW);
+    digitalWrite(_redLedPin, LOW);
+
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = timerCallback;
+    timerArgs.arg = this;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "led";
+    if (esp_timer_create(&timerArgs, &_timer) != ESP_OK) {
+        _timer = nullptr;
+        LOG_ERROR("LED: Failed to create pattern timer, blink codes shown as steady");
+    }
+
+    show(OFF_PATTERN, true);
 }
 
 void LedStatusImpl::turnLedsOff() {
-    digitalWrite(_greenLedPin, LOW);
-    digitalWrite(_redLedPin, LOW);
+    // Immediate, even during the boot flash: called right before deep sleep
+    show(OFF_PATTERN, true);
 }
 
 void LedStatusImpl::indicateSystemBoot() {
-    // Brief flash of both LEDs to indicate system startup
-    digitalWrite(_greenLedPin, HIGH);
-    digitalWrite(_redLedPin, HIGH);
-    delay(250);
-    turnLedsOff();
+    // Brief flash of both LEDs, played in the background; the next indication follows it
+    show(BOOT_PATTERN, true);
 }
 
 void LedStatusImpl::indicateOperational() {
     // Green LED on, Red LED off: system operating normally
-    digitalWrite(_greenLedPin, HIGH);
-    digitalWrite(_redLedPin, LOW);
+    show(OPERATIONAL_PATTERN);
 }
 
 void LedStatusImpl::indicateNetworkError() {
     // Red LED on, Green LED off: network or critical error
-    digitalWrite(_greenLedPin, LOW);
-    digitalWrite(_redLedPin, HIGH);
+    show(NETWORK_ERROR_PATTERN);
 }
 
 void LedStatusImpl::indicateWifiConnecting() {
-    // Red LED on while attempting WiFi connection
-    digitalWrite(_greenLedPin, LOW);
-    digitalWrite(_redLedPin, HIGH);
+    show(WIFI_CONNECTING_PATTERN);
 }
 
 void LedStatusImpl::indicateMqttConnecting() {
-    // Red LED on while attempting MQTT connection
-    digitalWrite(_greenLedPin, LOW);
-    digitalWrite(_redLedPin, HIGH);
-}
\ No newline at end of file
+    show(MQTT_CONNECTING_PATTERN);
+}
+
+void LedStatusImpl::show(const LedPattern& pattern, bool preempt) {
+    // The FSM repeats its indication every cycle: only a new pattern reaches the pins
+    if (_player.current() == &pattern && !preempt) {
+        return;
+    }
+
+    portENTER_CRITICAL(&_lock);
+    if (_player.request(pattern, preempt)) {
+        applyLocked();
+    }
+    portEXIT_CRITICAL(&_lock);
+}
+
+void LedStatusImpl::applyLocked() {
+    uint8_t levels = _player.levels();
+    uint8_t changed = levels ^ _levels;
+    if (changed & LED_LEVEL_GREEN) {
+        digitalWrite(_greenLedPin, (levels & LED_LEVEL_GREEN) ? HIGH : LOW);
+    }
+    if (changed & LED_LEVEL_RED) {
+        digitalWrite(_redLedPin, (levels & LED_LEVEL_RED) ? HIGH : LOW);
+    }
+    _levels = levels;
+
+    // A callback already waiting on the lock finds the deadline moved and ignores itself
+    uint32_t holdMs = _player.holdMs();
+    _changeDueUs = holdMs ? esp_timer_get_time() + (int64_t)holdMs * 1000 : INT64_MAX;
+    if (_timer) {
+        esp_timer_stop(_timer);
+        if (holdMs) {
+            esp_timer_start_once(_timer, (uint64_t)holdMs * 1000ULL);
+        }
+    }
+}
+
+void LedStatusImpl::timerCallback(void* param) {
+    static_cast<LedStatusImpl*>(param)->onTimer();
+}
+
+void LedStatusImpl::onTimer() {
+    portENTER_CRITICAL(&_lock);
+    if (esp_timer_get_time() >= _changeDueUs) {
+        _player.advance();
+        applyLocked();
+    }
+    portEXIT_CRITICAL(&_lock);
+}
@@ -0,0 +1,67 @@
+#include "../api/SampleFilter.h"
+
+namespace {
+
+/** @brief Division rounded to the nearest integer, symmetric for negative values. */
+int32_t roundedDivide(int32_t value, int32_t divisor) {
+    int32_t half = divisor / 2;
+    return (value >= 0 ? value + half : value - half) / divisor;
+}
+
+} // namespace
+
+SampleFilter::SampleFilter(size_t window, uint8_t emaShift)
+    : _window(window),
+      _emaShift(emaShift),
+      _emaState(0),
+      _emaValid(false) {}
+
+SampleFilter::SampleFilter()
+    : SampleFilter(1, 0) {}
+
+void SampleFilter::reset() {
+    _emaValid = false;
+}
+
+int32_t SampleFilter::trimmedMean(int32_t* readings, size_t count, size_t window) {
+    // Insertion sort: bursts are short and usually nearly sorted already
+    for (size_t i = 1; i < count; i++) {
+        int32_t value = readings[i];
+        size_t j = i;
+        while (j > 0 && readings[j - 1] > value) {
+            readings[j] = readings[j - 1];
+            j--;
+        }
+        readings[j] = value;
+    }
+
+    if (window == 0 || window > count) {
+        window = count;
+    }
+    size_t first = (count - window) / 2;
+
+    int32_t sum = 0;
+    for (size_t i = first; i < first + window; i++) {
+        sum += readings[i];
+    }
+    return roundedDivide(sum, (int32_t)window);
+}
+
+int32_t SampleFilter::reduce(int32_t* readings, size_t count) const {
+    return trimmedMean(readings, count, _window);
+}
+
+int32_t SampleFilter::smooth(int32_t value) {
+    if (_emaShift == 0) {
+        return value;
+    }
+
+    if (!_emaValid) {
+        _emaState = value * (1 << _emaShift);
+        _emaValid = true;
+    } else {
+        // state = state * (1 - 1/2^s) + value, kept scaled by 2^s to avoid losing precision
+        _emaState += value - _emaState / (1 << _emaShift);
+    }
+    return roundedDivide(_emaState, 1 << _emaShift);
+}
@@ -0,0 +1,31 @@
+#include "../api/TemperatureLut.h"
+#include <math.h>
+#include <string.h>
+
+TemperatureLut::TemperatureLut() {
+    memset(_table, 0, sizeof(_table));
+}
+
+void TemperatureLut::build(MillivoltsFn toMillivolts, const void* context, float offsetMv, float mvPerCelsius) {
+    for (uint32_t raw = 0; raw < RAW_LEVELS; raw++) {
+        float millivolts = (float)toMillivolts(raw, context);
+        float centiDegrees = (millivolts - offsetMv) * 100.0f / mvPerCelsius;
+
+        // Saturate instead of wrapping for voltages outside the int16 range
+        if (centiDegrees > 32767.0f) {
+            centiDegrees = 32767.0f;
+        } else if (centiDegrees < -32768.0f) {
+            centiDegrees = -32768.0f;
+        }
+        _table[raw] = (int16_t)lroundf(centiDegrees);
+    }
+}
+
+bool TemperatureLut::isMonotonic() const {
+    for (size_t raw = 1; raw < RAW_LEVELS; raw++) {
+        if (_table[raw] < _table[raw - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -1,37 +1,153 @@
 #include "../api/TemperatureManagerImpl.h"
+#include "../../kernel/api/Log.h"
 #include <Arduino.h>
+#include <Preferences.h>
+#include <esp_adc_cal.h>
 
-TemperatureManagerImpl::TemperatureManagerImpl(int sensorPin) : _sensorPin(sensorPin) {
-    // Constructor initializes the sensor pin.
+namespace {
+
+/** @brief NVS keys of the cached table and of the calibration it was built from. */
+const char* LUT_KEY = "lut";
+const char* FINGERPRINT_KEY = "fp";
+
+/** @brief Bump whenever the table format or generator changes, to invalidate cached tables. */
+const uint32_t LUT_FORMAT_VERSION = 1;
+
+const int CHANNEL_PINS[] = TEMP_CHANNEL_PINS;
+static_assert(sizeof(CHANNEL_PINS) / sizeof(CHANNEL_PINS[0]) == TEMP_CHANNEL_COUNT,
+              "TEMP_CHANNEL_PINS must list TEMP_CHANNEL_COUNT pins");
+// One calibration table is shared, so every channel must be on ADC1 (10 channels on the ESP32-S3)
+static_assert(TEMP_CHANNEL_COUNT >= 1 && TEMP_CHANNEL_COUNT <= 10, "TEMP_CHANNEL_COUNT must be 1 to 10");
+
+uint32_t calibratedMillivolts(uint32_t raw, const void* context) {
+    return esp_adc_cal_raw_to_voltage(raw, static_cast<const esp_adc_cal_characteristics_t*>(context));
+}
+
+/**
+ * @brief 32-bit FNV-1a hash over a block of memory.
+ */
+uint32_t hashBytes(uint32_t hash, const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Identifies the inputs of the table: calibration coefficients and sensor constants.
+ */
+uint32_t calibrationFingerprint(const esp_adc_cal_characteristics_t& chars, esp_adc_cal_value_t source) {
+    const float offsetMv = TMP36_OFFSET_MV;
+    const float mvPerCelsius = TMP36_MV_PER_CELSIUS;
+
+    uint32_t hash = 2166136261u;
+    hash = hashBytes(hash, &LUT_FORMAT_VERSION, sizeof(LUT_FORMAT_VERSION));
+    hash = hashBytes(hash, &source, sizeof(source));
+    hash = hashBytes(hash, &chars.atten, sizeof(chars.atten));
+    hash = hashBytes(hash, &chars.bit_width, sizeof(chars.bit_width));
+    hash = hashBytes(hash, &chars.coeff_a, sizeof(chars.coeff_a));
+    hash = hashBytes(hash, &chars.coeff_b, sizeof(chars.coeff_b));
+    hash = hashBytes(hash, &chars.vref, sizeof(chars.vref));
+    hash = hashBytes(hash, &offsetMv, sizeof(offsetMv));
+    hash = hashBytes(hash, &mvPerCelsius, sizeof(mvPerCelsius));
+    return hash;
+}
+
+} // namespace
+
+TemperatureManagerImpl::TemperatureManagerImpl() {
+    // Constructor initializes the sensor pins.
     // Hardware pin configuration is performed in setup().
+    for (int channel = 0; channel < TEMP_CHANNEL_COUNT; channel++) {
+        _sensorPins[channel] = CHANNEL_PINS[channel];
+        _filters[channel] = SampleFilter(TEMP_FILTER_MEDIAN_WINDOW, TEMP_FILTER_EMA_SHIFT);
+    }
 }
 
 void TemperatureManagerImpl::setup() {
-    pinMode(_sensorPin, INPUT);
-}
-
-float TemperatureManagerImpl::readTemperature() {
-    // Read raw value from ESP32 ADC
-    int sensorValue = analogRead(_sensorPin);
-    
-    // Convert ADC value to voltage
-    float voltage = (float)sensorValue / ESP32_ADC_RESOLUTION * ESP32_ADC_VREF;
-    
-    // Convert voltage to Celsius according to TMP36 specifications
-    // Formula: Temperature(°C) = (Voltage(mV) - Offset) / Sensitivity
-    // TMP36: 10mV/°C sensitivity with 500mV offset at 0°C
-    float voltageMillivolts = voltage * 1000.0f; // Convert to mV
-    float temperatureC = (voltageMillivolts - TMP36_OFFSET_MV) / TMP36_MV_PER_CELSIUS;
-    
+    analogReadResolution(12);
+    for (int channel = 0; channel < TEMP_CHANNEL_COUNT; channel++) {
+        pinMode(_sensorPins[channel], INPUT);
+        analogSetPinAttenuation(_sensorPins[channel], ADC_11db); // Must match the characterization below
+    }
+
+    // The sensor pins are on ADC1, which stays usable while WiFi is active
+    esp_adc_cal_characteristics_t chars;
+    esp_adc_cal_value_t source = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12,
+                                                          ADC_DEFAULT_VREF_MV, &chars);
+    if (source == ESP_ADC_CAL_VAL_DEFAULT_VREF) {
+        LOG_WARN("Temperature Manager: No eFuse ADC calibration, using default Vref");
+    }
+
+    uint32_t fingerprint = calibrationFingerprint(chars, source);
+    if (loadLut(fingerprint)) {
+        LOG_INFO("Temperature Manager: Calibration table loaded from NVS");
+        return;
+    }
+
+    _lut.build(calibratedMillivolts, &chars, TMP36_OFFSET_MV, TMP36_MV_PER_CELSIUS);
+    saveLut(fingerprint);
+    LOG_INFO("Temperature Manager: Calibration table generated");
+}
+
+bool TemperatureManagerImpl::loadLut(uint32_t fingerprint) {
+    Preferences preferences;
+    if (!preferences.begin(ADC_CAL_NVS_NAMESPACE, true)) {
+        return false; // Namespace does not exist yet
+    }
+
+    bool loaded = preferences.getUInt(FINGERPRINT_KEY, 0) == fingerprint &&
+                  preferences.getBytesLength(LUT_KEY) == TemperatureLut::SIZE_BYTES &&
+                  preferences.getBytes(LUT_KEY, _lut.data(), TemperatureLut::SIZE_BYTES) == TemperatureLut::SIZE_BYTES;
+    preferences.end();
+
+    return loaded && _lut.isMonotonic();
+}
+
+void TemperatureManagerImpl::saveLut(uint32_t fingerprint) {
+    Preferences preferences;
+    if (!preferences.begin(ADC_CAL_NVS_NAMESPACE, false)) {
+        LOG_WARN("Temperature Manager: Cannot open NVS, calibration table not cached");
+        return;
+    }
+    // Fingerprint last: a power loss mid-write leaves no fingerprint rather than a half-written table
+    preferences.remove(FINGERPRINT_KEY);
+    preferences.putBytes(LUT_KEY, _lut.data(), TemperatureLut::SIZE_BYTES);
+    preferences.putUInt(FINGERPRINT_KEY, fingerprint);
+    preferences.end();
+}
+
+void TemperatureManagerImpl::readFrame(TemperatureFrame& frame) {
+    // Oversample back-to-back: each conversion takes tens of microseconds,
+    // so the whole burst is far shorter than the old blocking re-read delay.
+    // Scanning the channels round-robin spreads every channel's burst over the
+    // same interval. (The DMA continuous mode of the ADC needs the 3.x Arduino
+    // core; this build uses the 2.x one-shot driver and esp_adc_cal.)
+    int32_t readings[TEMP_CHANNEL_COUNT][TEMP_FILTER_OVERSAMPLES];
+    for (size_t i = 0; i < TEMP_FILTER_OVERSAMPLES; i++) {
+        for (int channel = 0; channel < TEMP_CHANNEL_COUNT; channel++) {
+            readings[channel][i] = analogRead(_sensorPins[channel]);
+        }
+    }
+
+    for (int channel = 0; channel < TEMP_CHANNEL_COUNT; channel++) {
+        frame.centiDegrees[channel] = filterChannel(channel, readings[channel]);
+    }
+}
+
+int16_t TemperatureManagerImpl::filterChannel(int channel, int32_t* readings) {
+    // The trimmed mean discards spikes; the window average reduces white noise
+    int32_t burstRaw = _filters[channel].reduce(readings, TEMP_FILTER_OVERSAMPLES);
+    int16_t centiDegrees = _lut.toCentiDegrees(burstRaw);
+
     // Filter for anomalous values - validate against expected indoor range
-    if (temperatureC < TEMP_MIN_VALID || temperatureC > TEMP_MAX_VALID) {
-        // Re-read once if value seems out of range
-        delay(TEMP_REREAD_DELAY_MS);
-        sensorValue = analogRead(_sensorPin);
-        voltage = (float)sensorValue / ESP32_ADC_RESOLUTION * ESP32_ADC_VREF;
-        voltageMillivolts = voltage * 1000.0f;
-        temperatureC = (voltageMillivolts - TMP36_OFFSET_MV) / TMP36_MV_PER_CELSIUS;
-    }
-    
-    return temperatureC;
-}
\ No newline at end of file
+    if (centiDegrees < (int16_t)(TEMP_MIN_VALID * 100) || centiDegrees > (int16_t)(TEMP_MAX_VALID * 100)) {
+        // Report the anomaly as is, but keep it out of the moving average
+        LOG_WARN("Temperature Manager: Channel %d reading out of range: %.2f", channel, centiDegrees / 100.0f);
+        return centiDegrees;
+    }
+
+    return _lut.toCentiDegrees(_filters[channel].smooth(burstRaw));
+}
@@ -0,0 +1,19 @@
+#ifndef CHIP_ID_H
+#define CHIP_ID_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/**
+ * @brief Device-unique 24-bit ID taken from the factory MAC in eFuse.
+ * Used in the MQTT client ID and to seed the reconnect jitter.
+ */
+inline uint32_t chipId() {
+    uint32_t id = 0;
+    for (int i = 0; i < 17; i = i + 8) {
+        id |= ((ESP.getEfuseMac() >> (40 - i)) & 0xff) << i;
+    }
+    return id;
+}
+
+#endif // CHIP_ID_H
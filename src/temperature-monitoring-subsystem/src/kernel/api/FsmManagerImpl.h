@@ -2,8 +2,16 @@
 #define FSM_MANAGER_IMPL_H
 
 #include "IFsmManager.h"
+#include "TemperatureSample.h"
+#include "SampleRingBuffer.h"
+#include "SampleStore.h"
+#include "SampleSource.h"
+#include "SamplingPolicy.h"
+#include "WindowStatistics.h"
+#include "LoopProfiler.h"
+#include "PowerManager.h"
+#include "ReconnectBackoff.h"
 #include "../../devices/api/LedStatus.h"
-#include "../../devices/api/TemperatureManager.h"
 #include "../connection/api/WifiManager.h"
 #include "../connection/api/MqttManager.h"
 #include "../../config/config.h"
@@ -21,11 +29,15 @@ public:
     /**
      * @brief Constructor for FsmManagerImpl.
      * @param ledCtrl Reference to LED status controller for visual feedback.
-     * @param tempCtrl Reference to temperature manager for sensor readings.
+     * @param source Reference to the sample source that schedules sensor readings.
      * @param wifiCtrl Reference to WiFi manager for network connectivity.
      * @param mqttCtrl Reference to MQTT manager for broker communication.
+     * @param store Reference to the queue holding samples taken during network outages.
+     * @param profiler Loop timing histograms to publish periodically, or nullptr without profiling.
+     * @param power Deep sleep control to duty-cycle between samples, or nullptr to stay awake.
      */
-    FsmManagerImpl(LedStatus& ledCtrl, TemperatureManager& tempCtrl, WifiManager& wifiCtrl, MqttManager& mqttCtrl);
+    FsmManagerImpl(LedStatus& ledCtrl, SampleSource& source, WifiManager& wifiCtrl, MqttManager& mqttCtrl,
+                   SampleStore& store, LoopProfiler* profiler = nullptr, PowerManager* power = nullptr);
 
     /**
      * @brief Virtual destructor.
@@ -34,6 +46,7 @@ public:
 
     void setup() override;
     void run() override;
+    unsigned long getNextDeadline(unsigned long currentTime) const override;
     SystemState getCurrentState() const override;
     float getCurrentTemperature() const override;
     unsigned long getCurrentSamplingInterval() const override;
@@ -41,32 +54,145 @@ public:
 private:
     // References to managed components
     LedStatus& ledController;                   ///< Controls LED visual feedback.
-    TemperatureManager& tempController;         ///< Manages temperature sensor readings.
+    SampleSource& sampleSource;                 ///< Schedules and delivers temperature samples.
     WifiManager& wifiController;                ///< Handles WiFi connectivity.
     MqttManager& mqttController;                ///< Manages MQTT communication.
+    SampleStore& sampleStore;                   ///< Queues samples taken while offline.
+    LoopProfiler* loopProfiler;                 ///< Loop timing histograms, nullptr without profiling.
+    PowerManager* powerManager;                 ///< Deep sleep control, nullptr to stay awake.
 
     // Internal state and timing variables
     SystemState _currentState;                  ///< Current FSM state.
-    unsigned long _lastTempSampleTime;          ///< Timestamp of last temperature sample.
     unsigned long _lastMqttAttemptTime;         ///< Timestamp of last MQTT connection attempt.
     unsigned long _lastWiFiAttemptTime;         ///< Timestamp of last WiFi connection attempt.
-    float _currentTemperature;                  ///< Last measured temperature value.
+    unsigned long _connectStartTime;            ///< Timestamp at which the current connection sequence started.
+    unsigned long _bootToOperationalMs;         ///< Time from boot to the first STATE_OPERATIONAL entry.
+    unsigned long _connectToOperationalMs;      ///< Duration of the last connection sequence.
+    ReconnectBackoff _wifiBackoff;              ///< Wait in STATE_WAIT_RECONNECT after each network error.
+    ReconnectBackoff _mqttBackoff;              ///< Wait between failed MQTT attempts.
+    unsigned long _reconnectFailures;           ///< Failed attempts before the last STATE_OPERATIONAL entry.
+    unsigned long _reconnectBackoffMs;          ///< Longest single backoff wait of the outage before the last STATE_OPERATIONAL entry.
+    unsigned long _lastBacklogDrainTime;        ///< Timestamp of last backlog publish.
+    unsigned long _lastStatusReportTime;        ///< Timestamp of last status report.
+    unsigned long _lastLoopMetricsTime;         ///< Timestamp of last loop metrics report attempt.
+    unsigned long _loopMetricsWindowStart;      ///< Timestamp at which the loop histograms were last reset.
+    TemperatureSample _lastSample;              ///< Most recent sample with its timestamp and sequence number.
     unsigned long _currentSamplingIntervalMs;  ///< Current sampling interval in milliseconds.
+    SamplingPolicy _samplingPolicy;             ///< Threshold-to-interval policy, bandCount 0 until received.
+    bool _intervalOverridden;                   ///< True while the backend forces the sampling interval.
+    unsigned long _operationalSinceTime;        ///< Timestamp of the last STATE_OPERATIONAL entry from MQTT_CONNECTING.
+    bool _publishedSinceWake;                   ///< True once a sample was published since boot or wake-up.
+    DutyCycleState _dutyCycle;                  ///< Deep sleep counters, restored after each wake-up.
+    bool _hasReportedSample;                    ///< False until a live sample was published on this connection.
+    TemperatureSample _lastReportedSample;      ///< Last live sample published, the deadband reference.
+    uint32_t _suppressedSinceReport;            ///< Samples held back by the deadband since _lastReportedSample.
+    unsigned long _suppressedSamples;           ///< Samples held back by the deadband since boot.
+    WindowStatistics _statistics;               ///< Every sample taken since the last published summary, on dutyCycleTime().
+
+    SampleRingBuffer<TemperatureSample, TELEMETRY_BATCH_MAX_SAMPLES> _sampleBatch; ///< Samples awaiting a batch publish.
 
     // Private methods for state-specific logic
     void handleInitializingState();
+    void handleWiFiConnectingState(unsigned long currentTime);
     void handleWiFiConnectedState();
     void handleMqttConnectingState(unsigned long currentTime);
     void handleOperationalState(unsigned long currentTime);
     void handleSamplingTemperatureState(unsigned long currentTime);
-    void handleSendingDataState();
+    void handleSendingDataState(unsigned long currentTime);
     void handleNetworkErrorState(unsigned long currentTime);
     void handleWaitReconnectState(unsigned long currentTime);
 
     /**
-     * @brief Checks for and applies new sampling interval from MQTT.
+     * @brief Publishes the "online" status with connection timing and diagnostic metrics.
+     * @param currentTime Current system time in milliseconds.
+     */
+    void publishStatusReport(unsigned long currentTime);
+
+    /**
+     * @brief Publishes the loop timing histograms and starts a new window once accepted.
+     * @param currentTime Current system time in milliseconds.
+     */
+    void publishLoopMetrics(unsigned long currentTime);
+
+    /**
+     * @brief Converts a millis() time of this wake to the clock that keeps running across deep sleep.
+     *
+     * Counts from the cold boot; equal to millis() on a device that never sleeps.
+     * @param currentTime Time in milliseconds since this boot or wake-up.
+     */
+    unsigned long dutyCycleTime(unsigned long currentTime) const;
+
+    /**
+     * @brief Adds a sample to the statistics window, stamped with dutyCycleTime().
+     * @param sample The sample just taken, published or not.
+     */
+    void recordStatistics(const TemperatureSample& sample);
+
+    /**
+     * @brief Publishes the statistics summary once its window is over and starts a new window.
+     * @param currentTime Current system time in milliseconds.
+     */
+    void publishStatisticsIfDue(unsigned long currentTime);
+
+    /**
+     * @brief Publishes the buffered batch if it is full or its oldest sample is too old.
+     * @param currentTime Current system time in milliseconds.
+     */
+    void flushSampleBatchIfDue(unsigned long currentTime);
+
+    /**
+     * @brief Takes a sample into the store-and-forward queue if one is due.
+     * Called in every state where samples cannot be published.
+     * @param currentTime Current system time in milliseconds.
+     */
+    void sampleOfflineIfDue(unsigned long currentTime);
+
+    /**
+     * @brief Publishes the next chunk of queued samples, rate-limited.
+     * @param currentTime Current system time in milliseconds.
+     */
+    void drainBacklogIfDue(unsigned long currentTime);
+
+    /**
+     * @brief Decides whether a live sample is worth publishing (report by exception).
+     *
+     * A sample is published if it is the first on this connection, moved by at least
+     * PUBLISH_DEADBAND_C or into another policy band since the last published sample,
+     * or if PUBLISH_HEARTBEAT_MS passed since then.
+     *
+     * @param sample The sample just taken.
+     * @return True to publish, false to count it as suppressed.
+     */
+    bool isReportable(const TemperatureSample& sample) const;
+
+    /**
+     * @brief Records the wake-to-publish time on the first sample published since waking.
+     * @param currentTime Current system time in milliseconds (millis() restarts on wake-up).
+     */
+    void recordWakeToPublish(unsigned long currentTime);
+
+    /**
+     * @brief Deep sleeps until the next sample if duty cycling and nothing else is pending.
+     * @param currentTime Current system time in milliseconds.
+     */
+    void deepSleepIfIdle(unsigned long currentTime);
+
+    /**
+     * @brief Checks for and applies a new sampling policy or interval override from MQTT.
      */
     void checkAndUpdateSamplingInterval();
+
+    /**
+     * @brief Switches to the interval of the policy band of a fresh sample,
+     * unless the backend overrides the interval.
+     * @param temperature Temperature of the sample just taken.
+     */
+    void applySamplingPolicy(float temperature);
+
+    /**
+     * @brief Changes the sampling interval of the FSM and of the sample source.
+     */
+    void setSamplingInterval(unsigned long intervalMs);
 };
 
 #endif // FSM_MANAGER_IMPL_H
\ No newline at end of file
@@ -65,6 +65,18 @@ public:
      */
     virtual void run() = 0;
 
+    /**
+     * @brief Gets the time by which run() next has work to do.
+     *
+     * Covers timed work (next sample, reconnect attempt, periodic reports)
+     * and, while connected, the polling of events that raise no notification
+     * such as incoming MQTT messages. The caller may sleep until then.
+     *
+     * @param currentTime Current system time in milliseconds.
+     * @return Deadline in millis() time; currentTime if run() should be called again immediately.
+     */
+    virtual unsigned long getNextDeadline(unsigned long currentTime) const = 0;
+
     /**
      * @brief Gets the current operational state of the FSM.
      * @return The current SystemState.
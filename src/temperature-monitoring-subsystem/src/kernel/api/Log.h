@@ -0,0 +1,186 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+#include "../../config/config.h"
+
+/** @brief Log levels, compared against LOG_LEVEL at compile time. */
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+/** @brief Maximum number of arguments of one log message. */
+#define LOG_MAX_ARGS 4
+
+/*
+ * Logging macros. The format is a printf-style string literal; arguments are
+ * integers, floats or strings that outlive the drain (literals or long-lived
+ * buffers), since only the pointer is stored. Messages above LOG_LEVEL expand
+ * to nothing: neither the call nor the argument expressions are compiled.
+ */
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) Log::write(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) Log::write(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) Log::write(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Log::write(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do {} while (0)
+#endif
+
+/** @brief Type tags of the arguments stored in a LogRecord. */
+enum LogArgType : uint8_t {
+    LOG_ARG_INT,
+    LOG_ARG_UINT,
+    LOG_ARG_FLOAT,
+    LOG_ARG_STRING
+};
+
+/**
+ * @union LogArg
+ * @brief One argument of a log message, interpreted according to its LogArgType.
+ */
+union LogArg {
+    int32_t i;
+    uint32_t u;
+    float f;
+    const char* s;
+};
+
+/**
+ * @struct LogRecord
+ * @brief Binary log message: the format string pointer identifies the message,
+ * the arguments are stored unformatted.
+ */
+struct LogRecord {
+    const char* format;                 ///< printf-style format literal, also the message id.
+    uint32_t timestampMs;               ///< millis() when the message was logged.
+    uint8_t level;                      ///< LOG_LEVEL_ERROR .. LOG_LEVEL_DEBUG.
+    uint8_t argCount;                   ///< Number of valid entries in args.
+    uint8_t argTypes[LOG_MAX_ARGS];     ///< LogArgType of each argument.
+    LogArg args[LOG_MAX_ARGS];          ///< Argument values.
+};
+
+/**
+ * @class Log
+ * @brief Deferred logging: messages are queued as binary records and written
+ * to Serial from the main loop, only as fast as the UART accepts them.
+ *
+ * Logging never blocks and never formats on the calling path, so the FSM's
+ * timing does not depend on whether a serial monitor drains the port.
+ * Messages logged while the buffer is full are dropped and counted.
+ * write() may be called from any task; drain() from the loop task only.
+ */
+class Log {
+public:
+    /**
+     * @brief Queues a message. Use the LOG_* macros instead of calling this directly.
+     * @param level Severity of the message.
+     * @param format printf-style format literal.
+     * @param args Up to LOG_MAX_ARGS integer, float or string arguments.
+     */
+    template <typename... Args>
+    static void write(uint8_t level, const char* format, Args... args) {
+        static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "Too many log arguments, see LOG_MAX_ARGS");
+        LogRecord record;
+        record.format = format;
+        record.level = level;
+        record.argCount = sizeof...(Args);
+        encodeArgs(record, 0, args...);
+        push(record);
+    }
+
+    /**
+     * @brief Writes queued messages to Serial without blocking.
+     *
+     * Stops as soon as the UART transmit buffer is full (the rest of a line is
+     * kept for the next call) or after LOG_DRAIN_MAX_RECORDS messages.
+     */
+    static void drain();
+
+    /**
+     * @brief Writes all queued messages to Serial, blocking until done. For setup() only.
+     */
+    static void flush();
+
+    /**
+     * @brief Removes the oldest queued message.
+     * @param out Receives the message.
+     * @return True if a message was removed, false if the buffer was empty.
+     */
+    static bool pop(LogRecord& out);
+
+    /**
+     * @brief Formats a message as "[timestamp] L message\r\n".
+     * @param record The message to format.
+     * @param out Destination buffer.
+     * @param size Size of the destination buffer; longer lines are truncated.
+     * @return Length of the formatted line, excluding the terminator.
+     */
+    static size_t format(const LogRecord& record, char* out, size_t size);
+
+    /**
+     * @brief Number of messages dropped because the buffer was full.
+     */
+    static unsigned long getDroppedCount();
+
+    /**
+     * @brief Discards queued messages and the drop counter (for tests).
+     */
+    static void clear();
+
+private:
+    static void push(LogRecord& record);
+
+    static void encodeArgs(LogRecord&, uint8_t) {}
+
+    template <typename T, typename... Rest>
+    static void encodeArgs(LogRecord& record, uint8_t index, T first, Rest... rest) {
+        encodeArg(record.args[index], record.argTypes[index], first);
+        encodeArgs(record, index + 1, rest...);
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+    encodeArg(LogArg& arg, uint8_t& type, T value) {
+        arg.i = (int32_t)value;
+        type = LOG_ARG_INT;
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+    encodeArg(LogArg& arg, uint8_t& type, T value) {
+        arg.u = (uint32_t)value;
+        type = LOG_ARG_UINT;
+    }
+
+    static void encodeArg(LogArg& arg, uint8_t& type, double value) {
+        arg.f = (float)value;
+        type = LOG_ARG_FLOAT;
+    }
+
+    static void encodeArg(LogArg& arg, uint8_t& type, const char* value) {
+        arg.s = value;
+        type = LOG_ARG_STRING;
+    }
+};
+
+#endif // LOG_H
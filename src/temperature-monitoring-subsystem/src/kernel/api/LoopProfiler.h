@@ -0,0 +1,105 @@
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "IFsmManager.h"
+
+/** @brief Profiler slot timing MqttManager::loop(); the slots below it are SystemState values timing FsmManager::run(). */
+const uint8_t LOOP_PROFILE_SLOT_MQTT_LOOP = STATE_WAIT_RECONNECT + 1;
+/** @brief Profiler slot holding, per received config message, the idle wait it arrived in (its worst-case wake-up latency). */
+const uint8_t LOOP_PROFILE_SLOT_CONFIG_WAKE = LOOP_PROFILE_SLOT_MQTT_LOOP + 1;
+/** @brief Number of profiler slots. */
+const uint8_t LOOP_PROFILE_SLOT_COUNT = LOOP_PROFILE_SLOT_CONFIG_WAKE + 1;
+
+/**
+ * @struct LatencySummary
+ * @brief Latency figures of one profiler slot, in microseconds.
+ *
+ * Percentiles are the upper bound of the power-of-two bucket they fall in
+ * (capped at the maximum), so they overestimate by less than a factor 2.
+ */
+struct LatencySummary {
+    uint32_t count;     ///< Number of recorded durations.
+    uint32_t minUs;     ///< Shortest duration.
+    uint32_t p50Us;     ///< Median duration.
+    uint32_t p99Us;     ///< 99th percentile duration.
+    uint32_t maxUs;     ///< Longest duration.
+};
+
+/**
+ * @class LoopProfiler
+ * @brief Log-bucketed latency histograms of the main loop, one per slot.
+ *
+ * Recording is a count-leading-zeros and four memory updates, cheap enough
+ * to run around every loop() call. Not thread-safe: record and summarize
+ * from the loop task only.
+ */
+class LoopProfiler {
+public:
+    /** @brief Buckets per slot: 0 µs, then [2^(k-1), 2^k) µs for k = 1..32. */
+    static const uint8_t BUCKET_COUNT = 33;
+
+    LoopProfiler();
+
+    /**
+     * @brief Records one duration.
+     * @param slot SystemState value or one of the LOOP_PROFILE_SLOT_* constants.
+     * @param durationUs Measured duration in microseconds.
+     */
+    void record(uint8_t slot, uint32_t durationUs) {
+        if (slot >= LOOP_PROFILE_SLOT_COUNT) {
+            return;
+        }
+        SlotHistogram& histogram = _slots[slot];
+        histogram.buckets[bucketFor(durationUs)]++;
+        histogram.count++;
+        if (durationUs < histogram.minUs) histogram.minUs = durationUs;
+        if (durationUs > histogram.maxUs) histogram.maxUs = durationUs;
+    }
+
+    /**
+     * @brief Computes the latency figures of a slot.
+     * @param slot SystemState value or one of the LOOP_PROFILE_SLOT_* constants.
+     * @param summary Receives the figures; all zero if nothing was recorded.
+     */
+    void summarize(uint8_t slot, LatencySummary& summary) const;
+
+    /**
+     * @brief Clears all histograms to start a new reporting window.
+     */
+    void reset();
+
+    /**
+     * @brief Short name of a slot used in the metrics payload, e.g. "operational".
+     */
+    static const char* slotName(uint8_t slot);
+
+    /**
+     * @brief Bucket holding a duration: 0 for 0 µs, else the bit length of the duration.
+     */
+    static uint8_t bucketFor(uint32_t durationUs) {
+        return durationUs == 0 ? 0 : (uint8_t)(32 - __builtin_clz(durationUs));
+    }
+
+private:
+    /**
+     * @struct SlotHistogram
+     * @brief Counters of one slot.
+     */
+    struct SlotHistogram {
+        uint32_t buckets[BUCKET_COUNT]; ///< Durations per power-of-two bucket.
+        uint32_t count;                 ///< Total recorded durations.
+        uint32_t minUs;                 ///< Shortest duration, UINT32_MAX while empty.
+        uint32_t maxUs;                 ///< Longest duration.
+    };
+
+    SlotHistogram _slots[LOOP_PROFILE_SLOT_COUNT];
+
+    /**
+     * @brief Upper bound of the bucket holding the given percentile, capped at the maximum.
+     */
+    uint32_t percentile(const SlotHistogram& histogram, uint32_t percent) const;
+};
+
+#endif // LOOP_PROFILER_H
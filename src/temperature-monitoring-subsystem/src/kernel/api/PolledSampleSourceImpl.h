@@ -0,0 +1,47 @@
+#ifndef POLLED_SAMPLE_SOURCE_IMPL_H
+#define POLLED_SAMPLE_SOURCE_IMPL_H
+
+#include "SampleSource.h"
+#include "../../devices/api/TemperatureManager.h"
+#include "config/config.h"
+
+/**
+ * @class PolledSampleSourceImpl
+ * @brief Implements SampleSource by reading the sensor inline from the FSM.
+ *
+ * Samples are due on a fixed schedule of sampling periods; the sensor is
+ * read in the caller's context by readSample(), so the timestamps still
+ * carry the loop latency. Periods missed entirely by a busy loop are
+ * skipped in the sequence and counted as overruns.
+ */
+class PolledSampleSourceImpl : public SampleSource {
+public:
+    /**
+     * @brief Constructor for PolledSampleSourceImpl.
+     * @param tempCtrl Reference to the temperature manager to read from.
+     */
+    PolledSampleSourceImpl(TemperatureManager& tempCtrl);
+
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~PolledSampleSourceImpl() {}
+
+    void setup() override;
+    void setIntervalMs(unsigned long intervalMs) override;
+    bool sampleReady(unsigned long currentTime) override;
+    unsigned long getNextSampleTime(unsigned long currentTime) const override;
+    bool readSample(TemperatureSample& out) override;
+    unsigned long getOverrunCount() const override;
+    uint32_t getNextSequence() const override;
+    void setNextSequence(uint32_t sequence) override;
+
+private:
+    TemperatureManager& tempController;     ///< Sensor to read from.
+    unsigned long _intervalMs;              ///< Current sampling interval in milliseconds.
+    unsigned long _nextSampleTime;          ///< Deadline of the next sampling period.
+    uint32_t _sequence;                     ///< Sequence number of the next sample.
+    unsigned long _overruns;                ///< Sampling periods missed by the caller.
+};
+
+#endif // POLLED_SAMPLE_SOURCE_IMPL_H
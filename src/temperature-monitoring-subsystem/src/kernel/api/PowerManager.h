@@ -0,0 +1,66 @@
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <stdint.h>
+#include "SamplingPolicy.h"
+#include "WindowStatistics.h"
+
+/**
+ * @struct DutyCycleState
+ * @brief FSM state carried across a deep sleep.
+ *
+ * Everything else is rebuilt on wake: the sample backlog has its own RTC
+ * queue and the WiFi fast-connect parameters are cached in NVS.
+ */
+struct DutyCycleState {
+    unsigned long samplingIntervalMs;   ///< Sampling interval in effect when going to sleep.
+    bool intervalOverridden;            ///< True while the backend forces the sampling interval.
+    SamplingPolicy samplingPolicy;      ///< Last sampling policy received, bandCount 0 if none.
+    uint32_t nextSequence;              ///< Sequence number of the first sample after waking.
+    WindowStatistics statistics;        ///< Statistics window still open when going to sleep, on the clock below.
+    unsigned long clockOffsetMs;        ///< Time from the cold boot to this wake's millis() 0, asleep and awake.
+    unsigned long sleepCycles;          ///< Deep sleeps since the last cold boot.
+    unsigned long wakeToPublishMs;      ///< Time from the last wake to its first sample publish, 0 if none.
+    unsigned long wakeBudgetOverruns;   ///< Wakes whose first publish exceeded DEEP_SLEEP_WAKE_BUDGET_MS.
+};
+
+/**
+ * @class PowerManager
+ * @brief Interface for entering deep sleep and recovering the FSM state afterwards.
+ */
+class PowerManager {
+public:
+    /**
+     * @brief Virtual destructor for proper cleanup.
+     */
+    virtual ~PowerManager() {}
+
+    /**
+     * @brief Determines the reset reason. Must be called before the other methods.
+     */
+    virtual void setup() = 0;
+
+    /**
+     * @brief Checks whether this boot is a wake-up from deep sleep rather than a cold boot.
+     */
+    virtual bool wokeFromDeepSleep() const = 0;
+
+    /**
+     * @brief Recovers the state saved by the deepSleep() call that preceded this boot.
+     * @param out Receives the state.
+     * @return True if the state was restored, false after a cold boot or reset.
+     */
+    virtual bool loadState(DutyCycleState& out) = 0;
+
+    /**
+     * @brief Saves the state and powers down until the timer wakes the device.
+     *
+     * Does not return on hardware: the wake-up is a reset into setup().
+     *
+     * @param state State to restore with loadState() after waking.
+     * @param durationMs Sleep duration in milliseconds.
+     */
+    virtual void deepSleep(const DutyCycleState& state, unsigned long durationMs) = 0;
+};
+
+#endif // POWER_MANAGER_H
@@ -0,0 +1,36 @@
+#ifndef POWER_MANAGER_IMPL_H
+#define POWER_MANAGER_IMPL_H
+
+#include "PowerManager.h"
+#include "config/config.h"
+
+/**
+ * @class PowerManagerImpl
+ * @brief Implements PowerManager with ESP32 timer-wakeup deep sleep.
+ *
+ * The state is kept in RTC_DATA_ATTR memory, which the bootloader
+ * re-initializes on every boot except a wake-up from deep sleep, so a
+ * stale state can never be restored after a power cycle or reset.
+ */
+class PowerManagerImpl : public PowerManager {
+public:
+    /**
+     * @brief Constructor for PowerManagerImpl.
+     */
+    PowerManagerImpl();
+
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~PowerManagerImpl() {}
+
+    void setup() override;
+    bool wokeFromDeepSleep() const override;
+    bool loadState(DutyCycleState& out) override;
+    void deepSleep(const DutyCycleState& state, unsigned long durationMs) override;
+
+private:
+    bool _wokeFromDeepSleep;    ///< True if the timer wake-up caused this boot.
+};
+
+#endif // POWER_MANAGER_IMPL_H
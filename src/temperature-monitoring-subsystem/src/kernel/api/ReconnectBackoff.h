@@ -0,0 +1,69 @@
+#ifndef RECONNECT_BACKOFF_H
+#define RECONNECT_BACKOFF_H
+
+#include <stdint.h>
+
+/**
+ * @class ReconnectBackoff
+ * @brief Capped exponential backoff with per-device jitter for connection retries.
+ *
+ * Each failure draws the next wait uniformly from the upper half of the
+ * current ceiling ("equal jitter"), then doubles the ceiling up to the cap.
+ * Seeded from the chip ID, devices that lost the broker at the same instant
+ * spread their retries instead of reconnecting in lockstep, while each
+ * device still waits at least half the base interval.
+ */
+class ReconnectBackoff {
+public:
+    /**
+     * @param baseMs Ceiling of the wait after the first failure.
+     * @param maxMs Cap of the ceiling.
+     */
+    ReconnectBackoff(unsigned long baseMs, unsigned long maxMs);
+
+    /**
+     * @brief Seeds the jitter; devices must use different seeds, e.g. chipId().
+     */
+    void seed(uint32_t seed);
+
+    /**
+     * @brief Records a failed attempt and draws the wait before the next one.
+     * @return The wait in milliseconds, also returned by getDelayMs() until the next call.
+     */
+    unsigned long fail();
+
+    /**
+     * @brief Forgets the failures after a successful connection.
+     */
+    void reset();
+
+    /**
+     * @brief Wait drawn by the last fail(), 0 after reset().
+     */
+    unsigned long getDelayMs() const { return _delayMs; }
+
+    /**
+     * @brief Longest wait drawn since the last reset(), 0 after reset().
+     *
+     * With jitter the last wait of an outage need not be its longest.
+     */
+    unsigned long getLongestDelayMs() const { return _longestDelayMs; }
+
+    /**
+     * @brief Failed attempts since the last reset().
+     */
+    unsigned long getFailures() const { return _failures; }
+
+private:
+    unsigned long _baseMs;         ///< Ceiling after the first failure.
+    unsigned long _maxMs;          ///< Cap of the ceiling.
+    unsigned long _ceilingMs;      ///< Upper bound of the next wait.
+    unsigned long _delayMs;        ///< Wait drawn by the last fail().
+    unsigned long _longestDelayMs; ///< Longest wait drawn since the last reset().
+    unsigned long _failures;       ///< Failures since the last reset().
+    uint32_t _random;              ///< xorshift32 state, never 0.
+
+    uint32_t nextRandom();
+};
+
+#endif // RECONNECT_BACKOFF_H
@@ -0,0 +1,39 @@
+#ifndef RTC_SAMPLE_STORE_IMPL_H
+#define RTC_SAMPLE_STORE_IMPL_H
+
+#include "SampleStore.h"
+#include "config/config.h"
+
+/**
+ * @class RtcSampleStoreImpl
+ * @brief Implements SampleStore as a ring of compact records in RTC memory.
+ *
+ * The ring lives in RTC slow memory that is not re-initialized on reset,
+ * so queued samples survive deep sleep and software/watchdog resets without
+ * any flash wear. Each sample is stored as a fixed-size 12-byte record
+ * (timestamp, sequence number and temperature in centi-degrees), plus the
+ * readings of each channel when TEMP_CHANNEL_COUNT is above 1. The
+ * capacity and overflow policy are set by STORE_FORWARD_CAPACITY and
+ * STORE_FORWARD_DROP_OLDEST.
+ */
+class RtcSampleStoreImpl : public SampleStore {
+public:
+    /**
+     * @brief Constructor for RtcSampleStoreImpl.
+     */
+    RtcSampleStoreImpl();
+
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~RtcSampleStoreImpl() {}
+
+    void setup() override;
+    bool push(const TemperatureSample& sample) override;
+    size_t peek(TemperatureSample* out, size_t maxCount) const override;
+    void discard(size_t count) override;
+    size_t size() const override;
+    unsigned long getLostSampleCount() const override;
+};
+
+#endif // RTC_SAMPLE_STORE_IMPL_H
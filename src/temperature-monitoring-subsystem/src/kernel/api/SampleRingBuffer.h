@@ -0,0 +1,97 @@
+#ifndef SAMPLE_RING_BUFFER_H
+#define SAMPLE_RING_BUFFER_H
+
+#include <stddef.h>
+
+/**
+ * @class SampleRingBuffer
+ * @brief Fixed-capacity FIFO ring buffer with drop-oldest semantics.
+ *
+ * Storage is allocated inline, so the buffer never touches the heap.
+ * When the buffer is full, pushing a new element overwrites the oldest one.
+ *
+ * @tparam T Element type.
+ * @tparam Capacity Maximum number of elements held by the buffer.
+ */
+template <typename T, size_t Capacity>
+class SampleRingBuffer {
+public:
+    static_assert(Capacity > 0, "SampleRingBuffer capacity must be greater than zero");
+
+    SampleRingBuffer() : _head(0), _count(0) {}
+
+    /**
+     * @brief Appends an element, overwriting the oldest one if the buffer is full.
+     * @param item The element to append.
+     * @return True if the element was stored without overwriting, false if the oldest was dropped.
+     */
+    bool push(const T& item) {
+        size_t tail = (_head + _count) % Capacity;
+        _items[tail] = item;
+        if (_count < Capacity) {
+            _count++;
+            return true;
+        }
+        _head = (_head + 1) % Capacity; // Oldest element overwritten
+        return false;
+    }
+
+    /**
+     * @brief Removes the oldest element.
+     * @param out Receives the removed element.
+     * @return True if an element was removed, false if the buffer was empty.
+     */
+    bool pop(T& out) {
+        if (_count == 0) {
+            return false;
+        }
+        out = _items[_head];
+        _head = (_head + 1) % Capacity;
+        _count--;
+        return true;
+    }
+
+    /**
+     * @brief Accesses an element by age.
+     * @param index 0 for the oldest element, size() - 1 for the newest.
+     */
+    const T& at(size_t index) const {
+        return _items[(_head + index) % Capacity];
+    }
+
+    /**
+     * @brief Copies up to maxCount elements, oldest first, into a linear array.
+     * @return Number of elements copied.
+     */
+    size_t copyTo(T* out, size_t maxCount) const {
+        size_t n = (_count < maxCount) ? _count : maxCount;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = at(i);
+        }
+        return n;
+    }
+
+    /**
+     * @brief Removes the oldest n elements.
+     */
+    void discard(size_t n) {
+        if (n > _count) {
+            n = _count;
+        }
+        _head = (_head + n) % Capacity;
+        _count -= n;
+    }
+
+    void clear() { _head = 0; _count = 0; }
+    size_t size() const { return _count; }
+    bool isEmpty() const { return _count == 0; }
+    bool isFull() const { return _count == Capacity; }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    T _items[Capacity];     ///< Inline element storage.
+    size_t _head;           ///< Index of the oldest element.
+    size_t _count;          ///< Number of stored elements.
+};
+
+#endif // SAMPLE_RING_BUFFER_H
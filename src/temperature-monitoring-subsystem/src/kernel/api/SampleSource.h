@@ -0,0 +1,76 @@
+#ifndef SAMPLE_SOURCE_H
+#define SAMPLE_SOURCE_H
+
+#include "TemperatureSample.h"
+
+/**
+ * @class SampleSource
+ * @brief Interface for the component that decides when temperature samples are taken.
+ *
+ * Decouples the FSM from the sampling schedule: the FSM asks whether a
+ * sample is ready and consumes it, while the implementation decides whether
+ * the sensor is read inline or by an independent producer.
+ */
+class SampleSource {
+public:
+    /**
+     * @brief Virtual destructor for proper cleanup.
+     */
+    virtual ~SampleSource() {}
+
+    /**
+     * @brief Initializes the source and starts sampling.
+     * Must be called once during system setup, after the sensor is set up.
+     */
+    virtual void setup() = 0;
+
+    /**
+     * @brief Changes the sampling period.
+     * @param intervalMs New sampling interval in milliseconds.
+     */
+    virtual void setIntervalMs(unsigned long intervalMs) = 0;
+
+    /**
+     * @brief Checks whether a sample can be consumed.
+     * @param currentTime Current system time in milliseconds.
+     * @return True if readSample() will return a sample.
+     */
+    virtual bool sampleReady(unsigned long currentTime) = 0;
+
+    /**
+     * @brief Gets the time by which sampleReady() should be checked again.
+     *
+     * Sources with an independent producer return a fallback one period
+     * ahead and wake the consumer task with a notification instead.
+     *
+     * @param currentTime Current system time in milliseconds.
+     * @return Deadline in millis() time; currentTime if a sample is ready now.
+     */
+    virtual unsigned long getNextSampleTime(unsigned long currentTime) const = 0;
+
+    /**
+     * @brief Consumes the next sample.
+     * @param out Receives the sample.
+     * @return True if a sample was returned, false if none was ready.
+     */
+    virtual bool readSample(TemperatureSample& out) = 0;
+
+    /**
+     * @brief Gets the number of samples lost because the consumer fell behind.
+     */
+    virtual unsigned long getOverrunCount() const = 0;
+
+    /**
+     * @brief Gets the sequence number the next sample will carry.
+     */
+    virtual uint32_t getNextSequence() const = 0;
+
+    /**
+     * @brief Continues the sequence numbering of an earlier run, e.g. across a deep sleep.
+     * Must be called before setup().
+     * @param sequence Sequence number of the next sample.
+     */
+    virtual void setNextSequence(uint32_t sequence) = 0;
+};
+
+#endif // SAMPLE_SOURCE_H
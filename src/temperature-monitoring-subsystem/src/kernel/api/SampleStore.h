@@ -0,0 +1,61 @@
+#ifndef SAMPLE_STORE_H
+#define SAMPLE_STORE_H
+
+#include <stddef.h>
+#include "TemperatureSample.h"
+
+/**
+ * @class SampleStore
+ * @brief Interface for a bounded store-and-forward queue of temperature samples.
+ *
+ * Holds samples taken while the network is unavailable so that they can be
+ * forwarded once the connection is restored. The queue is bounded: when it
+ * is full, either the oldest or the incoming sample is dropped and counted
+ * as lost, depending on the configured policy.
+ */
+class SampleStore {
+public:
+    /**
+     * @brief Virtual destructor for proper cleanup.
+     */
+    virtual ~SampleStore() {}
+
+    /**
+     * @brief Initializes or recovers the store.
+     * Must be called once during system setup.
+     */
+    virtual void setup() = 0;
+
+    /**
+     * @brief Appends a sample, applying the overflow policy if the store is full.
+     * @param sample The sample to store.
+     * @return True if the sample was stored without losing any data, false otherwise.
+     */
+    virtual bool push(const TemperatureSample& sample) = 0;
+
+    /**
+     * @brief Copies the oldest samples without removing them.
+     * @param out Destination array, filled oldest first.
+     * @param maxCount Capacity of the destination array.
+     * @return Number of samples copied.
+     */
+    virtual size_t peek(TemperatureSample* out, size_t maxCount) const = 0;
+
+    /**
+     * @brief Removes the oldest samples, typically after they were forwarded.
+     * @param count Number of samples to remove.
+     */
+    virtual void discard(size_t count) = 0;
+
+    /**
+     * @brief Gets the number of samples currently queued.
+     */
+    virtual size_t size() const = 0;
+
+    /**
+     * @brief Gets the total number of samples dropped because the store was full.
+     */
+    virtual unsigned long getLostSampleCount() const = 0;
+};
+
+#endif // SAMPLE_STORE_H
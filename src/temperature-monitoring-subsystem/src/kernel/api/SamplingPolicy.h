@@ -0,0 +1,34 @@
+#ifndef SAMPLING_POLICY_H
+#define SAMPLING_POLICY_H
+
+#include <stdint.h>
+#include "../../config/config.h"
+
+/**
+ * @struct SamplingPolicy
+ * @brief Temperature bands and the sampling interval to use in each band.
+ *
+ * Received once from the backend as a retained configuration, so the FSM
+ * can switch its sampling interval locally as soon as a sample crosses a
+ * threshold instead of waiting for a backend round trip.
+ */
+struct SamplingPolicy {
+    uint8_t bandCount;                                      ///< Number of bands (thresholds + 1), 0 if no policy is set.
+    float thresholds[SAMPLING_POLICY_MAX_BANDS - 1];        ///< Ascending band boundaries in Celsius.
+    unsigned long intervalsMs[SAMPLING_POLICY_MAX_BANDS];   ///< Sampling interval of each band in milliseconds.
+
+    /**
+     * @brief Finds the band of a temperature.
+     * A temperature at or above thresholds[i] belongs to band i + 1.
+     * @return Band index, always below bandCount when a policy is set.
+     */
+    uint8_t bandFor(float temperature) const {
+        uint8_t band = 0;
+        while (band + 1 < bandCount && temperature >= thresholds[band]) {
+            band++;
+        }
+        return band;
+    }
+};
+
+#endif // SAMPLING_POLICY_H
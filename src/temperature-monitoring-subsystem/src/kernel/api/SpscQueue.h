@@ -0,0 +1,74 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <stddef.h>
+
+/**
+ * @class SpscQueue
+ * @brief Lock-free bounded queue for exactly one producer and one consumer.
+ *
+ * The producer only writes the tail index and the consumer only writes the
+ * head index, so the two sides can run on different cores without locks or
+ * critical sections. A push on a full queue fails instead of overwriting,
+ * since the producer may not modify the consumer's head index.
+ *
+ * @tparam T Element type (copied by value).
+ * @tparam Capacity Maximum number of queued elements.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+public:
+    static_assert(Capacity > 0, "SpscQueue capacity must be greater than zero");
+
+    SpscQueue() : _head(0), _tail(0) {}
+
+    /**
+     * @brief Appends an element. Producer side only.
+     * @return False if the queue was full and the element was not stored.
+     */
+    bool push(const T& item) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t next = increment(tail);
+        if (next == _head.load(std::memory_order_acquire)) {
+            return false; // Full
+        }
+        _items[tail] = item;
+        _tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element. Consumer side only.
+     * @return False if the queue was empty.
+     */
+    bool pop(T& out) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+            return false; // Empty
+        }
+        out = _items[head];
+        _head.store(increment(head), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Checks for pending elements. Consumer side only.
+     */
+    bool isEmpty() const {
+        return _head.load(std::memory_order_relaxed) == _tail.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t SLOTS = Capacity + 1; ///< One slot stays free to tell full from empty.
+
+    static size_t increment(size_t index) {
+        return (index + 1 == SLOTS) ? 0 : index + 1;
+    }
+
+    T _items[SLOTS];                ///< Element storage.
+    std::atomic<size_t> _head;      ///< Next slot to read, written by the consumer.
+    std::atomic<size_t> _tail;      ///< Next slot to write, written by the producer.
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,79 @@
+#ifndef TASK_SAMPLE_SOURCE_IMPL_H
+#define TASK_SAMPLE_SOURCE_IMPL_H
+
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
+#include "SampleSource.h"
+#include "SpscQueue.h"
+#include "../../devices/api/TemperatureManager.h"
+#include "config/config.h"
+
+/**
+ * @class TaskSampleSourceImpl
+ * @brief Implements SampleSource with a dedicated FreeRTOS sampling task.
+ *
+ * A periodic esp_timer defines the sampling periods: its callback records
+ * a monotonic timestamp and sequence number for each period and wakes the
+ * sampling task, which reads the sensor. The task is pinned to
+ * SAMPLING_TASK_CORE, away from the Arduino loop that runs WiFi and MQTT, so
+ * slow network calls never delay a sample. Samples are handed to the FSM
+ * through a lock-free single-producer/single-consumer queue, and the task
+ * that called setup() is notified of each one so it can sleep in between.
+ */
+class TaskSampleSourceImpl : public SampleSource {
+public:
+    /**
+     * @brief Constructor for TaskSampleSourceImpl.
+     * @param tempCtrl Reference to the temperature manager, read only by the sampling task.
+     */
+    TaskSampleSourceImpl(TemperatureManager& tempCtrl);
+
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~TaskSampleSourceImpl() {}
+
+    void setup() override;
+    void setIntervalMs(unsigned long intervalMs) override;
+    bool sampleReady(unsigned long currentTime) override;
+    unsigned long getNextSampleTime(unsigned long currentTime) const override;
+    bool readSample(TemperatureSample& out) override;
+    unsigned long getOverrunCount() const override;
+    uint32_t getNextSequence() const override;
+    void setNextSequence(uint32_t sequence) override;
+
+private:
+    TemperatureManager& tempController;                             ///< Sensor, owned by the sampling task.
+    SpscQueue<TemperatureSample, 2> _ticks;                         ///< Periods stamped by the timer, awaiting a reading.
+    SpscQueue<TemperatureSample, SAMPLING_QUEUE_CAPACITY> _samples; ///< Samples handed to the FSM.
+    unsigned long _intervalMs;                                      ///< Sampling period, owned by the FSM.
+    uint32_t _nextSequence;                                         ///< Sequence number of the next period, owned by the timer.
+    std::atomic<uint32_t> _overruns;                                ///< Periods dropped on a full queue.
+    TaskHandle_t _taskHandle;                                       ///< Handle of the sampling task.
+    TaskHandle_t _consumerTask;                                     ///< Task notified of new samples (the one that ran setup()).
+    esp_timer_handle_t _timer;                                      ///< Periodic timer defining the sampling periods.
+
+    /**
+     * @brief esp_timer callback, forwards to onTimer().
+     */
+    static void timerCallback(void* param);
+
+    /**
+     * @brief Stamps the elapsed period and wakes the sampling task.
+     */
+    void onTimer();
+
+    /**
+     * @brief FreeRTOS entry point, forwards to taskLoop().
+     */
+    static void taskEntry(void* param);
+
+    /**
+     * @brief Body of the sampling task. Never returns.
+     */
+    void taskLoop();
+};
+
+#endif // TASK_SAMPLE_SOURCE_IMPL_H
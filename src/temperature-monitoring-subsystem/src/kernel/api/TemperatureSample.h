@@ -0,0 +1,18 @@
+#ifndef TEMPERATURE_SAMPLE_H
+#define TEMPERATURE_SAMPLE_H
+
+#include <stdint.h>
+#include "../../devices/api/TemperatureFrame.h"
+
+/**
+ * @struct TemperatureSample
+ * @brief A frame of temperature readings together with the time it was taken.
+ */
+struct TemperatureSample {
+    unsigned long timestampMs;  ///< Monotonic time since boot in milliseconds when the sample was taken.
+    float temperature;          ///< Control temperature in Celsius, frame.aggregate() of a sampled frame.
+    uint32_t sequence;          ///< Sampling period number; gaps mean dropped samples.
+    TemperatureFrame frame;     ///< Reading of each channel.
+};
+
+#endif // TEMPERATURE_SAMPLE_H
@@ -0,0 +1,62 @@
+#ifndef WINDOW_STATISTICS_H
+#define WINDOW_STATISTICS_H
+
+#include <stdint.h>
+#include "TemperatureSample.h"
+
+/**
+ * @struct WindowStatistics
+ * @brief Running count, mean, variance, minimum and maximum of the samples of one window.
+ *
+ * Updated in O(1) per sample with Welford's algorithm, which stays accurate in
+ * single precision where a running sum of squares would cancel out. Plain data,
+ * so it can be kept in RTC memory across a deep sleep.
+ */
+struct WindowStatistics {
+    uint32_t count;                 ///< Samples in the window, 0 while empty.
+    float mean;                     ///< Mean temperature in Celsius.
+    float m2;                       ///< Sum of squared deviations from the mean.
+    float min;                      ///< Lowest temperature in Celsius.
+    float max;                      ///< Highest temperature in Celsius.
+    float last;                     ///< Temperature of the latest sample in Celsius.
+    unsigned long firstTimestampMs; ///< Time the first sample of the window was taken.
+    unsigned long lastTimestampMs;  ///< Time the latest sample of the window was taken.
+    uint32_t firstSequence;         ///< Sequence number of the first sample of the window.
+    uint32_t lastSequence;          ///< Sequence number of the latest sample of the window.
+
+    /**
+     * @brief Adds a sample to the window.
+     */
+    void add(const TemperatureSample& sample) {
+        if (count == 0) {
+            min = max = sample.temperature;
+            firstTimestampMs = sample.timestampMs;
+            firstSequence = sample.sequence;
+        }
+        count++;
+        float delta = sample.temperature - mean;
+        mean += delta / count;
+        m2 += delta * (sample.temperature - mean);
+        if (sample.temperature < min) min = sample.temperature;
+        if (sample.temperature > max) max = sample.temperature;
+        last = sample.temperature;
+        lastTimestampMs = sample.timestampMs;
+        lastSequence = sample.sequence;
+    }
+
+    /**
+     * @brief Sample variance of the window in Celsius squared, 0 below two samples.
+     */
+    float variance() const {
+        return count > 1 ? m2 / (count - 1) : 0.0f;
+    }
+
+    /**
+     * @brief Empties the window.
+     */
+    void reset() {
+        *this = WindowStatistics();
+    }
+};
+
+#endif // WINDOW_STATISTICS_H
@@ -0,0 +1,133 @@
+#ifndef BINARY_TELEMETRY_H
+#define BINARY_TELEMETRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "StatusReport.h"
+#include "../../api/TemperatureSample.h"
+#include "config/config.h"
+
+/**
+ * @file BinaryTelemetry.h
+ * @brief Fixed-layout little-endian records published on the "/bin" topics.
+ *
+ * Temperature record (MQTT_TOPIC_TEMPERATURE_BINARY), 4 + BINARY_SAMPLE_ENTRY_LEN * N bytes:
+ *   [0] u8 version, [1] u8 flags (BINARY_FLAG_*), [2..3] u16 suppressed samples,
+ *   then N entries of { u32 sequence, u32 timestamp ms, i16 centi-degrees }.
+ *   N is derived from the length: 1 for a single sample, more for a batch.
+ *   Bits 4..7 of the flags hold the channel count C of a multi-channel frame
+ *   (0 with a single channel); each entry then ends with C more i16
+ *   centi-degrees, one per channel, after the control temperature.
+ *
+ * Status record (MQTT_TOPIC_STATUS_BINARY), 4 bytes or 4 + 4 * BINARY_STATUS_FIELD_COUNT bytes:
+ *   [0] u8 version, [1] u8 status (BINARY_STATUS_*), [2] u8 flags (BINARY_FLAG_WIFI_*), [3] reserved 0,
+ *   then for a full report the u32 fields in BinaryStatusField order.
+ *
+ * The decoder must reject a version it does not know; new fields are only
+ * ever appended, with a version bump. Version 2 appended the reconnect fields,
+ * version 3 the channel readings of multi-channel frames.
+ */
+
+/** @brief Layout version written in the first byte of every record. */
+const uint8_t BINARY_TELEMETRY_VERSION = 3;
+
+/** @brief Channel readings appended to each sample entry: none for a single channel. */
+const size_t BINARY_SAMPLE_CHANNELS = TEMP_CHANNEL_COUNT > 1 ? TEMP_CHANNEL_COUNT : 0;
+static_assert(BINARY_SAMPLE_CHANNELS <= 15, "The channel count must fit in 4 flag bits");
+
+/** @brief Length of the temperature record header. */
+const size_t BINARY_TEMPERATURE_HEADER_LEN = 4;
+/** @brief Length of one sample entry of a temperature record. */
+const size_t BINARY_SAMPLE_ENTRY_LEN = 10 + 2 * BINARY_SAMPLE_CHANNELS;
+/** @brief Length of the status record header, the whole record for a plain status. */
+const size_t BINARY_STATUS_HEADER_LEN = 4;
+
+/** @brief Temperature flag: the samples were queued during a network outage. */
+const uint8_t BINARY_FLAG_BACKLOG = 0x01;
+/** @brief Temperature flag: the record is a batch, not a live sample (not retained). */
+const uint8_t BINARY_FLAG_BATCH = 0x02;
+/** @brief Position of the channel count in the temperature flags. */
+const uint8_t BINARY_FLAG_CHANNELS_SHIFT = 4;
+/** @brief Status flag: the last WiFi connection used the cached fast path. */
+const uint8_t BINARY_FLAG_WIFI_FAST_PATH = 0x01;
+/** @brief Status flag: a fast-path attempt failed and a full scan was needed. */
+const uint8_t BINARY_FLAG_WIFI_FALLBACK = 0x02;
+
+/** @brief Status code of a keyword other than the ones below. */
+const uint8_t BINARY_STATUS_OTHER = 0;
+/** @brief Status code of "online". */
+const uint8_t BINARY_STATUS_ONLINE = 1;
+/** @brief Status code of "offline". */
+const uint8_t BINARY_STATUS_OFFLINE = 2;
+
+/**
+ * @enum BinaryStatusField
+ * @brief Order of the u32 fields of a full status record.
+ */
+enum BinaryStatusField {
+    BINARY_STATUS_UPTIME_MS,
+    BINARY_STATUS_BOOT_TO_OPERATIONAL_MS,
+    BINARY_STATUS_CONNECT_TO_OPERATIONAL_MS,
+    BINARY_STATUS_BACKLOG_SAMPLES,
+    BINARY_STATUS_LOST_SAMPLES,
+    BINARY_STATUS_SAMPLING_OVERRUNS,
+    BINARY_STATUS_FREE_HEAP,
+    BINARY_STATUS_MIN_FREE_HEAP,
+    BINARY_STATUS_MAX_ALLOC_HEAP,
+    BINARY_STATUS_WIFI_ASSOCIATION_MS,
+    BINARY_STATUS_WIFI_IP_CONFIG_MS,
+    BINARY_STATUS_WIFI_TOTAL_MS,
+    BINARY_STATUS_DEEP_SLEEP_CYCLES,
+    BINARY_STATUS_WAKE_TO_PUBLISH_MS,
+    BINARY_STATUS_WAKE_BUDGET_OVERRUNS,
+    BINARY_STATUS_SUPPRESSED_SAMPLES,
+    BINARY_STATUS_RECONNECT_FAILURES,
+    BINARY_STATUS_RECONNECT_BACKOFF_MS,
+    BINARY_STATUS_FIELD_COUNT
+};
+
+/**
+ * @struct HeapMetrics
+ * @brief Heap figures reported alongside a StatusReport, in bytes.
+ */
+struct HeapMetrics {
+    uint32_t freeHeap;      ///< Free heap now.
+    uint32_t minFreeHeap;   ///< Lowest free heap since boot.
+    uint32_t maxAllocHeap;  ///< Largest block that can be allocated now.
+};
+
+namespace BinaryTelemetry {
+
+/**
+ * @brief Encodes samples as a temperature record.
+ * @param out Buffer receiving the record.
+ * @param capacity Size of the buffer in bytes.
+ * @param samples Array of samples, oldest first.
+ * @param count Number of samples, at least 1.
+ * @param flags BINARY_FLAG_* bits; the channel count is added here.
+ * @param suppressed Samples held back by the deadband before the first one, saturated to 16 bits.
+ * @return Length of the record, or 0 if it does not fit.
+ */
+size_t encodeSamples(uint8_t* out, size_t capacity, const TemperatureSample* samples, size_t count,
+                     uint8_t flags, uint32_t suppressed);
+
+/**
+ * @brief Encodes a status keyword, with the report fields if a report is given.
+ * @param out Buffer receiving the record.
+ * @param capacity Size of the buffer in bytes.
+ * @param status Status keyword, e.g. "online".
+ * @param report Full report to append, or nullptr for the plain status.
+ * @param heap Heap figures of the report, ignored without a report.
+ * @return Length of the record, or 0 if it does not fit.
+ */
+size_t encodeStatus(uint8_t* out, size_t capacity, const char* status, const StatusReport* report,
+                    const HeapMetrics& heap);
+
+/**
+ * @brief Converts a temperature to signed centi-degrees, rounded and clamped to 16 bits.
+ */
+int16_t toCentiDegrees(float temperature);
+
+} // namespace BinaryTelemetry
+
+#endif // BINARY_TELEMETRY_H
@@ -2,6 +2,11 @@
 #define MQTT_MANAGER_H
 
 #include <Arduino.h>
+#include "StatusReport.h"
+#include "../../api/TemperatureSample.h"
+#include "../../api/SamplingPolicy.h"
+#include "../../api/LoopProfiler.h"
+#include "../../api/WindowStatistics.h"
 
 /**
  * @class MqttManager
@@ -25,7 +30,7 @@ public:
     virtual void setup() = 0;
 
     /**
-     * @brief Attempts to connect to the configured MQTT broker.
+     * @brief Attempts to connect to the configured MQTT broker and subscribes to the config topics.
      * @return True if connection is successful, false otherwise.
      */
     virtual bool connect() = 0;
@@ -48,11 +53,29 @@ public:
     virtual void loop() = 0;
 
     /**
-     * @brief Publishes the current temperature value.
-     * @param temperature The temperature value to publish.
+     * @brief Publishes the current temperature value with its timestamp and sequence number.
+     * @param sample The sample to publish.
+     * @param suppressed Samples held back by the deadband since the previous publish,
+     *        so the receiver does not count the sequence gap as lost samples.
      * @return True if publishing was successful, false otherwise.
      */
-    virtual bool publishTemperature(float temperature) = 0;
+    virtual bool publishTemperature(const TemperatureSample& sample, uint32_t suppressed) = 0;
+
+    /**
+     * @brief Publishes several samples in a single message.
+     * @param samples Array of samples, oldest first.
+     * @param count Number of samples in the array (at most TELEMETRY_BATCH_MAX_SAMPLES).
+     * @param backlog True if the samples were queued during a network outage.
+     * @return True if publishing was successful, false otherwise.
+     */
+    virtual bool publishTemperatureBatch(const TemperatureSample* samples, size_t count, bool backlog) = 0;
+
+    /**
+     * @brief Publishes the statistics of a window of samples on MQTT_TOPIC_STATS.
+     * @param statistics The window to summarize, with at least one sample.
+     * @return True if publishing was successful, false otherwise.
+     */
+    virtual bool publishTemperatureSummary(const WindowStatistics& statistics) = 0;
 
     /**
      * @brief Publishes a status message.
@@ -62,10 +85,45 @@ public:
     virtual bool publishStatus(const char* statusMessage) = 0;
 
     /**
-     * @brief Retrieves a new sampling interval if received via MQTT.
-     * @return The new sampling interval in milliseconds if available, otherwise 0.
+     * @brief Publishes a status message together with diagnostic metrics.
+     * @param report The status keyword and metrics to publish.
+     * @return True if publishing was successful, false otherwise.
+     */
+    virtual bool publishStatusReport(const StatusReport& report) = 0;
+
+    /**
+     * @brief Publishes the loop timing histograms on MQTT_TOPIC_METRICS.
+     * @param profiler The histograms to summarize.
+     * @param windowMs Time covered by the histograms in milliseconds.
+     * @return True if publishing was successful, false otherwise.
+     */
+    virtual bool publishLoopMetrics(const LoopProfiler& profiler, unsigned long windowMs) = 0;
+
+    /**
+     * @brief Retrieves a sampling interval override if one was received via MQTT.
+     * @param intervalMs Receives the override in milliseconds, or 0 if the override was cleared.
+     * @return True if a new override command was received since the last call.
+     */
+    virtual bool getNewSamplingIntervalMs(unsigned long& intervalMs) = 0;
+
+    /**
+     * @brief Retrieves a new sampling policy if one was received via MQTT.
+     * @param policy Receives the policy.
+     * @return True if a new policy was received since the last call.
+     */
+    virtual bool getNewSamplingPolicy(SamplingPolicy& policy) = 0;
+
+    /**
+     * @brief Gets the number of configuration messages (frequency or policy) received so far.
+     * Lets the main loop tell which loop() call delivered a message.
+     */
+    virtual unsigned long getConfigMessageCount() const = 0;
+
+    /**
+     * @brief Checks if the retained frequency and policy were both received since the last connect().
+     * The broker sends them right after the subscriptions, about one round trip after connecting.
      */
-    virtual unsigned long getNewSamplingIntervalMs() = 0;
+    virtual bool isConfigSynced() const = 0;
 };
 
 #endif // MQTT_MANAGER_H
\ No newline at end of file
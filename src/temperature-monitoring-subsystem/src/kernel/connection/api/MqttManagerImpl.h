@@ -5,6 +5,7 @@
 #include "WifiManager.h"
 #include "config/config.h"
 #include <PubSubClient.h>
+#include <ArduinoJson.h>
 #include <WiFiClient.h>
 
 /**
@@ -12,7 +13,9 @@
  * @brief Implements MQTT client functionality using PubSubClient.
  * 
  * Handles connection to an MQTT broker, message publishing, and processing
- * of incoming frequency configuration messages.
+ * of incoming frequency override and sampling policy messages. Payloads are encoded and
+ * parsed in fixed stack/static buffers so steady-state operation performs
+ * no heap allocation.
  */
 class MqttManagerImpl : public MqttManager {
 public:
@@ -35,21 +38,33 @@ public:
     void disconnect() override;
     bool isConnected() override;
     void loop() override;
-    bool publishTemperature(float temperature) override;
+    bool publishTemperature(const TemperatureSample& sample, uint32_t suppressed) override;
+    bool publishTemperatureBatch(const TemperatureSample* samples, size_t count, bool backlog) override;
+    bool publishTemperatureSummary(const WindowStatistics& statistics) override;
     bool publishStatus(const char* statusMessage) override;
-    unsigned long getNewSamplingIntervalMs() override;
+    bool publishStatusReport(const StatusReport& report) override;
+    bool publishLoopMetrics(const LoopProfiler& profiler, unsigned long windowMs) override;
+    bool getNewSamplingIntervalMs(unsigned long& intervalMs) override;
+    bool getNewSamplingPolicy(SamplingPolicy& policy) override;
+    unsigned long getConfigMessageCount() const override;
+    bool isConfigSynced() const override;
 
 private:
     const char* _host;          ///< MQTT broker hostname or IP.
     int _port;                  ///< MQTT broker port.
-    String _clientId;           ///< Generated unique client ID.
+    char _clientId[48];         ///< Generated unique client ID.
     WifiManager* _wifiManager;  ///< Pointer to the WiFi manager instance.
 
     WiFiClient _espClient;      ///< Underlying TCP client for MQTT.
     PubSubClient _mqttClient;   ///< PubSubClient library instance.
 
-    unsigned long _newSamplingInterval; ///< New sampling interval from MQTT.
+    unsigned long _newSamplingInterval; ///< New sampling interval override from MQTT, 0 to clear.
     bool _newIntervalAvailable;         ///< Flag for new interval availability.
+    SamplingPolicy _newPolicy;          ///< New sampling policy from MQTT.
+    bool _newPolicyAvailable;           ///< Flag for new policy availability.
+    unsigned long _configMessageCount;  ///< Frequency and policy messages received, valid or not.
+    uint8_t _configTopicsReceived;      ///< CONFIG_TOPIC_* bits of the topics received since connect().
+    unsigned long _connectTime;         ///< millis() when the last connection was established.
 
     /**
      * @brief Callback for incoming MQTT messages.
@@ -59,6 +74,16 @@ private:
      */
     void handleMqttMessage(char* topic, byte* payload, unsigned int length);
 
+    /**
+     * @brief Parses a {"frequency":seconds} override; 0 clears the override.
+     */
+    void handleFrequencyMessage(const JsonDocument& doc);
+
+    /**
+     * @brief Parses a {"thresholds":[...],"intervals":[...]} sampling policy.
+     */
+    void handlePolicyMessage(const JsonDocument& doc);
+
     /**
      * @brief Static wrapper for C-style callback requirement.
      */
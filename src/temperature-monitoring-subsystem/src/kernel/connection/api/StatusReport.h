@@ -0,0 +1,30 @@
+#ifndef STATUS_REPORT_H
+#define STATUS_REPORT_H
+
+#include "WifiManager.h"
+
+/**
+ * @struct StatusReport
+ * @brief Extended status information published on MQTT_TOPIC_STATUS.
+ *
+ * Carries the status keyword together with the diagnostic counters
+ * and timings collected by the FSM and its components.
+ */
+struct StatusReport {
+    const char* status;                     ///< Status keyword, e.g. "online".
+    unsigned long uptimeMs;                 ///< Time since boot in milliseconds.
+    unsigned long bootToOperationalMs;      ///< Time from boot to the first STATE_OPERATIONAL entry.
+    unsigned long connectToOperationalMs;   ///< Time from the last connection start to STATE_OPERATIONAL.
+    unsigned long reconnectFailures;        ///< Failed WiFi and MQTT attempts before the last STATE_OPERATIONAL entry.
+    unsigned long reconnectBackoffMs;       ///< Longest single jittered backoff wait of the outage before the last STATE_OPERATIONAL entry.
+    unsigned long backlogSamples;           ///< Samples still queued from network outages.
+    unsigned long lostSamples;              ///< Samples dropped because the outage queue was full.
+    unsigned long samplingOverruns;         ///< Samples dropped because the FSM fell behind the sampling task.
+    WifiConnectMetrics wifi;                ///< Timing of the last WiFi connection.
+    unsigned long deepSleepCycles;          ///< Deep sleeps since the last cold boot.
+    unsigned long wakeToPublishMs;          ///< Time from the previous wake-up to its first sample publish.
+    unsigned long wakeBudgetOverruns;       ///< Wakes whose first publish exceeded DEEP_SLEEP_WAKE_BUDGET_MS.
+    unsigned long suppressedSamples;        ///< Samples not published because they stayed within the deadband.
+};
+
+#endif // STATUS_REPORT_H
@@ -3,6 +3,40 @@
 
 #include <IPAddress.h>
 
+/**
+ * @enum WifiConnectStatus
+ * @brief Progress of a non-blocking WiFi connection attempt.
+ */
+enum WifiConnectStatus {
+    /** @brief No connection attempt has been started. */
+    WIFI_CONNECT_IDLE,
+
+    /** @brief A connection attempt is in progress. */
+    WIFI_CONNECT_PENDING,
+
+    /** @brief The last connection attempt succeeded. */
+    WIFI_CONNECT_SUCCESS,
+
+    /** @brief The last connection attempt failed or timed out. */
+    WIFI_CONNECT_FAILED
+};
+
+/**
+ * @struct WifiConnectMetrics
+ * @brief Timing breakdown of the last successful WiFi connection.
+ *
+ * All durations are in milliseconds. The channel scan is performed by the
+ * WiFi driver as part of association, so it is included in associationMs
+ * (and skipped entirely on the fast path).
+ */
+struct WifiConnectMetrics {
+    unsigned long associationMs;    ///< From WiFi.begin() to association with the access point.
+    unsigned long ipConfigMs;       ///< From association to IP configuration (DHCP or cached static IP).
+    unsigned long totalMs;          ///< From the start of the attempt to IP configuration.
+    bool fastPath;                  ///< True if the connection used cached BSSID/channel/IP hints.
+    bool fastPathFallback;          ///< True if a fast-path attempt failed and a full scan was needed.
+};
+
 /**
  * @class WifiManager
  * @brief Interface for handling WiFi client operations.
@@ -24,10 +58,18 @@ public:
     virtual void setup() = 0;
 
     /**
-     * @brief Attempts to connect to the configured WiFi network.
-     * @return True if connection is established within the timeout, false otherwise.
+     * @brief Starts a non-blocking connection attempt to the configured WiFi network.
+     * Progress must then be checked with pollConnect() on later cycles.
+     * @return True if the attempt was started (or WiFi is already connected), false otherwise.
+     */
+    virtual bool beginConnect() = 0;
+
+    /**
+     * @brief Checks the progress of the attempt started by beginConnect().
+     * Never blocks; a pending attempt is failed once WIFI_CONNECT_TIMEOUT_MS elapses.
+     * @return The current WifiConnectStatus of the attempt.
      */
-    virtual bool connect() = 0;
+    virtual WifiConnectStatus pollConnect() = 0;
 
     /**
      * @brief Checks if the device is currently connected to WiFi.
@@ -41,6 +83,12 @@ public:
      */
     virtual IPAddress getLocalIP() = 0;
 
+    /**
+     * @brief Gets the timing breakdown of the last successful connection.
+     * @return Reference to the metrics of the last successful connection (all zero if none).
+     */
+    virtual const WifiConnectMetrics& getConnectMetrics() const = 0;
+
     /**
      * @brief Disconnects from the current WiFi network.
      */
@@ -4,12 +4,19 @@
 #include "WifiManager.h"
 #include "config/config.h"
 #include <WiFi.h>
+#include <Preferences.h>
 
 /**
  * @class WifiManagerImpl
  * @brief Implements WiFi client functionality for ESP32.
- * 
+ *
  * Handles connecting to a specified WiFi network and monitoring connection status.
+ * Connection attempts are non-blocking: the attempt is started by beginConnect()
+ * and its outcome is polled by the FSM on every cycle.
+ *
+ * The BSSID, channel and IP configuration of the last good connection are cached
+ * in NVS. When a valid cache exists the next attempt skips the channel scan and
+ * DHCP, falling back to a full scan if the fast attempt fails.
  */
 class WifiManagerImpl : public WifiManager {
 public:
@@ -26,14 +33,71 @@ public:
     virtual ~WifiManagerImpl() {}
 
     void setup() override;
-    bool connect() override;
+    bool beginConnect() override;
+    WifiConnectStatus pollConnect() override;
     bool isConnected() override;
     IPAddress getLocalIP() override;
+    const WifiConnectMetrics& getConnectMetrics() const override;
     void disconnect() override;
 
 private:
+    /**
+     * @struct FastConnectCache
+     * @brief Connection parameters persisted in NVS for the fast reconnect path.
+     */
+    struct FastConnectCache {
+        uint32_t ssidHash;      ///< Hash of the SSID the cache belongs to.
+        int32_t channel;        ///< WiFi channel of the access point.
+        uint32_t localIp;       ///< Last leased IP address.
+        uint32_t gateway;       ///< Gateway of the last lease.
+        uint32_t subnet;        ///< Subnet mask of the last lease.
+        uint32_t dns;           ///< Primary DNS server of the last lease.
+        uint8_t bssid[6];       ///< BSSID of the access point.
+        uint8_t reserved[2];    ///< Explicit padding, keeps the blob free of indeterminate bytes.
+    };
+
     const char* _ssid;     ///< SSID of the target WiFi network.
     const char* _password; ///< Password for the target WiFi network.
+
+    WifiConnectStatus _connectStatus;   ///< Progress of the current connection attempt.
+    unsigned long _connectStartTime;    ///< Timestamp at which the current attempt started.
+    unsigned long _attemptStartTime;    ///< Timestamp at which the current WiFi.begin() was issued.
+
+    Preferences _preferences;           ///< NVS storage for the fast-connect cache.
+    FastConnectCache _cache;            ///< Cached parameters of the last good connection.
+    bool _cacheValid;                   ///< True if _cache holds usable parameters.
+    bool _fastPathActive;               ///< True while a fast-path attempt is in progress.
+    bool _fastPathFailed;               ///< True if the current attempt fell back to a full scan.
+
+    volatile unsigned long _associatedTime; ///< Set by the WiFi event handler on association.
+    volatile unsigned long _gotIpTime;      ///< Set by the WiFi event handler on IP configuration.
+    WifiConnectMetrics _metrics;            ///< Timing of the last successful connection.
+
+    /**
+     * @brief Loads the fast-connect cache from NVS and validates it against the SSID.
+     */
+    void loadCache();
+
+    /**
+     * @brief Stores the parameters of the current connection in NVS if they changed.
+     */
+    void saveCache();
+
+    /**
+     * @brief Removes the fast-connect cache from NVS.
+     */
+    void invalidateCache();
+
+    /**
+     * @brief Issues WiFi.begin() with or without the cached hints.
+     * @param useFastPath True to use the cached BSSID, channel and static IP.
+     */
+    void startAttempt(bool useFastPath);
+
+    /**
+     * @brief Computes a 32-bit FNV-1a hash of a string.
+     */
+    static uint32_t hashString(const char* str);
 };
 
-#endif // WIFI_MANAGER_IMPL_H
\ No newline at end of file
+#endif // WIFI_MANAGER_IMPL_H
@@ -0,0 +1,108 @@
+#include "../api/BinaryTelemetry.h"
+#include <math.h>
+#include <string.h>
+
+namespace {
+
+// Explicit byte order, so the layout does not depend on the host CPU
+void putU16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+void putU32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+uint8_t statusCode(const char* status) {
+    if (strcmp(status, "online") == 0) {
+        return BINARY_STATUS_ONLINE;
+    }
+    if (strcmp(status, "offline") == 0) {
+        return BINARY_STATUS_OFFLINE;
+    }
+    return BINARY_STATUS_OTHER;
+}
+
+} // namespace
+
+namespace BinaryTelemetry {
+
+int16_t toCentiDegrees(float temperature) {
+    float centi = roundf(temperature * 100.0f);
+    if (centi > INT16_MAX) return INT16_MAX;
+    if (centi < INT16_MIN) return INT16_MIN;
+    return (int16_t)centi;
+}
+
+size_t encodeSamples(uint8_t* out, size_t capacity, const TemperatureSample* samples, size_t count,
+                     uint8_t flags, uint32_t suppressed) {
+    size_t length = BINARY_TEMPERATURE_HEADER_LEN + count * BINARY_SAMPLE_ENTRY_LEN;
+    if (count == 0 || length > capacity) {
+        return 0;
+    }
+
+    out[0] = BINARY_TELEMETRY_VERSION;
+    out[1] = flags | (uint8_t)(BINARY_SAMPLE_CHANNELS << BINARY_FLAG_CHANNELS_SHIFT);
+    putU16(out + 2, suppressed > UINT16_MAX ? UINT16_MAX : (uint16_t)suppressed);
+
+    uint8_t* entry = out + BINARY_TEMPERATURE_HEADER_LEN;
+    for (size_t i = 0; i < count; i++, entry += BINARY_SAMPLE_ENTRY_LEN) {
+        putU32(entry, samples[i].sequence);
+        putU32(entry + 4, (uint32_t)samples[i].timestampMs);
+        putU16(entry + 8, (uint16_t)toCentiDegrees(samples[i].temperature));
+        for (size_t channel = 0; channel < BINARY_SAMPLE_CHANNELS; channel++) {
+            putU16(entry + 10 + 2 * channel, (uint16_t)samples[i].frame.centiDegrees[channel]);
+        }
+    }
+    return length;
+}
+
+size_t encodeStatus(uint8_t* out, size_t capacity, const char* status, const StatusReport* report,
+                    const HeapMetrics& heap) {
+    size_t length = BINARY_STATUS_HEADER_LEN + (report ? BINARY_STATUS_FIELD_COUNT * 4 : 0);
+    if (length > capacity) {
+        return 0;
+    }
+
+    out[0] = BINARY_TELEMETRY_VERSION;
+    out[1] = statusCode(status);
+    out[2] = 0;
+    out[3] = 0;
+    if (!report) {
+        return length;
+    }
+
+    if (report->wifi.fastPath) out[2] |= BINARY_FLAG_WIFI_FAST_PATH;
+    if (report->wifi.fastPathFallback) out[2] |= BINARY_FLAG_WIFI_FALLBACK;
+
+    uint32_t fields[BINARY_STATUS_FIELD_COUNT];
+    fields[BINARY_STATUS_UPTIME_MS] = report->uptimeMs;
+    fields[BINARY_STATUS_BOOT_TO_OPERATIONAL_MS] = report->bootToOperationalMs;
+    fields[BINARY_STATUS_CONNECT_TO_OPERATIONAL_MS] = report->connectToOperationalMs;
+    fields[BINARY_STATUS_BACKLOG_SAMPLES] = report->backlogSamples;
+    fields[BINARY_STATUS_LOST_SAMPLES] = report->lostSamples;
+    fields[BINARY_STATUS_SAMPLING_OVERRUNS] = report->samplingOverruns;
+    fields[BINARY_STATUS_FREE_HEAP] = heap.freeHeap;
+    fields[BINARY_STATUS_MIN_FREE_HEAP] = heap.minFreeHeap;
+    fields[BINARY_STATUS_MAX_ALLOC_HEAP] = heap.maxAllocHeap;
+    fields[BINARY_STATUS_WIFI_ASSOCIATION_MS] = report->wifi.associationMs;
+    fields[BINARY_STATUS_WIFI_IP_CONFIG_MS] = report->wifi.ipConfigMs;
+    fields[BINARY_STATUS_WIFI_TOTAL_MS] = report->wifi.totalMs;
+    fields[BINARY_STATUS_DEEP_SLEEP_CYCLES] = report->deepSleepCycles;
+    fields[BINARY_STATUS_WAKE_TO_PUBLISH_MS] = report->wakeToPublishMs;
+    fields[BINARY_STATUS_WAKE_BUDGET_OVERRUNS] = report->wakeBudgetOverruns;
+    fields[BINARY_STATUS_SUPPRESSED_SAMPLES] = report->suppressedSamples;
+    fields[BINARY_STATUS_RECONNECT_FAILURES] = report->reconnectFailures;
+    fields[BINARY_STATUS_RECONNECT_BACKOFF_MS] = report->reconnectBackoffMs;
+
+    for (size_t i = 0; i < BINARY_STATUS_FIELD_COUNT; i++) {
+        putU32(out + BINARY_STATUS_HEADER_LEN + 4 * i, fields[i]);
+    }
+    return length;
+}
+
+} // namespace BinaryTelemetry
@@ -1,6 +1,53 @@
 #include "../api/MqttManagerImpl.h"
+#include "../api/BinaryTelemetry.h"
 #include "../../../config/config.h"
+#include "../../api/ChipId.h"
+#include "../../api/Log.h"
 #include <Arduino.h>
+#include <ArduinoJson.h>
+#include <string.h>
+
+// A full batch, the topic and the MQTT header must fit in the PubSubClient buffer
+static_assert(TELEMETRY_BATCH_MAX_SAMPLES * TELEMETRY_BATCH_ENTRY_MAX_LEN + 80 <= MQTT_PACKET_BUFFER_SIZE,
+              "MQTT_PACKET_BUFFER_SIZE too small for TELEMETRY_BATCH_MAX_SAMPLES");
+
+// A full binary batch and the longer binary topic must fit as well
+static_assert(BINARY_TEMPERATURE_HEADER_LEN + TELEMETRY_BATCH_MAX_SAMPLES * BINARY_SAMPLE_ENTRY_LEN + 80 <= MQTT_PACKET_BUFFER_SIZE,
+              "MQTT_PACKET_BUFFER_SIZE too small for a binary batch of TELEMETRY_BATCH_MAX_SAMPLES");
+
+// Worst-case loop metrics entry: "mqtt_connecting":[4294967295,4294967295,4294967295,4294967295,4294967295],
+static const size_t LOOP_METRICS_ENTRY_MAX_LEN = 76;
+static const size_t LOOP_METRICS_PAYLOAD_SIZE = LOOP_PROFILE_SLOT_COUNT * LOOP_METRICS_ENTRY_MAX_LEN + 48;
+static_assert(LOOP_METRICS_PAYLOAD_SIZE + 80 <= MQTT_PACKET_BUFFER_SIZE,
+              "MQTT_PACKET_BUFFER_SIZE too small for the loop metrics payload");
+
+// A full sampling policy must fit in the static configuration document
+static_assert(JSON_OBJECT_SIZE(2) + 2 * JSON_ARRAY_SIZE(SAMPLING_POLICY_MAX_BANDS) <= MQTT_CONFIG_JSON_CAPACITY,
+              "MQTT_CONFIG_JSON_CAPACITY too small for SAMPLING_POLICY_MAX_BANDS");
+
+// Bits of _configTopicsReceived
+static const uint8_t CONFIG_TOPIC_FREQUENCY = 0x01;
+static const uint8_t CONFIG_TOPIC_POLICY = 0x02;
+static const uint8_t CONFIG_TOPIC_ALL = CONFIG_TOPIC_FREQUENCY | CONFIG_TOPIC_POLICY;
+
+/**
+ * @brief Appends ,"ch":[XX.YY,...] with the channel readings of a multi-channel frame; nothing for one channel.
+ * @return Length written, as snprintf() would (at least size if truncated).
+ */
+static size_t appendChannels(char* out, size_t size, const TemperatureFrame& frame) {
+    if (TEMP_CHANNEL_COUNT == 1) {
+        return 0;
+    }
+    size_t length = snprintf(out, size, ",\"ch\":[");
+    for (int channel = 0; channel < TEMP_CHANNEL_COUNT && length < size; channel++) {
+        length += snprintf(out + length, size - length, "%s%.2f", channel > 0 ? "," : "",
+                           frame.centiDegrees[channel] / 100.0f);
+    }
+    if (length < size) {
+        length += snprintf(out + length, size - length, "]");
+    }
+    return length;
+}
 
 // Static instance pointer for callback
 MqttManagerImpl* MqttManagerImpl::_instance = nullptr;
@@ -11,16 +58,17 @@ MqttManagerImpl::MqttManagerImpl(const char* host, int port, const char* clientI
       _wifiManager(wifiManager),
       _mqttClient(_espClient),
       _newSamplingInterval(0),
-      _newIntervalAvailable(false) {
+      _newIntervalAvailable(false),
+      _newPolicy(),
+      _newPolicyAvailable(false),
+      _configMessageCount(0),
+      _configTopicsReceived(0),
+      _connectTime(0) {
     
     _instance = this;
 
-    // Generate unique client ID using ESP32 MAC
-    uint32_t chipId = 0;
-    for (int i = 0; i < 17; i = i + 8) {
-        chipId |= ((ESP.getEfuseMac() >> (40 - i)) & 0xff) << i;
-    }
-    _clientId = String(clientIdPrefix) + String(chipId, HEX);
+    // Unique client ID from the ESP32 MAC, stable across reboots so the broker keeps the session
+    snprintf(_clientId, sizeof(_clientId), "%s%lx", clientIdPrefix, (unsigned long)chipId());
 }
 
 // Static callback wrapper - required by PubSubClient
@@ -32,51 +80,105 @@ void MqttManagerImpl::staticMqttCallback(char* topic, byte* payload, unsigned in
 
 // Handle incoming MQTT messages
 void MqttManagerImpl::handleMqttMessage(char* topic, byte* payload, unsigned int length) {
-    // Only handle frequency configuration topic
-    if (String(topic) != MQTT_TOPIC_CONFIG_F) {
+    bool isFrequency = strcmp(topic, MQTT_TOPIC_CONFIG_F) == 0;
+    bool isPolicy = strcmp(topic, MQTT_TOPIC_CONFIG_POLICY) == 0;
+    if (!isFrequency && !isPolicy) {
         return;
     }
+    _configMessageCount++;
 
-    // Convert payload to string
-    String message = "";
-    for (unsigned int i = 0; i < length; i++) {
-        message += (char)payload[i];
+    uint8_t topicBit = isPolicy ? CONFIG_TOPIC_POLICY : CONFIG_TOPIC_FREQUENCY;
+    if (!(_configTopicsReceived & topicBit)) {
+        _configTopicsReceived |= topicBit;
+        if (_configTopicsReceived == CONFIG_TOPIC_ALL) {
+            LOG_INFO("MQTT: Retained config received %lu ms after connect", millis() - _connectTime);
+        }
     }
 
-    Serial.print("MQTT: Frequency config received: ");
-    Serial.println(message);
+    // Only the pointer of a log argument is queued, so log the topic's literal, never the payload buffer
+    LOG_DEBUG("MQTT: %s received, %u bytes", isPolicy ? "Sampling policy" : "Frequency config", length);
 
-    // JSON parsing look for format "frequency":value
-    int freqIndex = message.indexOf("\"frequency\":");
-    if (freqIndex >= 0) {
-        int valueStart = freqIndex + 12; // Skip past "frequency":
-        int valueEnd = message.indexOf(',', valueStart);
-        if (valueEnd == -1) valueEnd = message.indexOf('}', valueStart);
-        
-        if (valueEnd > valueStart) {
-            long frequencySeconds = message.substring(valueStart, valueEnd).toInt();
-            unsigned long intervalMs = frequencySeconds * 1000;
-            
-            // Validation for incoming sampling interval
-            if (intervalMs >= 1000 && intervalMs <= 600000) {
-                _newSamplingInterval = intervalMs;
-                _newIntervalAvailable = true;
-                Serial.print("MQTT: New sampling interval: ");
-                Serial.print(intervalMs);
-                Serial.println(" ms");
-            } else {
-                Serial.println("MQTT: Invalid frequency value");
-            }
+    // Parse in place over the payload: the document pool is static, no heap is used
+    StaticJsonDocument<MQTT_CONFIG_JSON_CAPACITY> doc;
+    DeserializationError error = deserializeJson(doc, payload, length);
+    if (error) {
+        LOG_WARN("MQTT: Invalid config JSON: %s", error.c_str());
+        return;
+    }
+
+    if (isPolicy) {
+        handlePolicyMessage(doc);
+    } else {
+        handleFrequencyMessage(doc);
+    }
+}
+
+void MqttManagerImpl::handleFrequencyMessage(const JsonDocument& doc) {
+    // Expected format: {"frequency":seconds}, 0 hands control back to the sampling policy
+    JsonVariantConst frequency = doc["frequency"];
+    if (!frequency.is<long>()) {
+        return;
+    }
+
+    long frequencySeconds = frequency.as<long>();
+    if (frequencySeconds == 0) {
+        _newSamplingInterval = 0;
+        _newIntervalAvailable = true;
+        LOG_INFO("MQTT: Sampling interval override cleared");
+        return;
+    }
+
+    // Validation for incoming sampling interval
+    if (frequencySeconds >= SAMPLING_INTERVAL_MIN_S && frequencySeconds <= SAMPLING_INTERVAL_MAX_S) {
+        _newSamplingInterval = frequencySeconds * 1000UL;
+        _newIntervalAvailable = true;
+        LOG_INFO("MQTT: New sampling interval: %lu ms", _newSamplingInterval);
+    } else {
+        LOG_WARN("MQTT: Invalid frequency value");
+    }
+}
+
+void MqttManagerImpl::handlePolicyMessage(const JsonDocument& doc) {
+    // Expected format: {"thresholds":[T1,T2,...],"intervals":[s0,s1,s2,...]}, one more interval than thresholds
+    JsonArrayConst thresholds = doc["thresholds"].as<JsonArrayConst>();
+    JsonArrayConst intervals = doc["intervals"].as<JsonArrayConst>();
+
+    size_t bandCount = intervals.size();
+    if (bandCount < 1 || bandCount > SAMPLING_POLICY_MAX_BANDS || thresholds.size() != bandCount - 1) {
+        LOG_WARN("MQTT: Invalid sampling policy size");
+        return;
+    }
+
+    SamplingPolicy policy = {};
+    policy.bandCount = (uint8_t)bandCount;
+    for (size_t i = 0; i < bandCount; i++) {
+        long seconds = intervals[i].is<long>() ? intervals[i].as<long>() : 0;
+        if (seconds < SAMPLING_INTERVAL_MIN_S || seconds > SAMPLING_INTERVAL_MAX_S) {
+            LOG_WARN("MQTT: Invalid sampling policy interval");
+            return;
         }
+        policy.intervalsMs[i] = seconds * 1000UL;
     }
+    for (size_t i = 0; i + 1 < bandCount; i++) {
+        if (!thresholds[i].is<float>() || (i > 0 && thresholds[i].as<float>() <= policy.thresholds[i - 1])) {
+            LOG_WARN("MQTT: Invalid sampling policy thresholds");
+            return;
+        }
+        policy.thresholds[i] = thresholds[i].as<float>();
+    }
+
+    _newPolicy = policy;
+    _newPolicyAvailable = true;
+    LOG_INFO("MQTT: Sampling policy received, bands: %u", policy.bandCount);
 }
 
 void MqttManagerImpl::setup() {
     _mqttClient.setServer(_host, _port);
+    // Status reports do not fit in the default 256 byte packet buffer
+    _mqttClient.setBufferSize(MQTT_PACKET_BUFFER_SIZE);
     // Set callback function for _mqttClient PubSubClient library instance
     _mqttClient.setCallback(staticMqttCallback); 
-    Serial.print("MQTT Manager: Setup completed. Client ID: ");
-    Serial.println(_clientId);
+    LOG_INFO("MQTT Manager: Setup completed. Client ID: %s", _clientId);
 }
 
 bool MqttManagerImpl::connect() {
@@ -88,32 +190,36 @@ bool MqttManagerImpl::connect() {
         return true;
     }
 
-    Serial.print("MQTT: Connecting to ");
-    Serial.print(_host);
-    Serial.print(" as ");
-    Serial.println(_clientId);
+    LOG_INFO("MQTT: Connecting to %s as %s", _host, _clientId);
 
-    if (_mqttClient.connect(_clientId.c_str())) {
-        Serial.println("MQTT: Connected!");
+    // Config messages delivered from here on count towards isConfigSynced()
+    _configTopicsReceived = 0;
+    _connectTime = millis();
+
+    // No will; a persistent session makes the broker queue QoS 1 commands sent while offline
+    if (_mqttClient.connect(_clientId, nullptr, nullptr, nullptr, 0, false, nullptr, !MQTT_PERSISTENT_SESSION)) {
+        LOG_INFO("MQTT: Connected!");
         
-        // Subscribe to frequency topic
-        _mqttClient.subscribe(MQTT_TOPIC_CONFIG_F);
-        Serial.print("MQTT: Subscribed to ");
-        Serial.println(MQTT_TOPIC_CONFIG_F);
+        // Both config topics are retained, so the broker sends the current values after the
+        // subscriptions; subscribing again to an already persistent session is harmless
+        _mqttClient.subscribe(MQTT_TOPIC_CONFIG_F, 1);
+        LOG_INFO("MQTT: Subscribed to %s", MQTT_TOPIC_CONFIG_F);
+
+        _mqttClient.subscribe(MQTT_TOPIC_CONFIG_POLICY, 1);
+        LOG_INFO("MQTT: Subscribed to %s", MQTT_TOPIC_CONFIG_POLICY);
         
         // Send online status
         publishStatus("online");
         return true;
     } else {
-        Serial.print("MQTT: Connection failed, error: ");
-        Serial.println(_mqttClient.state());
+        LOG_WARN("MQTT: Connection failed, error: %d", _mqttClient.state());
         return false;
     }
 }
 
 void MqttManagerImpl::disconnect() {
     _mqttClient.disconnect();
-    Serial.println("MQTT: Disconnected");
+    LOG_INFO("MQTT: Disconnected");
 }
 
 bool MqttManagerImpl::isConnected() {
@@ -126,18 +232,103 @@ void MqttManagerImpl::loop() {
     }
 }
 
-bool MqttManagerImpl::publishTemperature(float temperature) {
+bool MqttManagerImpl::publishTemperature(const TemperatureSample& sample, uint32_t suppressed) {
     if (!isConnected()) {
         return false;
     }
 
-    // JSON format: {"temperature":XX.YY}
-    String payload = "{\"temperature\":" + String(temperature, 2) + "}";
+    if (TELEMETRY_BINARY_ENABLED) {
+        // 14 byte record instead of up to 70 bytes of JSON
+        uint8_t record[BINARY_TEMPERATURE_HEADER_LEN + BINARY_SAMPLE_ENTRY_LEN];
+        size_t length = BinaryTelemetry::encodeSamples(record, sizeof(record), &sample, 1, 0, suppressed);
+        return _mqttClient.publish(MQTT_TOPIC_TEMPERATURE_BINARY, record, length, true);
+    }
+
+    // JSON format: {"temperature":XX.YY,"ts":T,"seq":N,"sup":S}, with ,"ch":[XX.YY,...] before the
+    // closing brace for a multi-channel frame; "temperature" is then the control temperature of the frame
+    char payload[96 + TEMP_CHANNEL_JSON_MAX_LEN];
+    size_t length = snprintf(payload, sizeof(payload), "{\"temperature\":%.2f,\"ts\":%lu,\"seq\":%lu,\"sup\":%lu",
+                             sample.temperature, sample.timestampMs, (unsigned long)sample.sequence,
+                             (unsigned long)suppressed);
+    length += appendChannels(payload + length, sizeof(payload) - length, sample.frame);
+    if (length + 1 >= sizeof(payload)) {
+        return false;
+    }
+    snprintf(payload + length, sizeof(payload) - length, "}");
     
-    Serial.print("MQTT: Publishing temperature: ");
-    Serial.println(payload);
+    LOG_DEBUG("MQTT: Publishing temperature: %.2f, seq %lu", sample.temperature, sample.sequence);
     
-    return _mqttClient.publish(MQTT_TOPIC_TEMPERATURE, payload.c_str(), true);
+    return _mqttClient.publish(MQTT_TOPIC_TEMPERATURE, payload, true);
+}
+
+bool MqttManagerImpl::publishTemperatureBatch(const TemperatureSample* samples, size_t count, bool backlog) {
+    if (!isConnected() || count == 0 || count > TELEMETRY_BATCH_MAX_SAMPLES) {
+        return false;
+    }
+
+    if (TELEMETRY_BINARY_ENABLED) {
+        uint8_t record[BINARY_TEMPERATURE_HEADER_LEN + TELEMETRY_BATCH_MAX_SAMPLES * BINARY_SAMPLE_ENTRY_LEN];
+        uint8_t flags = BINARY_FLAG_BATCH | (backlog ? BINARY_FLAG_BACKLOG : 0);
+        size_t length = BinaryTelemetry::encodeSamples(record, sizeof(record), samples, count, flags, 0);
+        LOG_DEBUG("MQTT: Publishing binary %s of %u samples", backlog ? "backlog" : "batch", count);
+        return _mqttClient.publish(MQTT_TOPIC_TEMPERATURE_BINARY, record, length, false);
+    }
+
+    // JSON format: {"backlog":false,"samples":[{"ts":T1,"seq":N1,"t":XX.YY},{"ts":T2,"seq":N2,"t":XX.YY},...]}
+    // Entries of multi-channel frames end with ,"ch":[XX.YY,...] like single samples
+    char payload[TELEMETRY_BATCH_MAX_SAMPLES * TELEMETRY_BATCH_ENTRY_MAX_LEN + 32];
+    size_t length = snprintf(payload, sizeof(payload), "{\"backlog\":%s,\"samples\":[",
+                             backlog ? "true" : "false");
+
+    for (size_t i = 0; i < count && length < sizeof(payload); i++) {
+        length += snprintf(payload + length, sizeof(payload) - length, "%s{\"ts\":%lu,\"seq\":%lu,\"t\":%.2f",
+                           (i > 0) ? "," : "", samples[i].timestampMs,
+                           (unsigned long)samples[i].sequence, samples[i].temperature);
+        if (length < sizeof(payload)) {
+            length += appendChannels(payload + length, sizeof(payload) - length, samples[i].frame);
+        }
+        if (length < sizeof(payload)) {
+            length += snprintf(payload + length, sizeof(payload) - length, "}");
+        }
+    }
+    if (length < sizeof(payload)) {
+        length += snprintf(payload + length, sizeof(payload) - length, "]}");
+    }
+    if (length >= sizeof(payload)) {
+        return false; // Truncated, never publish malformed JSON
+    }
+
+    LOG_DEBUG("MQTT: Publishing %s of %u samples", backlog ? "backlog" : "batch", count);
+
+    // Not retained: a retained batch would be replayed to the backend on every reconnect
+    return _mqttClient.publish(MQTT_TOPIC_TEMPERATURE, payload, false);
+}
+
+bool MqttManagerImpl::publishTemperatureSummary(const WindowStatistics& statistics) {
+    if (!isConnected() || statistics.count == 0) {
+        return false;
+    }
+
+    // JSON format: {"ts":[first,last],"seq":[first,last],"n":N,"mean":XX.YYY,"var":V.VVVV,
+    //               "min":XX.YY,"max":XX.YY,"last":XX.YY,"raw":true}
+    // "raw" is false when the summaries are the only temperatures published
+    char payload[224];
+    int length = snprintf(payload, sizeof(payload),
+        "{\"ts\":[%lu,%lu],\"seq\":[%lu,%lu],\"n\":%lu,\"mean\":%.3f,\"var\":%.4f,"
+        "\"min\":%.2f,\"max\":%.2f,\"last\":%.2f,\"raw\":%s}",
+        statistics.firstTimestampMs, statistics.lastTimestampMs,
+        (unsigned long)statistics.firstSequence, (unsigned long)statistics.lastSequence,
+        (unsigned long)statistics.count, statistics.mean, statistics.variance(),
+        statistics.min, statistics.max, statistics.last,
+        STATS_RAW_SAMPLES_ENABLED ? "true" : "false");
+    if (length < 0 || length >= (int)sizeof(payload)) {
+        return false;
+    }
+
+    LOG_DEBUG("MQTT: Publishing summary of %lu samples", (unsigned long)statistics.count);
+
+    // Not retained: a retained summary would be counted again on every backend reconnect
+    return _mqttClient.publish(MQTT_TOPIC_STATS, payload, false);
 }
 
 bool MqttManagerImpl::publishStatus(const char* statusMessage) {
@@ -145,16 +336,120 @@ bool MqttManagerImpl::publishStatus(const char* statusMessage) {
         return false;
     }
 
+    if (TELEMETRY_BINARY_ENABLED) {
+        uint8_t record[BINARY_STATUS_HEADER_LEN];
+        size_t length = BinaryTelemetry::encodeStatus(record, sizeof(record), statusMessage, nullptr, HeapMetrics());
+        return _mqttClient.publish(MQTT_TOPIC_STATUS_BINARY, record, length, true);
+    }
+
     // JSON format: {"status":"message"}
-    String payload = "{\"status\":\"" + String(statusMessage) + "\"}";
+    char payload[64];
+    int length = snprintf(payload, sizeof(payload), "{\"status\":\"%s\"}", statusMessage);
+    if (length < 0 || length >= (int)sizeof(payload)) {
+        return false;
+    }
     
-    return _mqttClient.publish(MQTT_TOPIC_STATUS, payload.c_str(), true);
+    return _mqttClient.publish(MQTT_TOPIC_STATUS, payload, true);
+}
+
+bool MqttManagerImpl::publishStatusReport(const StatusReport& report) {
+    if (!isConnected()) {
+        return false;
+    }
+
+    HeapMetrics heap = {ESP.getFreeHeap(), ESP.getMinFreeHeap(), ESP.getMaxAllocHeap()};
+
+    if (TELEMETRY_BINARY_ENABLED) {
+        uint8_t record[BINARY_STATUS_HEADER_LEN + BINARY_STATUS_FIELD_COUNT * 4];
+        size_t length = BinaryTelemetry::encodeStatus(record, sizeof(record), report.status, &report, heap);
+        return _mqttClient.publish(MQTT_TOPIC_STATUS_BINARY, record, length, true);
+    }
+
+    // JSON format: {"status":"message","uptime_ms":N,...,"wifi":{...}}
+    // Heap figures let the backend verify that steady-state operation does not allocate
+    char payload[608];
+    int length = snprintf(payload, sizeof(payload),
+        "{\"status\":\"%s\",\"uptime_ms\":%lu,\"boot_to_operational_ms\":%lu,"
+        "\"connect_to_operational_ms\":%lu,\"backlog_samples\":%lu,\"lost_samples\":%lu,"
+        "\"sampling_overruns\":%lu,\"free_heap\":%lu,\"min_free_heap\":%lu,\"max_alloc_heap\":%lu,"
+        "\"wifi\":{\"fast_path\":%s,\"fallback\":%s,\"association_ms\":%lu,"
+        "\"ip_config_ms\":%lu,\"total_ms\":%lu},"
+        "\"deep_sleep\":{\"cycles\":%lu,\"wake_to_publish_ms\":%lu,\"budget_overruns\":%lu},"
+        "\"reconnect\":{\"failures\":%lu,\"backoff_ms\":%lu},"
+        "\"suppressed_samples\":%lu}",
+        report.status, report.uptimeMs, report.bootToOperationalMs,
+        report.connectToOperationalMs, report.backlogSamples, report.lostSamples,
+        report.samplingOverruns,
+        (unsigned long)heap.freeHeap, (unsigned long)heap.minFreeHeap, (unsigned long)heap.maxAllocHeap,
+        report.wifi.fastPath ? "true" : "false",
+        report.wifi.fastPathFallback ? "true" : "false",
+        report.wifi.associationMs, report.wifi.ipConfigMs, report.wifi.totalMs,
+        report.deepSleepCycles, report.wakeToPublishMs, report.wakeBudgetOverruns,
+        report.reconnectFailures, report.reconnectBackoffMs,
+        report.suppressedSamples);
+
+    if (length < 0 || length >= (int)sizeof(payload)) {
+        return false;
+    }
+
+    return _mqttClient.publish(MQTT_TOPIC_STATUS, payload, true);
+}
+
+bool MqttManagerImpl::publishLoopMetrics(const LoopProfiler& profiler, unsigned long windowMs) {
+    if (!isConnected()) {
+        return false;
+    }
+
+    // JSON format: {"window_ms":N,"slots":{"operational":[count,min_us,p50_us,p99_us,max_us],...}}
+    // Slots without samples in the window are left out
+    char payload[LOOP_METRICS_PAYLOAD_SIZE];
+    size_t length = snprintf(payload, sizeof(payload), "{\"window_ms\":%lu,\"slots\":{", windowMs);
+
+    bool first = true;
+    for (uint8_t slot = 0; slot < LOOP_PROFILE_SLOT_COUNT && length < sizeof(payload); slot++) {
+        LatencySummary summary;
+        profiler.summarize(slot, summary);
+        if (summary.count == 0) {
+            continue;
+        }
+        length += snprintf(payload + length, sizeof(payload) - length, "%s\"%s\":[%lu,%lu,%lu,%lu,%lu]",
+                           first ? "" : ",", LoopProfiler::slotName(slot), (unsigned long)summary.count,
+                           (unsigned long)summary.minUs, (unsigned long)summary.p50Us,
+                           (unsigned long)summary.p99Us, (unsigned long)summary.maxUs);
+        first = false;
+    }
+    if (length < sizeof(payload)) {
+        length += snprintf(payload + length, sizeof(payload) - length, "}}");
+    }
+    if (length >= sizeof(payload)) {
+        return false; // Truncated, never publish malformed JSON
+    }
+
+    return _mqttClient.publish(MQTT_TOPIC_METRICS, payload, false);
 }
 
-unsigned long MqttManagerImpl::getNewSamplingIntervalMs() {
-    if (_newIntervalAvailable) {
-        _newIntervalAvailable = false;
-        return _newSamplingInterval;
+unsigned long MqttManagerImpl::getConfigMessageCount() const {
+    return _configMessageCount;
+}
+
+bool MqttManagerImpl::isConfigSynced() const {
+    return _configTopicsReceived == CONFIG_TOPIC_ALL;
+}
+
+bool MqttManagerImpl::getNewSamplingIntervalMs(unsigned long& intervalMs) {
+    if (!_newIntervalAvailable) {
+        return false;
+    }
+    _newIntervalAvailable = false;
+    intervalMs = _newSamplingInterval;
+    return true;
+}
+
+bool MqttManagerImpl::getNewSamplingPolicy(SamplingPolicy& policy) {
+    if (!_newPolicyAvailable) {
+        return false;
     }
-    return 0;
+    _newPolicyAvailable = false;
+    policy = _newPolicy;
+    return true;
 }
\ No newline at end of file
@@ -1,54 +1,115 @@
 #include "../api/WifiManagerImpl.h"
+#include "../../api/Log.h"
 #include <Arduino.h>
 
+// NVS key of the fast-connect cache blob
+static const char* CACHE_KEY = "fast";
+
 WifiManagerImpl::WifiManagerImpl(const char* ssid, const char* password)
-    : _ssid(ssid), _password(password) {
+    : _ssid(ssid),
+      _password(password),
+      _connectStatus(WIFI_CONNECT_IDLE),
+      _connectStartTime(0),
+      _attemptStartTime(0),
+      _cache(),
+      _cacheValid(false),
+      _fastPathActive(false),
+      _fastPathFailed(false),
+      _associatedTime(0),
+      _gotIpTime(0),
+      _metrics() {
     // Constructor set WiFi credentials
 }
 
 void WifiManagerImpl::setup() {
     WiFi.mode(WIFI_STA); // Set ESP32 to Station mode (WiFi client)
-    Serial.println("WiFi Manager: Setup completed");
+    WiFi.persistent(false); // Connection parameters are cached by this class, not by the driver
+
+    // Record association and IP configuration times for the connect metrics
+    WiFi.onEvent([this](arduino_event_id_t event, arduino_event_info_t) {
+        if (event == ARDUINO_EVENT_WIFI_STA_CONNECTED) {
+            _associatedTime = millis();
+        } else if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+            _gotIpTime = millis();
+        }
+    });
+
+    loadCache();
+    LOG_INFO("WiFi Manager: Setup completed. Fast-connect cache: %s", _cacheValid ? "valid" : "empty");
 }
 
-bool WifiManagerImpl::connect() {
-    Serial.print("WiFi: Attempting connection to SSID: '");
-    Serial.print(_ssid);
-    Serial.println("'");
+bool WifiManagerImpl::beginConnect() {
+    LOG_INFO("WiFi: Attempting connection to SSID: '%s'", _ssid);
 
     // If already connected, don't reconnect
     if (isConnected()) {
-        Serial.println("WiFi: Already connected");
+        LOG_INFO("WiFi: Already connected");
         if (WiFi.localIP()) { // Check if IP is valid (not 0.0.0.0)
-            Serial.print("WiFi: Current IP address: ");
-            Serial.println(WiFi.localIP());
+            LOG_INFO("WiFi: Current IP address: %u.%u.%u.%u",
+                     WiFi.localIP()[0], WiFi.localIP()[1], WiFi.localIP()[2], WiFi.localIP()[3]);
         }
+        _connectStatus = WIFI_CONNECT_SUCCESS;
         return true;
     }
 
-    // Start connection attempt
-    WiFi.begin(_ssid, _password);
+    // Start connection attempt, completion is checked by pollConnect()
+    _connectStartTime = millis();
+    _fastPathFailed = false;
+    startAttempt(_cacheValid);
+    _connectStatus = WIFI_CONNECT_PENDING;
 
-    unsigned long startTime = millis();
-    // Wait for connection or timeout
-    while (WiFi.status() != WL_CONNECTED) {
-        if (millis() - startTime > WIFI_CONNECT_TIMEOUT_MS) {
-            Serial.println("\nWiFi: Connection attempt timed out");
-            WiFi.disconnect(); // Ensure disconnection on timeout
-            return false;
-        }
-        delay(500);        // Pause between status checks
-        Serial.print("."); // Visual feedback of connection attempt
-    }
-    
-    // Connection successful
-    Serial.println("\nWiFi: Connected successfully!");
-    Serial.print("WiFi: IP address: ");
-    Serial.println(WiFi.localIP());
-    
     return true;
 }
 
+WifiConnectStatus WifiManagerImpl::pollConnect() {
+    if (_connectStatus != WIFI_CONNECT_PENDING) {
+        return _connectStatus;
+    }
+
+    wl_status_t status = WiFi.status();
+    unsigned long currentTime = millis();
+    unsigned long timeout = _fastPathActive ? WIFI_FAST_CONNECT_TIMEOUT_MS : WIFI_CONNECT_TIMEOUT_MS;
+
+    if (status == WL_CONNECTED) {
+        // Connection successful
+        unsigned long associatedTime = _associatedTime;
+        unsigned long gotIpTime = _gotIpTime;
+        if (gotIpTime < _attemptStartTime) gotIpTime = currentTime;
+        if (associatedTime < _attemptStartTime || associatedTime > gotIpTime) associatedTime = gotIpTime;
+
+        _metrics.associationMs = associatedTime - _attemptStartTime;
+        _metrics.ipConfigMs = gotIpTime - associatedTime;
+        _metrics.totalMs = gotIpTime - _connectStartTime;
+        _metrics.fastPath = _fastPathActive;
+        _metrics.fastPathFallback = _fastPathFailed;
+
+        LOG_INFO("WiFi: Connected successfully in %lu ms%s", _metrics.totalMs, _fastPathActive ? " (fast path)" : "");
+        LOG_INFO("WiFi: IP address: %u.%u.%u.%u",
+                 WiFi.localIP()[0], WiFi.localIP()[1], WiFi.localIP()[2], WiFi.localIP()[3]);
+
+        saveCache();
+        _connectStatus = WIFI_CONNECT_SUCCESS;
+    } else if (_fastPathActive && (status == WL_CONNECT_FAILED || currentTime - _attemptStartTime > timeout)) {
+        // Cached hints are stale (AP moved channel, lease taken...): retry with a full scan
+        LOG_WARN("WiFi: Fast connect failed, falling back to full scan");
+        invalidateCache();
+        WiFi.disconnect();
+        _fastPathFailed = true;
+        startAttempt(false);
+    } else if (status == WL_CONNECT_FAILED) {
+        // Rejected by the access point (e.g. wrong password), no point in waiting
+        LOG_WARN("WiFi: Connection rejected by access point");
+        WiFi.disconnect();
+        _connectStatus = WIFI_CONNECT_FAILED;
+    } else if (currentTime - _attemptStartTime > timeout) {
+        LOG_WARN("WiFi: Connection attempt timed out");
+        WiFi.disconnect(); // Ensure disconnection on timeout
+        _connectStatus = WIFI_CONNECT_FAILED;
+    }
+
+    return _connectStatus;
+}
+
 bool WifiManagerImpl::isConnected() {
     return (WiFi.status() == WL_CONNECTED);
 }
@@ -60,6 +121,86 @@ IPAddress WifiManagerImpl::getLocalIP() {
     return IPAddress(0, 0, 0, 0); // Return null IP if not connected
 }
 
+const WifiConnectMetrics& WifiManagerImpl::getConnectMetrics() const {
+    return _metrics;
+}
+
 void WifiManagerImpl::disconnect() {
     WiFi.disconnect(true); // Parameter 'true' also disables WiFi radio
-}
\ No newline at end of file
+    _connectStatus = WIFI_CONNECT_IDLE;
+}
+
+void WifiManagerImpl::startAttempt(bool useFastPath) {
+    _associatedTime = 0;
+    _gotIpTime = 0;
+    _attemptStartTime = millis();
+    _fastPathActive = useFastPath;
+
+    if (useFastPath) {
+        // Reuse the last lease as static IP and skip the scan with BSSID + channel
+        WiFi.config(IPAddress(_cache.localIp), IPAddress(_cache.gateway),
+                    IPAddress(_cache.subnet), IPAddress(_cache.dns));
+        WiFi.begin(_ssid, _password, _cache.channel, _cache.bssid);
+    } else {
+        // All-zero configuration re-enables DHCP
+        WiFi.config(IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0));
+        WiFi.begin(_ssid, _password);
+    }
+}
+
+void WifiManagerImpl::loadCache() {
+    _cacheValid = false;
+
+    if (!_preferences.begin(WIFI_NVS_NAMESPACE, true)) {
+        return; // Namespace does not exist yet
+    }
+    if (_preferences.getBytesLength(CACHE_KEY) == sizeof(_cache)) {
+        _preferences.getBytes(CACHE_KEY, &_cache, sizeof(_cache));
+        _cacheValid = (_cache.ssidHash == hashString(_ssid) && _cache.channel > 0 && _cache.localIp != 0);
+    }
+    _preferences.end();
+}
+
+void WifiManagerImpl::saveCache() {
+    FastConnectCache current = {};
+    current.ssidHash = hashString(_ssid);
+    const uint8_t* bssid = WiFi.BSSID();
+    if (bssid) {
+        memcpy(current.bssid, bssid, sizeof(current.bssid));
+    }
+    current.channel = WiFi.channel();
+    current.localIp = (uint32_t)WiFi.localIP();
+    current.gateway = (uint32_t)WiFi.gatewayIP();
+    current.subnet = (uint32_t)WiFi.subnetMask();
+    current.dns = (uint32_t)WiFi.dnsIP();
+
+    // Avoid flash wear: only write when the parameters actually changed
+    if (_cacheValid && memcmp(&current, &_cache, sizeof(current)) == 0) {
+        return;
+    }
+
+    if (_preferences.begin(WIFI_NVS_NAMESPACE, false)) {
+        _preferences.putBytes(CACHE_KEY, &current, sizeof(current));
+        _preferences.end();
+        _cache = current;
+        _cacheValid = true;
+        LOG_INFO("WiFi: Fast-connect cache updated");
+    }
+}
+
+void WifiManagerImpl::invalidateCache() {
+    _cacheValid = false;
+    if (_preferences.begin(WIFI_NVS_NAMESPACE, false)) {
+        _preferences.remove(CACHE_KEY);
+        _preferences.end();
+    }
+}
+
+uint32_t WifiManagerImpl::hashString(const char* str) {
+    uint32_t hash = 2166136261u;
+    while (*str) {
+        hash ^= (uint8_t)*str++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
@@ -1,21 +1,78 @@
 #include "../api/FsmManagerImpl.h"
+#include "../api/ChipId.h"
+#include "../api/Log.h"
 #include <Arduino.h>
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
 
-FsmManagerImpl::FsmManagerImpl(LedStatus& ledCtrl, TemperatureManager& tempCtrl, WifiManager& wifiCtrl, MqttManager& mqttCtrl)
+// Backlog chunks are published through publishTemperatureBatch()
+static_assert(STORE_FORWARD_DRAIN_BATCH <= TELEMETRY_BATCH_MAX_SAMPLES,
+              "STORE_FORWARD_DRAIN_BATCH must not exceed TELEMETRY_BATCH_MAX_SAMPLES");
+// The batch buffer is in RAM, which does not survive deep sleep
+static_assert(!(DEEP_SLEEP_ENABLED && TELEMETRY_BATCH_ENABLED),
+              "DEEP_SLEEP_ENABLED requires TELEMETRY_BATCH_ENABLED 0");
+// Without raw samples the summaries carry the readings the backend acts on
+static_assert(STATS_RAW_SAMPLES_ENABLED || (STATS_WINDOW_ENABLED && STATS_WINDOW_MS <= PUBLISH_HEARTBEAT_MS),
+              "STATS_RAW_SAMPLES_ENABLED 0 requires STATS_WINDOW_ENABLED and STATS_WINDOW_MS <= PUBLISH_HEARTBEAT_MS");
+// A duty-cycled node sleeps once its sample is published
+static_assert(!(DEEP_SLEEP_ENABLED && !STATS_RAW_SAMPLES_ENABLED),
+              "DEEP_SLEEP_ENABLED requires STATS_RAW_SAMPLES_ENABLED 1");
+
+FsmManagerImpl::FsmManagerImpl(LedStatus& ledCtrl, SampleSource& source, WifiManager& wifiCtrl, MqttManager& mqttCtrl,
+                               SampleStore& store, LoopProfiler* profiler, PowerManager* power)
     : ledController(ledCtrl),
-      tempController(tempCtrl),
+      sampleSource(source),
       wifiController(wifiCtrl),
       mqttController(mqttCtrl),
+      sampleStore(store),
+      loopProfiler(profiler),
+      powerManager(power),
       _currentState(STATE_INITIALIZING),
-      _lastTempSampleTime(0),
       _lastMqttAttemptTime(0),
       _lastWiFiAttemptTime(0),
-      _currentTemperature(0.0f),
-      _currentSamplingIntervalMs(TEMP_SAMPLE_INTERVAL_DEFAULT_MS) {}
+      _connectStartTime(0),
+      _bootToOperationalMs(0),
+      _connectToOperationalMs(0),
+      _wifiBackoff(WIFI_RECONNECT_INTERVAL_MS, WIFI_RECONNECT_MAX_INTERVAL_MS),
+      _mqttBackoff(MQTT_RECONNECT_INTERVAL_MS, MQTT_RECONNECT_MAX_INTERVAL_MS),
+      _reconnectFailures(0),
+      _reconnectBackoffMs(0),
+      _lastBacklogDrainTime(0),
+      _lastStatusReportTime(0),
+      _lastLoopMetricsTime(0),
+      _loopMetricsWindowStart(0),
+      _lastSample(),
+      _currentSamplingIntervalMs(TEMP_SAMPLE_INTERVAL_DEFAULT_MS),
+      _samplingPolicy(),
+      _intervalOverridden(false),
+      _operationalSinceTime(0),
+      _publishedSinceWake(false),
+      _dutyCycle(),
+      _hasReportedSample(false),
+      _lastReportedSample(),
+      _suppressedSinceReport(0),
+      _suppressedSamples(0),
+      _statistics() {}
 
 void FsmManagerImpl::setup() {
-    Serial.println("FSM Manager: Setup. Initial state: INITIALIZING");
+    LOG_INFO("FSM Manager: Setup. Initial state: INITIALIZING");
     _lastWiFiAttemptTime = millis(); // Initialize timer for first WiFi attempt
+
+    // Per-device jitter, so a fleet that lost the broker together does not retry together
+    _wifiBackoff.seed(chipId());
+    _mqttBackoff.seed(~chipId());
+
+    // Continue the previous duty cycle; runs before the sample source is started
+    if (powerManager && powerManager->loadState(_dutyCycle)) {
+        _samplingPolicy = _dutyCycle.samplingPolicy;
+        _intervalOverridden = _dutyCycle.intervalOverridden;
+        setSamplingInterval(_dutyCycle.samplingIntervalMs);
+        sampleSource.setNextSequence(_dutyCycle.nextSequence);
+        _statistics = _dutyCycle.statistics;
+        LOG_INFO("FSM Manager: Woke from deep sleep %lu, next sample seq %lu",
+                 _dutyCycle.sleepCycles, (unsigned long)_dutyCycle.nextSequence);
+    }
 }
 
 SystemState FsmManagerImpl::getCurrentState() const {
@@ -23,7 +80,7 @@ SystemState FsmManagerImpl::getCurrentState() const {
 }
 
 float FsmManagerImpl::getCurrentTemperature() const {
-    return _currentTemperature;
+    return _lastSample.temperature;
 }
 
 unsigned long FsmManagerImpl::getCurrentSamplingInterval() const {
@@ -31,10 +88,39 @@ unsigned long FsmManagerImpl::getCurrentSamplingInterval() const {
 }
 
 void FsmManagerImpl::checkAndUpdateSamplingInterval() {
-    unsigned long newInterval = mqttController.getNewSamplingIntervalMs();
-    if (newInterval > 0) {
-        _currentSamplingIntervalMs = newInterval;
+    // A new policy takes effect with the next sample
+    if (mqttController.getNewSamplingPolicy(_samplingPolicy)) {
+        LOG_INFO("FSM Manager: Sampling policy updated, bands: %u", _samplingPolicy.bandCount);
+    }
+
+    unsigned long newInterval;
+    if (mqttController.getNewSamplingIntervalMs(newInterval)) {
+        _intervalOverridden = newInterval > 0;
+        if (_intervalOverridden) {
+            LOG_INFO("FSM Manager: Sampling interval overridden by backend");
+            setSamplingInterval(newInterval);
+        } else {
+            LOG_INFO("FSM Manager: Sampling interval override cleared, policy resumes");
+        }
+    }
+}
+
+void FsmManagerImpl::applySamplingPolicy(float temperature) {
+    if (_intervalOverridden || _samplingPolicy.bandCount == 0) {
+        return;
     }
+
+    uint8_t band = _samplingPolicy.bandFor(temperature);
+    unsigned long interval = _samplingPolicy.intervalsMs[band];
+    if (interval != _currentSamplingIntervalMs) {
+        LOG_INFO("FSM Manager: Temperature band %u, sampling interval -> %lu ms", band, interval);
+        setSamplingInterval(interval);
+    }
+}
+
+void FsmManagerImpl::setSamplingInterval(unsigned long intervalMs) {
+    _currentSamplingIntervalMs = intervalMs;
+    sampleSource.setIntervalMs(intervalMs);
 }
 
 void FsmManagerImpl::run() {
@@ -43,11 +129,22 @@ void FsmManagerImpl::run() {
     // Check for new sampling interval configuration
     checkAndUpdateSamplingInterval();
 
+    // Keep sampling into the store-and-forward queue while samples cannot be published
+    if (_currentState != STATE_OPERATIONAL &&
+        _currentState != STATE_SAMPLING_TEMPERATURE &&
+        _currentState != STATE_SENDING_DATA) {
+        sampleOfflineIfDue(currentTime);
+    }
+
     switch (_currentState) {
         case STATE_INITIALIZING:
             handleInitializingState();
             break;
 
+        case STATE_WIFI_CONNECTING:
+            handleWiFiConnectingState(currentTime);
+            break;
+
         case STATE_WIFI_CONNECTED:
             handleWiFiConnectedState();
             break;
@@ -65,7 +162,7 @@ void FsmManagerImpl::run() {
             break;
 
         case STATE_SENDING_DATA:
-            handleSendingDataState();
+            handleSendingDataState(currentTime);
             break;
 
         case STATE_NETWORK_ERROR:
@@ -77,111 +174,462 @@ void FsmManagerImpl::run() {
             break;
 
         default:
-            Serial.println("FSM Manager: Unknown state. Returning to INITIALIZING.");
+            LOG_WARN("FSM Manager: Unknown state. Returning to INITIALIZING.");
             ledController.indicateNetworkError();
             _currentState = STATE_INITIALIZING;
             break;
     }
 }
 
+namespace {
+
+/**
+ * @brief Lowers a pending wait to the time left until a deadline (0 if already due).
+ *
+ * Waits are kept relative to currentTime so the comparison survives the millis() wrap.
+ */
+void waitUntil(unsigned long& wait, unsigned long currentTime, unsigned long deadline) {
+    long remaining = (long)(deadline - currentTime);
+    unsigned long until = remaining > 0 ? (unsigned long)remaining : 0;
+    if (until < wait) {
+        wait = until;
+    }
+}
+
+} // namespace
+
+unsigned long FsmManagerImpl::getNextDeadline(unsigned long currentTime) const {
+    unsigned long wait = ULONG_MAX;
+
+    switch (_currentState) {
+        case STATE_WIFI_CONNECTING:
+            // Connection progress is polled from the WiFi driver
+            waitUntil(wait, currentTime, currentTime + IDLE_POLL_INTERVAL_MS);
+            break;
+
+        case STATE_MQTT_CONNECTING:
+            waitUntil(wait, currentTime, _lastMqttAttemptTime + _mqttBackoff.getDelayMs());
+            waitUntil(wait, currentTime, currentTime + IDLE_POLL_INTERVAL_MS); // WiFi loss, retained config
+            break;
+
+        case STATE_OPERATIONAL:
+            // Incoming config messages and link loss are only seen by polling
+            waitUntil(wait, currentTime, currentTime + IDLE_POLL_INTERVAL_MS);
+            waitUntil(wait, currentTime, _lastStatusReportTime + STATUS_REPORT_INTERVAL_MS);
+            if (LOOP_PROFILING_ENABLED && loopProfiler) {
+                waitUntil(wait, currentTime, _lastLoopMetricsTime + LOOP_METRICS_INTERVAL_MS);
+            }
+            if (sampleStore.size() > 0) {
+                waitUntil(wait, currentTime, _lastBacklogDrainTime + STORE_FORWARD_DRAIN_INTERVAL_MS);
+            }
+            if (STATS_WINDOW_ENABLED && _statistics.count > 0) {
+                // Back from the duty-cycle clock to millis(); the window may have opened before this wake
+                waitUntil(wait, currentTime, _statistics.firstTimestampMs - _dutyCycle.clockOffsetMs + STATS_WINDOW_MS);
+            }
+            if (TELEMETRY_BATCH_ENABLED && !_sampleBatch.isEmpty()) {
+                waitUntil(wait, currentTime, _sampleBatch.at(0).timestampMs + TELEMETRY_BATCH_MAX_AGE_MS);
+            }
+            waitUntil(wait, currentTime, sampleSource.getNextSampleTime(currentTime));
+            break;
+
+        case STATE_WAIT_RECONNECT:
+            waitUntil(wait, currentTime, _lastWiFiAttemptTime + _wifiBackoff.getDelayMs());
+            break;
+
+        default:
+            // Transient states move on in the next run()
+            return currentTime;
+    }
+
+    // Samples are still taken into the store-and-forward queue while offline
+    if (_currentState != STATE_OPERATIONAL) {
+        waitUntil(wait, currentTime, sampleSource.getNextSampleTime(currentTime));
+    }
+    return currentTime + wait;
+}
+
 void FsmManagerImpl::handleInitializingState() {
-    Serial.println("FSM Manager: STATE_INITIALIZING -> Attempting WiFi connection");
+    LOG_INFO("FSM Manager: STATE_INITIALIZING -> Attempting WiFi connection");
     ledController.indicateWifiConnecting();
+    _connectStartTime = millis();
     
-    if (wifiController.connect()) {
-        _currentState = STATE_WIFI_CONNECTED;
-        Serial.println("FSM Manager: WiFi Connected -> STATE_WIFI_CONNECTED");
+    if (wifiController.beginConnect()) {
+        _currentState = STATE_WIFI_CONNECTING;
+        LOG_INFO("FSM Manager: -> STATE_WIFI_CONNECTING");
     } else {
-        Serial.println("FSM Manager: WiFi connection failed -> STATE_NETWORK_ERROR");
+        LOG_WARN("FSM Manager: WiFi connection could not be started -> STATE_NETWORK_ERROR");
         ledController.indicateNetworkError();
         _currentState = STATE_NETWORK_ERROR;
         _lastWiFiAttemptTime = millis();
     }
 }
 
+void FsmManagerImpl::handleWiFiConnectingState(unsigned long currentTime) {
+    // Non-blocking: only check progress, the attempt runs in the WiFi driver
+    switch (wifiController.pollConnect()) {
+        case WIFI_CONNECT_SUCCESS:
+            _currentState = STATE_WIFI_CONNECTED;
+            LOG_INFO("FSM Manager: WiFi Connected -> STATE_WIFI_CONNECTED");
+            break;
+
+        case WIFI_CONNECT_PENDING:
+            ledController.indicateWifiConnecting();
+            break;
+
+        default:
+            LOG_WARN("FSM Manager: WiFi connection failed -> STATE_NETWORK_ERROR");
+            ledController.indicateNetworkError();
+            _currentState = STATE_NETWORK_ERROR;
+            _lastWiFiAttemptTime = currentTime;
+            break;
+    }
+}
+
 void FsmManagerImpl::handleWiFiConnectedState() {
-    Serial.println("FSM Manager: STATE_WIFI_CONNECTED -> Attempting MQTT connection");
+    LOG_INFO("FSM Manager: STATE_WIFI_CONNECTED -> Attempting MQTT connection");
     ledController.indicateMqttConnecting();
     _currentState = STATE_MQTT_CONNECTING;
-    _lastMqttAttemptTime = 0; // Force immediate MQTT attempt
+    // Force an immediate MQTT attempt; the network error wait before it was already jittered
+    _lastMqttAttemptTime = millis() - _mqttBackoff.getDelayMs();
 }
 
 void FsmManagerImpl::handleMqttConnectingState(unsigned long currentTime) {
-    if (mqttController.isConnected()) {
-        Serial.println("FSM Manager: MQTT Connected -> STATE_OPERATIONAL");
-        mqttController.publishStatus("online");
+    bool connected = mqttController.isConnected();
+    if (connected && !mqttController.isConfigSynced() &&
+        currentTime - _lastMqttAttemptTime < MQTT_CONFIG_SYNC_TIMEOUT_MS) {
+        // The retained config arrives one broker round trip after connecting; run() applies it
+        // before this handler, so waiting for it makes the first operational sample use it
+    } else if (connected) {
+        if (!mqttController.isConfigSynced()) {
+            LOG_WARN("FSM Manager: No retained config received, keeping the current sampling interval");
+        }
+        LOG_INFO("FSM Manager: MQTT Connected -> STATE_OPERATIONAL");
+        _connectToOperationalMs = currentTime - _connectStartTime;
+        if (_bootToOperationalMs == 0) {
+            _bootToOperationalMs = currentTime; // millis() counts from boot
+        }
+        LOG_INFO("FSM Manager: Connected in %lu ms", _connectToOperationalMs);
+
+        // Reported until the next outage, then the backoff starts over from the base intervals
+        _reconnectFailures = _wifiBackoff.getFailures() + _mqttBackoff.getFailures();
+        _reconnectBackoffMs = _wifiBackoff.getLongestDelayMs() > _mqttBackoff.getLongestDelayMs() ?
+                              _wifiBackoff.getLongestDelayMs() : _mqttBackoff.getLongestDelayMs();
+        _wifiBackoff.reset();
+        _mqttBackoff.reset();
+        publishStatusReport(currentTime);
         ledController.indicateOperational();
         _currentState = STATE_OPERATIONAL;
-    } else if (currentTime - _lastMqttAttemptTime >= MQTT_RECONNECT_INTERVAL_MS) {
-        Serial.println("FSM Manager: Retrying MQTT connection...");
+        _operationalSinceTime = currentTime;
+        _hasReportedSample = false; // The backend may have missed samples while the link was down
+    } else if (currentTime - _lastMqttAttemptTime >= _mqttBackoff.getDelayMs()) {
+        LOG_INFO("FSM Manager: Retrying MQTT connection...");
         ledController.indicateMqttConnecting();
         
         if (wifiController.isConnected()) {
             if (!mqttController.connect()) {
-                Serial.println("FSM Manager: MQTT attempt failed, waiting for next interval.");
+                unsigned long retryMs = _mqttBackoff.fail();
+                LOG_WARN("FSM Manager: MQTT attempt failed, retrying in %lu ms.", retryMs);
             }
         } else {
-            Serial.println("FSM Manager: WiFi lost before MQTT attempt.");
+            LOG_WARN("FSM Manager: WiFi lost before MQTT attempt.");
         }
         _lastMqttAttemptTime = currentTime;
     }
 
     // Check if WiFi was lost during MQTT connection attempts
     if (!wifiController.isConnected()) {
-        Serial.println("FSM Manager: WiFi lost during MQTT attempt -> STATE_NETWORK_ERROR");
+        LOG_WARN("FSM Manager: WiFi lost during MQTT attempt -> STATE_NETWORK_ERROR");
         ledController.indicateNetworkError();
         _currentState = STATE_NETWORK_ERROR;
         _lastWiFiAttemptTime = currentTime;
     }
 }
 
+void FsmManagerImpl::publishStatusReport(unsigned long currentTime) {
+    StatusReport report = {};
+    report.status = "online";
+    report.uptimeMs = currentTime;
+    report.bootToOperationalMs = _bootToOperationalMs;
+    report.connectToOperationalMs = _connectToOperationalMs;
+    report.reconnectFailures = _reconnectFailures;
+    report.reconnectBackoffMs = _reconnectBackoffMs;
+    report.backlogSamples = sampleStore.size();
+    report.lostSamples = sampleStore.getLostSampleCount();
+    report.samplingOverruns = sampleSource.getOverrunCount();
+    report.wifi = wifiController.getConnectMetrics();
+    report.deepSleepCycles = _dutyCycle.sleepCycles;
+    report.wakeToPublishMs = _dutyCycle.wakeToPublishMs;
+    report.wakeBudgetOverruns = _dutyCycle.wakeBudgetOverruns;
+    report.suppressedSamples = _suppressedSamples;
+
+    mqttController.publishStatusReport(report);
+    _lastStatusReportTime = currentTime;
+}
+
+void FsmManagerImpl::publishLoopMetrics(unsigned long currentTime) {
+    _lastLoopMetricsTime = currentTime;
+
+    // On failure the histograms keep accumulating into the next report
+    if (mqttController.publishLoopMetrics(*loopProfiler, currentTime - _loopMetricsWindowStart)) {
+        loopProfiler->reset();
+        _loopMetricsWindowStart = currentTime;
+    }
+}
+
 void FsmManagerImpl::handleOperationalState(unsigned long currentTime) {
     ledController.indicateOperational();
     
     // Check for connection loss
     if (!wifiController.isConnected() || !mqttController.isConnected()) {
-        Serial.println("FSM Manager: Connection lost (WiFi or MQTT) -> STATE_NETWORK_ERROR");
+        LOG_WARN("FSM Manager: Connection lost (WiFi or MQTT) -> STATE_NETWORK_ERROR");
         ledController.indicateNetworkError();
         _currentState = STATE_NETWORK_ERROR;
         _lastWiFiAttemptTime = currentTime;
         return;
     }
 
-    // Check if it's time to sample temperature
-    if (currentTime - _lastTempSampleTime >= _currentSamplingIntervalMs) {
+    // Periodic status report (heap watermark, backlog, connection metrics)
+    if (currentTime - _lastStatusReportTime >= STATUS_REPORT_INTERVAL_MS) {
+        publishStatusReport(currentTime);
+    }
+
+    // Periodic loop timing report (per-state run() and MQTT loop() latency)
+    if (LOOP_PROFILING_ENABLED && loopProfiler && currentTime - _lastLoopMetricsTime >= LOOP_METRICS_INTERVAL_MS) {
+        publishLoopMetrics(currentTime);
+    }
+
+    // Forward samples queued during an outage without flooding the broker
+    drainBacklogIfDue(currentTime);
+
+    // Close the statistics window before the next sample can fall into it
+    if (STATS_WINDOW_ENABLED) {
+        publishStatisticsIfDue(currentTime);
+    }
+
+    // Publish a partially filled batch once its oldest sample gets too old
+    if (TELEMETRY_BATCH_ENABLED) {
+        flushSampleBatchIfDue(currentTime);
+    }
+
+    // Check if a temperature sample is due (or already taken by the sampling task)
+    if (sampleSource.sampleReady(currentTime)) {
         _currentState = STATE_SAMPLING_TEMPERATURE;
-        Serial.println("FSM Manager: -> STATE_SAMPLING_TEMPERATURE");
+        LOG_DEBUG("FSM Manager: -> STATE_SAMPLING_TEMPERATURE");
+        return;
     }
+
+    deepSleepIfIdle(currentTime);
 }
 
 void FsmManagerImpl::handleSamplingTemperatureState(unsigned long currentTime) {
-    Serial.println("FSM Manager: Sampling temperature...");
-    _currentTemperature = tempController.readTemperature();
-    Serial.print("FSM Manager: Temperature: ");
-    Serial.print(_currentTemperature);
-    Serial.println(" °C");
+    LOG_DEBUG("FSM Manager: Sampling temperature...");
+    if (!sampleSource.readSample(_lastSample)) {
+        _currentState = STATE_OPERATIONAL;
+        return;
+    }
+    LOG_DEBUG("FSM Manager: Temperature: %.2f °C, seq %lu", _lastSample.temperature, _lastSample.sequence);
+
+    // React to a threshold crossing immediately, without a backend round trip
+    applySamplingPolicy(_lastSample.temperature);
+    recordStatistics(_lastSample);
     
-    _lastTempSampleTime = currentTime;
     _currentState = STATE_SENDING_DATA;
-    Serial.println("FSM Manager: -> STATE_SENDING_DATA");
+    LOG_DEBUG("FSM Manager: -> STATE_SENDING_DATA");
 }
 
-void FsmManagerImpl::handleSendingDataState() {
-    Serial.println("FSM Manager: Sending temperature data...");
-    
-    if (mqttController.publishTemperature(_currentTemperature)) {
-        Serial.println("FSM Manager: Data sent successfully.");
+void FsmManagerImpl::handleSendingDataState(unsigned long currentTime) {
+    if (!STATS_RAW_SAMPLES_ENABLED) {
+        LOG_DEBUG("FSM Manager: Sample recorded for the statistics summary only.");
+    } else if (TELEMETRY_BATCH_ENABLED) {
+        // Buffer the sample; a full buffer drops the oldest unsent sample
+        if (!_sampleBatch.push(_lastSample)) {
+            LOG_WARN("FSM Manager: Batch buffer full, oldest sample dropped.");
+        }
+        flushSampleBatchIfDue(currentTime);
+    } else if (!isReportable(_lastSample)) {
+        _suppressedSinceReport++;
+        _suppressedSamples++;
+        LOG_DEBUG("FSM Manager: Sample within deadband, not sent.");
     } else {
-        Serial.println("FSM Manager: Failed to send data. MQTT may be disconnected.");
+        LOG_DEBUG("FSM Manager: Sending temperature data...");
+
+        if (mqttController.publishTemperature(_lastSample, _suppressedSinceReport)) {
+            LOG_DEBUG("FSM Manager: Data sent successfully.");
+            _hasReportedSample = true;
+            _lastReportedSample = _lastSample;
+            _suppressedSinceReport = 0;
+            recordWakeToPublish(millis());
+        } else {
+            LOG_WARN("FSM Manager: Failed to send data. Queued for store-and-forward.");
+            sampleStore.push(_lastSample);
+        }
     }
     
     _currentState = STATE_OPERATIONAL;
-    Serial.println("FSM Manager: -> STATE_OPERATIONAL (after sending)");
+    LOG_DEBUG("FSM Manager: -> STATE_OPERATIONAL (after sending)");
+
+    // Battery nodes power down right after the sample is out
+    deepSleepIfIdle(currentTime);
+}
+
+bool FsmManagerImpl::isReportable(const TemperatureSample& sample) const {
+    if (!_hasReportedSample) {
+        return true;
+    }
+    if (fabsf(sample.temperature - _lastReportedSample.temperature) >= PUBLISH_DEADBAND_C) {
+        return true;
+    }
+    // A change at one point of the room counts even if the control temperature holds
+    for (int channel = 0; TEMP_CHANNEL_COUNT > 1 && channel < TEMP_CHANNEL_COUNT; channel++) {
+        int delta = sample.frame.centiDegrees[channel] - _lastReportedSample.frame.centiDegrees[channel];
+        if (abs(delta) >= lroundf(PUBLISH_DEADBAND_C * 100.0f)) {
+            return true;
+        }
+    }
+    // A threshold crossing changes the backend state, however small the step
+    if (_samplingPolicy.bandCount > 0 &&
+        _samplingPolicy.bandFor(sample.temperature) != _samplingPolicy.bandFor(_lastReportedSample.temperature)) {
+        return true;
+    }
+    return sample.timestampMs - _lastReportedSample.timestampMs >= PUBLISH_HEARTBEAT_MS;
+}
+
+void FsmManagerImpl::recordWakeToPublish(unsigned long currentTime) {
+    if (_publishedSinceWake) {
+        return;
+    }
+    _publishedSinceWake = true;
+
+    if (powerManager) {
+        _dutyCycle.wakeToPublishMs = currentTime; // millis() restarts on every wake-up
+        if (currentTime > DEEP_SLEEP_WAKE_BUDGET_MS) {
+            _dutyCycle.wakeBudgetOverruns++;
+            LOG_WARN("FSM Manager: Wake to publish %lu ms, over budget", currentTime);
+        } else {
+            LOG_INFO("FSM Manager: Wake to publish %lu ms", currentTime);
+        }
+    }
+}
+
+void FsmManagerImpl::deepSleepIfIdle(unsigned long currentTime) {
+    if (!powerManager) {
+        return;
+    }
+
+    // Offline, samples go to the RTC queue anyway; online, wait for this wake's sample,
+    // the backlog and the retained configuration delivered after subscribing
+    if (_currentState == STATE_OPERATIONAL &&
+        (!_publishedSinceWake || sampleStore.size() > 0 ||
+         currentTime - _operationalSinceTime < DEEP_SLEEP_CONFIG_LINGER_MS)) {
+        return;
+    }
+
+    unsigned long sleepMs = sampleSource.getNextSampleTime(currentTime) - currentTime;
+    if (sleepMs < DEEP_SLEEP_MIN_DURATION_MS) {
+        return;
+    }
+
+    _dutyCycle.samplingIntervalMs = _currentSamplingIntervalMs;
+    _dutyCycle.intervalOverridden = _intervalOverridden;
+    _dutyCycle.samplingPolicy = _samplingPolicy;
+    _dutyCycle.nextSequence = sampleSource.getNextSequence();
+    _dutyCycle.statistics = _statistics;
+    _dutyCycle.clockOffsetMs += currentTime + sleepMs; // millis() restarts from 0 on the wake-up
+    _dutyCycle.sleepCycles++;
+    if (!_publishedSinceWake) {
+        _dutyCycle.wakeToPublishMs = 0;
+    }
+
+    LOG_INFO("FSM Manager: Deep sleep for %lu ms", sleepMs);
+    if (mqttController.isConnected()) {
+        mqttController.disconnect();
+    }
+    ledController.turnLedsOff();
+    Log::flush();
+
+    powerManager->deepSleep(_dutyCycle, sleepMs);
+}
+
+unsigned long FsmManagerImpl::dutyCycleTime(unsigned long currentTime) const {
+    return _dutyCycle.clockOffsetMs + currentTime;
+}
+
+void FsmManagerImpl::recordStatistics(const TemperatureSample& sample) {
+    if (STATS_WINDOW_ENABLED) {
+        // A window spans several wakes when duty cycling, so it is timed on a clock that survives sleep
+        TemperatureSample timed = sample;
+        timed.timestampMs = dutyCycleTime(sample.timestampMs);
+        _statistics.add(timed);
+    }
+}
+
+void FsmManagerImpl::publishStatisticsIfDue(unsigned long currentTime) {
+    if (_statistics.count == 0 || dutyCycleTime(currentTime) - _statistics.firstTimestampMs < STATS_WINDOW_MS) {
+        return;
+    }
+
+    // On failure the window stays open and the next attempt covers it as well
+    if (mqttController.publishTemperatureSummary(_statistics)) {
+        LOG_DEBUG("FSM Manager: Summary of %lu samples sent.", (unsigned long)_statistics.count);
+        _statistics.reset();
+    }
+}
+
+void FsmManagerImpl::flushSampleBatchIfDue(unsigned long currentTime) {
+    if (_sampleBatch.isEmpty()) {
+        return;
+    }
+
+    bool batchFull = _sampleBatch.size() >= TELEMETRY_BATCH_MAX_SAMPLES;
+    bool batchExpired = currentTime - _sampleBatch.at(0).timestampMs >= TELEMETRY_BATCH_MAX_AGE_MS;
+    if (!batchFull && !batchExpired) {
+        return;
+    }
+
+    TemperatureSample samples[TELEMETRY_BATCH_MAX_SAMPLES];
+    size_t count = _sampleBatch.copyTo(samples, TELEMETRY_BATCH_MAX_SAMPLES);
+
+    if (mqttController.publishTemperatureBatch(samples, count, false)) {
+        _sampleBatch.discard(count);
+        LOG_DEBUG("FSM Manager: Batch sent successfully.");
+    } else {
+        // Samples stay buffered and are retried on the next flush
+        LOG_WARN("FSM Manager: Failed to send batch. MQTT may be disconnected.");
+    }
+}
+
+void FsmManagerImpl::sampleOfflineIfDue(unsigned long currentTime) {
+    while (sampleSource.sampleReady(currentTime) && sampleSource.readSample(_lastSample)) {
+        applySamplingPolicy(_lastSample.temperature);
+        recordStatistics(_lastSample);
+
+        if (!sampleStore.push(_lastSample)) {
+            LOG_WARN("FSM Manager: Offline queue full, sample dropped.");
+        }
+    }
+}
+
+void FsmManagerImpl::drainBacklogIfDue(unsigned long currentTime) {
+    if (sampleStore.size() == 0 || currentTime - _lastBacklogDrainTime < STORE_FORWARD_DRAIN_INTERVAL_MS) {
+        return;
+    }
+    _lastBacklogDrainTime = currentTime;
+
+    TemperatureSample samples[STORE_FORWARD_DRAIN_BATCH];
+    size_t count = sampleStore.peek(samples, STORE_FORWARD_DRAIN_BATCH);
+
+    // Only remove the samples once the broker accepted them
+    if (mqttController.publishTemperatureBatch(samples, count, true)) {
+        sampleStore.discard(count);
+        recordWakeToPublish(millis()); // The sample of a wake-up is taken before the link is up
+        LOG_DEBUG("FSM Manager: Backlog samples remaining: %u", sampleStore.size());
+    }
 }
 
 void FsmManagerImpl::handleNetworkErrorState(unsigned long currentTime) {
     ledController.indicateNetworkError();
-    Serial.println("FSM Manager: Network error. Waiting before retry...");
+    unsigned long retryMs = _wifiBackoff.fail();
+    LOG_WARN("FSM Manager: Network error. Retrying in %lu ms...", retryMs);
     
     if (mqttController.isConnected()) {
         mqttController.disconnect();
@@ -189,14 +637,18 @@ void FsmManagerImpl::handleNetworkErrorState(unsigned long currentTime) {
     
     _currentState = STATE_WAIT_RECONNECT;
     _lastWiFiAttemptTime = currentTime;
-    Serial.println("FSM Manager: -> STATE_WAIT_RECONNECT");
+    LOG_INFO("FSM Manager: -> STATE_WAIT_RECONNECT");
 }
 
 void FsmManagerImpl::handleWaitReconnectState(unsigned long currentTime) {
     ledController.indicateNetworkError();
     
-    if (currentTime - _lastWiFiAttemptTime >= WIFI_RECONNECT_INTERVAL_MS) {
-        Serial.println("FSM Manager: Wait period over, retrying connection (-> INITIALIZING)...");
+    if (currentTime - _lastWiFiAttemptTime >= _wifiBackoff.getDelayMs()) {
+        LOG_INFO("FSM Manager: Wait period over, retrying connection (-> INITIALIZING)...");
         _currentState = STATE_INITIALIZING;
+        return;
     }
+
+    // The sample is queued; retry on the next wake instead of keeping the radio up
+    deepSleepIfIdle(currentTime);
 }
\ No newline at end of file
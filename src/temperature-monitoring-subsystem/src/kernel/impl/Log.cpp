@@ -0,0 +1,259 @@
+#include "../api/Log.h"
+#include "../api/SampleRingBuffer.h"
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#endif
+
+namespace {
+
+SampleRingBuffer<LogRecord, LOG_BUFFER_RECORDS> records;    ///< Messages waiting to be drained.
+unsigned long droppedCount = 0;                             ///< Messages overwritten before they were drained.
+unsigned long droppedReported = 0;                          ///< droppedCount at the last "records dropped" line.
+
+char pendingLine[LOG_LINE_MAX_LEN];                         ///< Formatted line being written to Serial.
+size_t pendingLength = 0;                                   ///< Length of pendingLine.
+size_t pendingOffset = 0;                                   ///< Bytes of pendingLine already written.
+
+const char DROPPED_FORMAT[] = "Log: %lu records dropped";
+
+#if defined(ESP32)
+// The sampling task logs from the other core, so the buffer is shared across cores
+portMUX_TYPE recordsMux = portMUX_INITIALIZER_UNLOCKED;
+#define LOG_LOCK() portENTER_CRITICAL(&recordsMux)
+#define LOG_UNLOCK() portEXIT_CRITICAL(&recordsMux)
+#else
+#define LOG_LOCK() do {} while (0)
+#define LOG_UNLOCK() do {} while (0)
+#endif
+
+const char LEVEL_LETTERS[] = {'-', 'E', 'W', 'I', 'D'};
+
+/**
+ * @brief Appends text to a bounded buffer, keeping it null-terminated.
+ * @return New length, never more than size - 1.
+ */
+size_t append(char* out, size_t size, size_t length, const char* text, size_t textLength) {
+    size_t room = size - 1 - length;
+    if (textLength > room) {
+        textLength = room;
+    }
+    memcpy(out + length, text, textLength);
+    length += textLength;
+    out[length] = '\0';
+    return length;
+}
+
+/**
+ * @brief Formats one argument with a single printf conversion spec.
+ *
+ * Length modifiers in the spec are ignored: the argument's stored type decides
+ * the C type passed to snprintf, and a conversion that does not fit that type
+ * is replaced (d for signed, u for unsigned, f for float, s for string).
+ *
+ * @param spec The conversion spec without length modifiers, e.g. "%-5" plus the conversion letter.
+ * @param specLength Length of spec including the conversion letter.
+ */
+int formatArg(char* out, size_t size, char* spec, size_t specLength, uint8_t type, const LogArg& arg) {
+    char conversion = spec[specLength - 1];
+    char fmt[24];
+    if (specLength + 2 > sizeof(fmt)) {
+        return 0;
+    }
+    memcpy(fmt, spec, specLength - 1);
+    size_t n = specLength - 1;
+
+    switch (type) {
+        case LOG_ARG_INT:
+        case LOG_ARG_UINT: {
+            bool isSigned = (type == LOG_ARG_INT);
+            if (conversion == 'c') {
+                fmt[n++] = 'c';
+                fmt[n] = '\0';
+                return snprintf(out, size, fmt, (int)arg.i);
+            }
+            if (!strchr("diuxXo", conversion)) {
+                conversion = isSigned ? 'd' : 'u';
+            }
+            fmt[n++] = 'l';
+            fmt[n++] = conversion;
+            fmt[n] = '\0';
+            if (conversion == 'd' || conversion == 'i') {
+                return isSigned ? snprintf(out, size, fmt, (long)arg.i)
+                                : snprintf(out, size, fmt, (long)arg.u);
+            }
+            return isSigned ? snprintf(out, size, fmt, (unsigned long)(uint32_t)arg.i)
+                            : snprintf(out, size, fmt, (unsigned long)arg.u);
+        }
+        case LOG_ARG_FLOAT:
+            fmt[n++] = strchr("fFeEgG", conversion) ? conversion : 'f';
+            fmt[n] = '\0';
+            return snprintf(out, size, fmt, (double)arg.f);
+        case LOG_ARG_STRING:
+        default:
+            fmt[n++] = 's';
+            fmt[n] = '\0';
+            return snprintf(out, size, fmt, arg.s ? arg.s : "(null)");
+    }
+}
+
+/**
+ * @brief Moves the next line to write (drop notice or queued message) into pendingLine.
+ * @return False if nothing is left to write.
+ */
+bool loadPendingLine() {
+    LogRecord record;
+    LOG_LOCK();
+    unsigned long dropped = droppedCount;
+    bool hasRecord = (dropped == droppedReported) && records.pop(record);
+    LOG_UNLOCK();
+
+    if (dropped != droppedReported) {
+        // Report an overflow before the surviving messages so the gap is visible where it happened
+        record.format = DROPPED_FORMAT;
+        record.timestampMs = millis();
+        record.level = LOG_LEVEL_WARN;
+        record.argCount = 1;
+        record.argTypes[0] = LOG_ARG_UINT;
+        record.args[0].u = (uint32_t)(dropped - droppedReported);
+        droppedReported = dropped;
+    } else if (!hasRecord) {
+        return false;
+    }
+
+    pendingLength = Log::format(record, pendingLine, sizeof(pendingLine));
+    pendingOffset = 0;
+    return true;
+}
+
+} // namespace
+
+void Log::push(LogRecord& record) {
+    record.timestampMs = millis();
+    LOG_LOCK();
+    if (!records.push(record)) {
+        droppedCount++;
+    }
+    LOG_UNLOCK();
+}
+
+bool Log::pop(LogRecord& out) {
+    LOG_LOCK();
+    bool popped = records.pop(out);
+    LOG_UNLOCK();
+    return popped;
+}
+
+size_t Log::format(const LogRecord& record, char* out, size_t size) {
+    if (size < 3) {
+        if (size > 0) {
+            out[0] = '\0';
+        }
+        return 0;
+    }
+    // Keep room for the line terminator
+    size_t bodySize = size - 2;
+    char letter = (record.level < sizeof(LEVEL_LETTERS)) ? LEVEL_LETTERS[record.level] : '?';
+    int written = snprintf(out, bodySize, "[%lu] %c ", (unsigned long)record.timestampMs, letter);
+    size_t length = (written < 0) ? 0 : ((size_t)written < bodySize ? (size_t)written : bodySize - 1);
+
+    const char* p = record.format ? record.format : "";
+    uint8_t argIndex = 0;
+    char chunk[LOG_LINE_MAX_LEN];
+    while (*p && length < bodySize - 1) {
+        if (*p != '%') {
+            const char* end = strchr(p, '%');
+            size_t textLength = end ? (size_t)(end - p) : strlen(p);
+            length = append(out, bodySize, length, p, textLength);
+            p += textLength;
+            continue;
+        }
+        if (p[1] == '%') {
+            length = append(out, bodySize, length, "%", 1);
+            p += 2;
+            continue;
+        }
+
+        // Copy flags, width and precision; skip length modifiers
+        char spec[16];
+        size_t specLength = 0;
+        spec[specLength++] = *p++;
+        while (*p && strchr("-+ #0123456789.", *p) && specLength < sizeof(spec) - 1) {
+            spec[specLength++] = *p++;
+        }
+        while (*p && strchr("hlLjzt", *p)) {
+            p++;
+        }
+        if (!*p) {
+            break;
+        }
+        spec[specLength++] = *p++;
+
+        if (argIndex >= record.argCount) {
+            length = append(out, bodySize, length, "?", 1);
+            continue;
+        }
+        int chunkLength = formatArg(chunk, sizeof(chunk), spec, specLength,
+                                    record.argTypes[argIndex], record.args[argIndex]);
+        argIndex++;
+        if (chunkLength > 0) {
+            size_t n = ((size_t)chunkLength < sizeof(chunk)) ? (size_t)chunkLength : sizeof(chunk) - 1;
+            length = append(out, bodySize, length, chunk, n);
+        }
+    }
+
+    out[length++] = '\r';
+    out[length++] = '\n';
+    out[length] = '\0';
+    return length;
+}
+
+void Log::drain() {
+    for (uint8_t lines = 0; lines < LOG_DRAIN_MAX_RECORDS; ) {
+        if (pendingOffset >= pendingLength) {
+            if (!loadPendingLine()) {
+                return;
+            }
+        }
+        // Never write more than the UART buffer accepts, so the loop never waits for the port
+        int room = Serial.availableForWrite();
+        if (room <= 0) {
+            return;
+        }
+        size_t remaining = pendingLength - pendingOffset;
+        size_t n = ((size_t)room < remaining) ? (size_t)room : remaining;
+        Serial.write((const uint8_t*)pendingLine + pendingOffset, n);
+        pendingOffset += n;
+        if (pendingOffset < pendingLength) {
+            return;
+        }
+        lines++;
+    }
+}
+
+void Log::flush() {
+    while (pendingOffset < pendingLength || loadPendingLine()) {
+        Serial.write((const uint8_t*)pendingLine + pendingOffset, pendingLength - pendingOffset);
+        pendingOffset = pendingLength;
+    }
+}
+
+unsigned long Log::getDroppedCount() {
+    LOG_LOCK();
+    unsigned long dropped = droppedCount;
+    LOG_UNLOCK();
+    return dropped;
+}
+
+void Log::clear() {
+    LOG_LOCK();
+    records.clear();
+    droppedCount = 0;
+    droppedReported = 0;
+    LOG_UNLOCK();
+    pendingLength = 0;
+    pendingOffset = 0;
+}
@@ -0,0 +1,68 @@
+#include "../api/LoopProfiler.h"
+#include <string.h>
+
+namespace {
+
+const char* const SLOT_NAMES[LOOP_PROFILE_SLOT_COUNT] = {
+    "initializing",     // STATE_INITIALIZING
+    "wifi_connecting",  // STATE_WIFI_CONNECTING
+    "wifi_connected",   // STATE_WIFI_CONNECTED
+    "mqtt_connecting",  // STATE_MQTT_CONNECTING
+    "operational",      // STATE_OPERATIONAL
+    "sampling",         // STATE_SAMPLING_TEMPERATURE
+    "sending",          // STATE_SENDING_DATA
+    "network_error",    // STATE_NETWORK_ERROR
+    "wait_reconnect",   // STATE_WAIT_RECONNECT
+    "mqtt_loop",        // LOOP_PROFILE_SLOT_MQTT_LOOP
+    "config_wake",      // LOOP_PROFILE_SLOT_CONFIG_WAKE
+};
+
+static_assert(LOOP_PROFILE_SLOT_COUNT == 11, "SLOT_NAMES must list every profiler slot");
+
+} // namespace
+
+LoopProfiler::LoopProfiler() {
+    reset();
+}
+
+void LoopProfiler::reset() {
+    memset(_slots, 0, sizeof(_slots));
+    for (uint8_t slot = 0; slot < LOOP_PROFILE_SLOT_COUNT; slot++) {
+        _slots[slot].minUs = UINT32_MAX;
+    }
+}
+
+void LoopProfiler::summarize(uint8_t slot, LatencySummary& summary) const {
+    summary = {};
+    if (slot >= LOOP_PROFILE_SLOT_COUNT || _slots[slot].count == 0) {
+        return;
+    }
+
+    const SlotHistogram& histogram = _slots[slot];
+    summary.count = histogram.count;
+    summary.minUs = histogram.minUs;
+    summary.p50Us = percentile(histogram, 50);
+    summary.p99Us = percentile(histogram, 99);
+    summary.maxUs = histogram.maxUs;
+}
+
+uint32_t LoopProfiler::percentile(const SlotHistogram& histogram, uint32_t percent) const {
+    // Rank of the percentile sample, rounded up so p99 of 100 samples is the 99th
+    uint64_t rank = ((uint64_t)histogram.count * percent + 99) / 100;
+    uint64_t seen = 0;
+
+    for (uint8_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+        seen += histogram.buckets[bucket];
+        if (seen >= rank) {
+            uint32_t upperBound = (bucket == 0) ? 0 : (uint32_t)((1ULL << bucket) - 1);
+            if (upperBound > histogram.maxUs) upperBound = histogram.maxUs;
+            if (upperBound < histogram.minUs) upperBound = histogram.minUs;
+            return upperBound;
+        }
+    }
+    return histogram.maxUs;
+}
+
+const char* LoopProfiler::slotName(uint8_t slot) {
+    return (slot < LOOP_PROFILE_SLOT_COUNT) ? SLOT_NAMES[slot] : "unknown";
+}
@@ -0,0 +1,61 @@
+#include "../api/PolledSampleSourceImpl.h"
+#include <Arduino.h>
+
+PolledSampleSourceImpl::PolledSampleSourceImpl(TemperatureManager& tempCtrl)
+    : tempController(tempCtrl),
+      _intervalMs(TEMP_SAMPLE_INTERVAL_DEFAULT_MS),
+      _nextSampleTime(0),
+      _sequence(0),
+      _overruns(0) {}
+
+void PolledSampleSourceImpl::setup() {
+    // Nothing to start: sampling happens in the caller's context
+    _nextSampleTime = millis();
+}
+
+void PolledSampleSourceImpl::setIntervalMs(unsigned long intervalMs) {
+    // Re-plan the pending deadline relative to the previous sample
+    _nextSampleTime = _nextSampleTime - _intervalMs + intervalMs;
+    _intervalMs = intervalMs;
+}
+
+bool PolledSampleSourceImpl::sampleReady(unsigned long currentTime) {
+    return (long)(currentTime - _nextSampleTime) >= 0;
+}
+
+unsigned long PolledSampleSourceImpl::getNextSampleTime(unsigned long currentTime) const {
+    return (long)(currentTime - _nextSampleTime) >= 0 ? currentTime : _nextSampleTime;
+}
+
+bool PolledSampleSourceImpl::readSample(TemperatureSample& out) {
+    unsigned long now = millis();
+
+    // Periods that passed entirely while the loop was busy count as dropped samples
+    unsigned long missed = 0;
+    if ((long)(now - _nextSampleTime) >= 0) {
+        missed = (now - _nextSampleTime) / _intervalMs;
+    }
+    _sequence += missed;
+    _overruns += missed;
+
+    out.timestampMs = now;
+    tempController.readFrame(out.frame);
+    out.temperature = out.frame.aggregate();
+    out.sequence = _sequence++;
+
+    // Absolute schedule: the loop latency does not accumulate as drift
+    _nextSampleTime += (missed + 1) * _intervalMs;
+    return true;
+}
+
+unsigned long PolledSampleSourceImpl::getOverrunCount() const {
+    return _overruns;
+}
+
+uint32_t PolledSampleSourceImpl::getNextSequence() const {
+    return _sequence;
+}
+
+void PolledSampleSourceImpl::setNextSequence(uint32_t sequence) {
+    _sequence = sequence;
+}
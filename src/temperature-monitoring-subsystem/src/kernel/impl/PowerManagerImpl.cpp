@@ -0,0 +1,48 @@
+#include "../api/PowerManagerImpl.h"
+#include <Arduino.h>
+#include <esp_sleep.h>
+
+namespace {
+
+/** @brief Marker identifying a saved state (changes whenever the layout changes). */
+const uint32_t RTC_DUTY_CYCLE_MAGIC = 0x44435332; // "DCS2"
+
+/**
+ * @struct RtcDutyCycle
+ * @brief Saved state and its marker kept in RTC memory.
+ */
+struct RtcDutyCycle {
+    uint32_t magic;         ///< RTC_DUTY_CYCLE_MAGIC once saved.
+    DutyCycleState state;   ///< State saved before the last deep sleep.
+};
+
+// Zeroed on every boot except a deep sleep wake-up
+RTC_DATA_ATTR RtcDutyCycle rtcDutyCycle;
+
+} // namespace
+
+PowerManagerImpl::PowerManagerImpl() : _wokeFromDeepSleep(false) {}
+
+void PowerManagerImpl::setup() {
+    _wokeFromDeepSleep = esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER;
+}
+
+bool PowerManagerImpl::wokeFromDeepSleep() const {
+    return _wokeFromDeepSleep;
+}
+
+bool PowerManagerImpl::loadState(DutyCycleState& out) {
+    if (!_wokeFromDeepSleep || rtcDutyCycle.magic != RTC_DUTY_CYCLE_MAGIC) {
+        return false;
+    }
+    out = rtcDutyCycle.state;
+    return true;
+}
+
+void PowerManagerImpl::deepSleep(const DutyCycleState& state, unsigned long durationMs) {
+    rtcDutyCycle.magic = RTC_DUTY_CYCLE_MAGIC;
+    rtcDutyCycle.state = state;
+
+    esp_sleep_enable_timer_wakeup((uint64_t)durationMs * 1000ULL);
+    esp_deep_sleep_start();
+}
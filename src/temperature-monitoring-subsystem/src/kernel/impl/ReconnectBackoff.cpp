@@ -0,0 +1,45 @@
+#include "../api/ReconnectBackoff.h"
+
+ReconnectBackoff::ReconnectBackoff(unsigned long baseMs, unsigned long maxMs)
+    : _baseMs(baseMs),
+      _maxMs(maxMs < baseMs ? baseMs : maxMs),
+      _ceilingMs(baseMs),
+      _delayMs(0),
+      _longestDelayMs(0),
+      _failures(0),
+      _random(1) {}
+
+void ReconnectBackoff::seed(uint32_t seed) {
+    // Mix the seed so that neighbouring chip IDs give unrelated sequences
+    seed ^= seed >> 16;
+    seed *= 0x7feb352dUL;
+    seed ^= seed >> 15;
+    seed *= 0x846ca68bUL;
+    seed ^= seed >> 16;
+    _random = seed ? seed : 1;
+}
+
+unsigned long ReconnectBackoff::fail() {
+    unsigned long half = _ceilingMs / 2;
+    _delayMs = half + nextRandom() % (_ceilingMs - half + 1);
+    if (_delayMs > _longestDelayMs) {
+        _longestDelayMs = _delayMs;
+    }
+    _ceilingMs = _ceilingMs > _maxMs / 2 ? _maxMs : _ceilingMs * 2;
+    _failures++;
+    return _delayMs;
+}
+
+void ReconnectBackoff::reset() {
+    _ceilingMs = _baseMs;
+    _delayMs = 0;
+    _longestDelayMs = 0;
+    _failures = 0;
+}
+
+uint32_t ReconnectBackoff::nextRandom() {
+    _random ^= _random << 13;
+    _random ^= _random >> 17;
+    _random ^= _random << 5;
+    return _random;
+}
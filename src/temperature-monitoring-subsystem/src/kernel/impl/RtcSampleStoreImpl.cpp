@@ -0,0 +1,131 @@
+#include "../api/RtcSampleStoreImpl.h"
+#include "../api/Log.h"
+#include <Arduino.h>
+#include <string.h>
+
+namespace {
+
+/** @brief Marker identifying an initialized queue (changes whenever the layout changes). */
+const uint32_t RTC_QUEUE_MAGIC = 0x53465132 + ((uint32_t)(TEMP_CHANNEL_COUNT - 1) << 24); // "SFQ2", channels above 1 in the top byte
+
+/** @brief Channel readings stored besides the control temperature; a single channel is the control temperature. */
+const int STORED_CHANNELS = TEMP_CHANNEL_COUNT > 1 ? TEMP_CHANNEL_COUNT : 0;
+
+/**
+ * @struct StoredSample
+ * @brief Compact fixed-size record of one queued sample.
+ */
+struct StoredSample {
+    uint32_t timestampMs;   ///< Time since boot in milliseconds when the sample was taken.
+    uint32_t sequence;      ///< Sampling period number of the sample.
+    /**
+     * Control temperature, then each channel when there are several, in hundredths of a degree Celsius.
+     * An odd number of values leaves one unused slot, so records need no padding.
+     */
+    int16_t centiDegrees[(1 + STORED_CHANNELS + 1) / 2 * 2];
+};
+
+/**
+ * @struct RtcSampleQueue
+ * @brief Ring buffer header and records kept in RTC memory.
+ */
+struct RtcSampleQueue {
+    uint32_t magic;         ///< RTC_QUEUE_MAGIC once initialized.
+    uint16_t head;          ///< Index of the oldest record.
+    uint16_t count;         ///< Number of queued records.
+    uint32_t lost;          ///< Samples dropped because the queue was full.
+    StoredSample records[STORE_FORWARD_CAPACITY];
+};
+
+static_assert(sizeof(StoredSample) == 8 + 4 * ((1 + STORED_CHANNELS + 1) / 2),
+              "StoredSample must stay without padding");
+static_assert(STORE_FORWARD_CAPACITY <= 0xFFFF, "STORE_FORWARD_CAPACITY exceeds 16-bit indices");
+
+// Not zeroed on reset: contents are validated in setup()
+RTC_NOINIT_ATTR RtcSampleQueue rtcQueue;
+
+int16_t toCentiDegrees(float temperature) {
+    float scaled = temperature * 100.0f;
+    if (scaled > 32767.0f) return 32767;
+    if (scaled < -32768.0f) return -32768;
+    return (int16_t)lroundf(scaled);
+}
+
+} // namespace
+
+RtcSampleStoreImpl::RtcSampleStoreImpl() {
+    // Queue state lives in RTC memory and is recovered in setup()
+}
+
+void RtcSampleStoreImpl::setup() {
+    if (rtcQueue.magic != RTC_QUEUE_MAGIC ||
+        rtcQueue.head >= STORE_FORWARD_CAPACITY ||
+        rtcQueue.count > STORE_FORWARD_CAPACITY) {
+        // Cold boot (or layout change): RTC memory holds garbage
+        rtcQueue.magic = RTC_QUEUE_MAGIC;
+        rtcQueue.head = 0;
+        rtcQueue.count = 0;
+        rtcQueue.lost = 0;
+        LOG_INFO("Sample Store: Initialized empty queue");
+    } else {
+        LOG_INFO("Sample Store: Recovered %u queued samples", rtcQueue.count);
+    }
+}
+
+bool RtcSampleStoreImpl::push(const TemperatureSample& sample) {
+    bool dropped = false;
+
+    if (rtcQueue.count == STORE_FORWARD_CAPACITY) {
+        dropped = true;
+        rtcQueue.lost++;
+        if (!STORE_FORWARD_DROP_OLDEST) {
+            return false; // Keep the backlog, drop the incoming sample
+        }
+        // Make room by dropping the oldest record
+        rtcQueue.head = (rtcQueue.head + 1) % STORE_FORWARD_CAPACITY;
+        rtcQueue.count--;
+    }
+
+    uint16_t tail = (rtcQueue.head + rtcQueue.count) % STORE_FORWARD_CAPACITY;
+    rtcQueue.records[tail].timestampMs = (uint32_t)sample.timestampMs;
+    rtcQueue.records[tail].sequence = sample.sequence;
+    StoredSample& record = rtcQueue.records[tail];
+    memset(record.centiDegrees, 0, sizeof(record.centiDegrees));
+    record.centiDegrees[0] = toCentiDegrees(sample.temperature);
+    for (int channel = 0; channel < STORED_CHANNELS; channel++) {
+        record.centiDegrees[1 + channel] = sample.frame.centiDegrees[channel];
+    }
+    rtcQueue.count++;
+
+    return !dropped;
+}
+
+size_t RtcSampleStoreImpl::peek(TemperatureSample* out, size_t maxCount) const {
+    size_t n = (rtcQueue.count < maxCount) ? rtcQueue.count : maxCount;
+    for (size_t i = 0; i < n; i++) {
+        const StoredSample& record = rtcQueue.records[(rtcQueue.head + i) % STORE_FORWARD_CAPACITY];
+        out[i].timestampMs = record.timestampMs;
+        out[i].temperature = record.centiDegrees[0] / 100.0f;
+        out[i].sequence = record.sequence;
+        for (int channel = 0; channel < TEMP_CHANNEL_COUNT; channel++) {
+            out[i].frame.centiDegrees[channel] = record.centiDegrees[STORED_CHANNELS > 0 ? 1 + channel : 0];
+        }
+    }
+    return n;
+}
+
+void RtcSampleStoreImpl::discard(size_t count) {
+    if (count > rtcQueue.count) {
+        count = rtcQueue.count;
+    }
+    rtcQueue.head = (rtcQueue.head + count) % STORE_FORWARD_CAPACITY;
+    rtcQueue.count -= count;
+}
+
+size_t RtcSampleStoreImpl::size() const {
+    return rtcQueue.count;
+}
+
+unsigned long RtcSampleStoreImpl::getLostSampleCount() const {
+    return rtcQueue.lost;
+}
@@ -0,0 +1,117 @@
+#include "../api/TaskSampleSourceImpl.h"
+#include "../api/Log.h"
+#include <Arduino.h>
+
+TaskSampleSourceImpl::TaskSampleSourceImpl(TemperatureManager& tempCtrl)
+    : tempController(tempCtrl),
+      _intervalMs(TEMP_SAMPLE_INTERVAL_DEFAULT_MS),
+      _nextSequence(0),
+      _overruns(0),
+      _taskHandle(nullptr),
+      _consumerTask(nullptr),
+      _timer(nullptr) {}
+
+void TaskSampleSourceImpl::setup() {
+    // Samples are consumed by the loop task, which also runs setup()
+    _consumerTask = xTaskGetCurrentTaskHandle();
+
+    BaseType_t created = xTaskCreatePinnedToCore(
+        taskEntry, "sampling", SAMPLING_TASK_STACK_SIZE, this,
+        SAMPLING_TASK_PRIORITY, &_taskHandle, SAMPLING_TASK_CORE);
+
+    if (created != pdPASS) {
+        _taskHandle = nullptr;
+        LOG_ERROR("Sampling Task: Failed to create task");
+        return;
+    }
+
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = timerCallback;
+    timerArgs.arg = this;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "sampling";
+
+    if (esp_timer_create(&timerArgs, &_timer) != ESP_OK ||
+        esp_timer_start_periodic(_timer, (uint64_t)_intervalMs * 1000ULL) != ESP_OK) {
+        LOG_ERROR("Sampling Task: Failed to start sampling timer");
+        return;
+    }
+
+    LOG_INFO("Sampling Task: Started on core %d", SAMPLING_TASK_CORE);
+}
+
+void TaskSampleSourceImpl::setIntervalMs(unsigned long intervalMs) {
+    if (intervalMs == _intervalMs) {
+        return;
+    }
+    _intervalMs = intervalMs;
+
+    if (_timer) {
+        // Re-arm: the first sample with the new period is due one period from now
+        esp_timer_stop(_timer);
+        esp_timer_start_periodic(_timer, (uint64_t)intervalMs * 1000ULL);
+    }
+}
+
+bool TaskSampleSourceImpl::sampleReady(unsigned long currentTime) {
+    return !_samples.isEmpty();
+}
+
+unsigned long TaskSampleSourceImpl::getNextSampleTime(unsigned long currentTime) const {
+    // New samples wake the consumer, so the deadline is only a fallback
+    return _samples.isEmpty() ? currentTime + _intervalMs : currentTime;
+}
+
+bool TaskSampleSourceImpl::readSample(TemperatureSample& out) {
+    return _samples.pop(out);
+}
+
+unsigned long TaskSampleSourceImpl::getOverrunCount() const {
+    return _overruns.load();
+}
+
+uint32_t TaskSampleSourceImpl::getNextSequence() const {
+    return _nextSequence;
+}
+
+void TaskSampleSourceImpl::setNextSequence(uint32_t sequence) {
+    _nextSequence = sequence; // The timer is not running yet
+}
+
+void TaskSampleSourceImpl::timerCallback(void* param) {
+    static_cast<TaskSampleSourceImpl*>(param)->onTimer();
+}
+
+void TaskSampleSourceImpl::onTimer() {
+    // Timestamp and number the period here, where the jitter is only the timer dispatch latency
+    TemperatureSample tick = {};
+    tick.timestampMs = (unsigned long)(esp_timer_get_time() / 1000);
+    tick.sequence = _nextSequence++;
+
+    if (_ticks.push(tick)) {
+        xTaskNotifyGive(_taskHandle);
+    } else {
+        _overruns++; // The sampling task is still busy with earlier periods
+    }
+}
+
+void TaskSampleSourceImpl::taskEntry(void* param) {
+    static_cast<TaskSampleSourceImpl*>(param)->taskLoop();
+}
+
+void TaskSampleSourceImpl::taskLoop() {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        TemperatureSample sample;
+        while (_ticks.pop(sample)) {
+            tempController.readFrame(sample.frame);
+            sample.temperature = sample.frame.aggregate();
+            if (!_samples.push(sample)) {
+                _overruns++; // The FSM has not consumed earlier samples
+            } else if (_consumerTask) {
+                xTaskNotifyGive(_consumerTask); // Ends the loop task's idle sleep
+            }
+        }
+    }
+}
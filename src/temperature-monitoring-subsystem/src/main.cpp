@@ -7,6 +7,11 @@
 #include "kernel/connection/api/WifiManager.h"
 #include "kernel/connection/api/MqttManager.h"
 #include "kernel/api/IFsmManager.h"
+#include "kernel/api/SampleStore.h"
+#include "kernel/api/SampleSource.h"
+#include "kernel/api/LoopProfiler.h"
+#include "kernel/api/PowerManager.h"
+#include "kernel/api/Log.h"
 
 // Implementation headers
 #include "devices/api/LedStatusImpl.h"
@@ -14,13 +19,59 @@
 #include "kernel/connection/api/WifiManagerImpl.h"
 #include "kernel/connection/api/MqttManagerImpl.h"
 #include "kernel/api/FsmManagerImpl.h"
+#include "kernel/api/RtcSampleStoreImpl.h"
+#include "kernel/api/PolledSampleSourceImpl.h"
+#include "kernel/api/TaskSampleSourceImpl.h"
+#include "kernel/api/PowerManagerImpl.h"
+
+#include <esp_timer.h>
 
 // Pointers to interfaces for component decoupling
 LedStatus* ledStatus = nullptr;
 TemperatureManager* temperatureManager = nullptr;
 WifiManager* wifiManager = nullptr;
 MqttManager* mqttManager = nullptr;
+SampleStore* sampleStore = nullptr;
+SampleSource* sampleSource = nullptr;
 IFsmManager* systemFsm = nullptr;
+LoopProfiler* loopProfiler = nullptr;
+PowerManager* powerManager = nullptr;
+uint32_t lastIdleUs = 0; ///< Duration of the previous idle sleep.
+
+/**
+ * @brief Runs one step of the main loop, timing it into a profiler slot if profiling is enabled.
+ * @param slot SystemState value or LOOP_PROFILE_SLOT_MQTT_LOOP.
+ * @param step The work to time.
+ */
+template <typename Step>
+inline void runProfiled(uint8_t slot, Step step) {
+    if (!LOOP_PROFILING_ENABLED || !loopProfiler) {
+        step();
+        return;
+    }
+    int64_t start = esp_timer_get_time();
+    step();
+    loopProfiler->record(slot, (uint32_t)(esp_timer_get_time() - start));
+}
+
+/**
+ * @brief Blocks the loop task until a deadline or until the sampling task delivers a sample.
+ *
+ * Other tasks and the idle task run meanwhile, so WiFi modem sleep can power
+ * down the radio between beacons instead of the loop spinning.
+ *
+ * @param deadline Wake-up time in millis() time.
+ * @return Time actually slept in microseconds.
+ */
+uint32_t sleepUntil(unsigned long deadline) {
+    long remaining = (long)(deadline - millis());
+    if (remaining <= 0) {
+        return 0;
+    }
+    int64_t start = esp_timer_get_time();
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(remaining));
+    return (uint32_t)(esp_timer_get_time() - start);
+}
 
 /**
  * @brief Setup function, runs once at system startup.
@@ -31,47 +82,87 @@ IFsmManager* systemFsm = nullptr;
 void setup() {
     Serial.begin(115200);
     while (!Serial) { ; } // Wait for serial port to be ready
-    Serial.println("\n\n[Smart Temperature Monitor - ESP32] System Starting...");
+    LOG_INFO("[Smart Temperature Monitor - ESP32] System Starting...");
 
     // Create instances of concrete implementations
     ledStatus = new LedStatusImpl();
     temperatureManager = new TemperatureManagerImpl();
     wifiManager = new WifiManagerImpl(WIFI_SSID, WIFI_PASSWORD);
     mqttManager = new MqttManagerImpl(MQTT_SERVER_HOST, MQTT_SERVER_PORT, MQTT_CLIENT_ID_PREFIX, wifiManager);
+    sampleStore = new RtcSampleStoreImpl();
+    // A duty-cycled node samples once per wake-up, right away: the sampling task would only delay it
+    if (SAMPLING_TASK_ENABLED && !DEEP_SLEEP_ENABLED) {
+        sampleSource = new TaskSampleSourceImpl(*temperatureManager);
+    } else {
+        sampleSource = new PolledSampleSourceImpl(*temperatureManager);
+    }
+
+    if (LOOP_PROFILING_ENABLED) {
+        loopProfiler = new LoopProfiler();
+    }
+
+    if (DEEP_SLEEP_ENABLED) {
+        powerManager = new PowerManagerImpl();
+        powerManager->setup();
+    }
 
     // Create FSM instance, passing references to required modules
-    systemFsm = new FsmManagerImpl(*ledStatus, *temperatureManager, *wifiManager, *mqttManager);
+    systemFsm = new FsmManagerImpl(*ledStatus, *sampleSource, *wifiManager, *mqttManager, *sampleStore,
+                                   loopProfiler, powerManager);
 
     // Setup individual modules
     ledStatus->setup();
-    ledStatus->indicateSystemBoot();
+    if (!powerManager || !powerManager->wokeFromDeepSleep()) {
+        ledStatus->indicateSystemBoot(); // A wake-up is not a boot worth signalling
+    }
     temperatureManager->setup();
     wifiManager->setup();
     mqttManager->setup();
+    sampleStore->setup();
 
-    // Setup FSM
+    // Setup FSM, restoring the interval and sequence of a deep sleep before sampling starts
     systemFsm->setup();
 
-    Serial.println("System initialization completed.");
+    sampleSource->setup(); // Starts the sampling task once the sensor is ready
+
+    LOG_INFO("System initialization completed.");
+    Log::flush(); // Nothing is timing-critical yet, write the boot log out in full
 }
 
 /**
  * @brief Main loop function, runs repeatedly.
  * 
  * Manages MQTT communication loop and executes the FSM's run cycle.
+ * Both are timed into the loop profiler when LOOP_PROFILING_ENABLED is set.
  * The FSM handles all state management and coordination between components.
+ * Queued log messages are written next, only as far as the UART accepts them.
+ * With IDLE_SLEEP_ENABLED the loop then sleeps until the FSM's next deadline.
  */
 void loop() {
     // MQTT loop must be called regularly to maintain connection
     // and process incoming/outgoing messages
     if (wifiManager && wifiManager->isConnected()) {
         if (mqttManager) {
-            mqttManager->loop();
+            unsigned long configMessages = mqttManager->getConfigMessageCount();
+            runProfiled(LOOP_PROFILE_SLOT_MQTT_LOOP, [] { mqttManager->loop(); });
+
+            // A config message read now arrived during the last sleep, so it waited at most that long
+            if (loopProfiler && mqttManager->getConfigMessageCount() != configMessages) {
+                loopProfiler->record(LOOP_PROFILE_SLOT_CONFIG_WAKE, lastIdleUs);
+            }
         }
     }
 
-    // Execute one FSM cycle
+    // Execute one FSM cycle, timed under the state it starts in
     if (systemFsm) {
-        systemFsm->run();
+        runProfiled(systemFsm->getCurrentState(), [] { systemFsm->run(); });
+    }
+
+    // Write queued log messages in the time left over, never blocking on the port
+    Log::drain();
+
+    // Nothing to do before the next deadline: give the core away instead of spinning
+    if (IDLE_SLEEP_ENABLED && systemFsm) {
+        lastIdleUs = sleepUntil(systemFsm->getNextDeadline(millis()));
     }
 }
\ No newline at end of file
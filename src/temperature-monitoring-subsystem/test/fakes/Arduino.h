@@ -0,0 +1,151 @@
+#ifndef FAKE_ARDUINO_H
+#define FAKE_ARDUINO_H
+
+/**
+ * @file Arduino.h
+ * @brief Host replacement for the Arduino core used by the native test env.
+ *
+ * Provides a controllable clock behind millis(), scripted analog inputs and
+ * a Serial object that records its output and can simulate a full transmit
+ * buffer. All state
+ * lives in the fake namespace so tests can reset and inspect it.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <string>
+
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define F(x) (x)
+
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+
+namespace fake {
+
+inline unsigned long nowMs = 0;                         ///< Value returned by millis().
+inline unsigned long delayCalls = 0;                    ///< Number of blocking delay() calls.
+inline std::map<int, int> analogValues;                 ///< Steady value returned by analogRead() per pin.
+inline std::map<int, std::deque<int>> analogScripts;    ///< One-shot values returned before the steady value.
+inline std::map<int, int> digitalValues;                ///< Last value written per pin.
+inline bool serialEcho = false;                         ///< Copy Serial output to stdout when true.
+inline std::string serialOutput;                        ///< Everything written through Serial.write().
+inline size_t serialTxRoom = SIZE_MAX;                  ///< Free transmit buffer space, consumed by write().
+inline uint64_t efuseMac = 0x0000A1B2C3D4E5F6ULL;       ///< Factory MAC returned by ESP.getEfuseMac().
+
+inline void setMillis(unsigned long ms) { nowMs = ms; }
+inline void advanceMillis(unsigned long ms) { nowMs += ms; }
+
+inline void reset() {
+    nowMs = 0;
+    delayCalls = 0;
+    analogValues.clear();
+    analogScripts.clear();
+    digitalValues.clear();
+    serialOutput.clear();
+    serialTxRoom = SIZE_MAX;
+    efuseMac = 0x0000A1B2C3D4E5F6ULL;
+}
+
+} // namespace fake
+
+inline unsigned long millis() { return fake::nowMs; }
+inline unsigned long micros() { return fake::nowMs * 1000UL; }
+
+inline void delay(unsigned long ms) {
+    fake::delayCalls++;
+    fake::nowMs += ms;
+}
+
+inline void pinMode(int, int) {}
+inline void digitalWrite(int pin, int value) { fake::digitalValues[pin] = value; }
+inline int digitalRead(int pin) { return fake::digitalValues[pin]; }
+
+inline int analogRead(int pin) {
+    std::deque<int>& script = fake::analogScripts[pin];
+    if (!script.empty()) {
+        int value = script.front();
+        script.pop_front();
+        return value;
+    }
+    return fake::analogValues[pin];
+}
+
+inline uint32_t analogReadMilliVolts(int pin) { return (uint32_t)analogRead(pin); }
+inline void analogReadResolution(int) {}
+
+typedef enum { ADC_0db, ADC_2_5db, ADC_6db, ADC_11db } adc_attenuation_t;
+inline void analogSetPinAttenuation(uint8_t, adc_attenuation_t) {}
+
+/**
+ * @class FakeSerial
+ * @brief Accepts the Print API used by the firmware.
+ */
+class FakeSerial {
+public:
+    void begin(unsigned long) {}
+    explicit operator bool() const { return true; }
+
+    template <typename T>
+    size_t print(const T& value) {
+        if (fake::serialEcho) std::cout << value;
+        return 0;
+    }
+
+    template <typename T>
+    size_t print(const T& value, int) { return print(value); }
+
+    size_t println() { return print('\n'); }
+
+    template <typename T>
+    size_t println(const T& value) {
+        print(value);
+        return println();
+    }
+
+    template <typename T>
+    size_t println(const T& value, int) { return println(value); }
+
+    int availableForWrite() const {
+        return (fake::serialTxRoom > INT32_MAX) ? INT32_MAX : (int)fake::serialTxRoom;
+    }
+
+    size_t write(const uint8_t* data, size_t length) {
+        fake::serialOutput.append(reinterpret_cast<const char*>(data), length);
+        if (fake::serialTxRoom != SIZE_MAX) {
+            fake::serialTxRoom -= (length < fake::serialTxRoom) ? length : fake::serialTxRoom;
+        }
+        if (fake::serialEcho) std::cout.write(reinterpret_cast<const char*>(data), length);
+        return length;
+    }
+};
+
+inline FakeSerial Serial;
+
+/**
+ * @class FakeEsp
+ * @brief Chip information and heap statistics with fixed values (the MAC is settable).
+ */
+class FakeEsp {
+public:
+    uint64_t getEfuseMac() const { return fake::efuseMac; }
+    uint32_t getFreeHeap() const { return 200000; }
+    uint32_t getMinFreeHeap() const { return 180000; }
+    uint32_t getMaxAllocHeap() const { return 110000; }
+};
+
+inline FakeEsp ESP;
+
+#endif // FAKE_ARDUINO_H
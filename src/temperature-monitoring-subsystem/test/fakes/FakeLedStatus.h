@@ -0,0 +1,32 @@
+#ifndef FAKE_LED_STATUS_H
+#define FAKE_LED_STATUS_H
+
+#include "devices/api/LedStatus.h"
+
+/**
+ * @class FakeLedStatus
+ * @brief Records the last indication requested by the FSM.
+ */
+class FakeLedStatus : public LedStatus {
+public:
+    enum Indication { NONE, OPERATIONAL, NETWORK_ERROR, SYSTEM_BOOT, WIFI_CONNECTING, MQTT_CONNECTING, OFF };
+
+    Indication last = NONE;     ///< Most recent indication.
+    unsigned long changes = 0;  ///< Number of indication calls.
+
+    void setup() override {}
+    void indicateOperational() override { set(OPERATIONAL); }
+    void indicateNetworkError() override { set(NETWORK_ERROR); }
+    void indicateSystemBoot() override { set(SYSTEM_BOOT); }
+    void indicateWifiConnecting() override { set(WIFI_CONNECTING); }
+    void indicateMqttConnecting() override { set(MQTT_CONNECTING); }
+    void turnLedsOff() override { set(OFF); }
+
+private:
+    void set(Indication indication) {
+        last = indication;
+        changes++;
+    }
+};
+
+#endif // FAKE_LED_STATUS_H
@@ -0,0 +1,104 @@
+#ifndef FAKE_MQTT_MANAGER_H
+#define FAKE_MQTT_MANAGER_H
+
+#include "kernel/connection/api/MqttManager.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class FakeMqttManager
+ * @brief Scripted MQTT session that records everything the FSM publishes.
+ */
+class FakeMqttManager : public MqttManager {
+public:
+    bool acceptConnect = true;                  ///< Result of connect() while WiFi is up.
+    bool acceptPublish = true;                  ///< Result of the publish calls while connected.
+    bool connected = false;                     ///< Result of isConnected().
+    unsigned long connectCalls = 0;             ///< Number of connect() calls.
+    unsigned long loopCalls = 0;                ///< Number of loop() calls.
+    std::vector<TemperatureSample> samples;     ///< Samples accepted by publishTemperature().
+    std::vector<uint32_t> suppressed;           ///< Suppressed counts passed with the accepted samples.
+    std::vector<TemperatureSample> batched;     ///< Samples accepted by publishTemperatureBatch().
+    std::vector<WindowStatistics> summaries;    ///< Windows accepted by publishTemperatureSummary().
+    std::vector<std::string> statuses;          ///< Accepted publishStatus() messages.
+    std::vector<StatusReport> reports;          ///< Accepted publishStatusReport() reports.
+    std::vector<unsigned long> metricsWindows;  ///< Window lengths of accepted publishLoopMetrics() calls.
+
+    bool hasInterval = false;                   ///< Pending result of getNewSamplingIntervalMs().
+    unsigned long intervalMs = 0;
+    bool hasPolicy = false;                     ///< Pending result of getNewSamplingPolicy().
+    SamplingPolicy policy = {};
+    unsigned long configMessages = 0;           ///< Result of getConfigMessageCount().
+    bool configSynced = true;                   ///< Result of isConfigSynced().
+
+    void setup() override {}
+
+    bool connect() override {
+        connectCalls++;
+        connected = acceptConnect;
+        return connected;
+    }
+
+    void disconnect() override { connected = false; }
+    bool isConnected() override { return connected; }
+    void loop() override { loopCalls++; }
+
+    bool publishTemperature(const TemperatureSample& sample, uint32_t suppressedCount) override {
+        if (!canPublish()) return false;
+        samples.push_back(sample);
+        suppressed.push_back(suppressedCount);
+        return true;
+    }
+
+    bool publishTemperatureBatch(const TemperatureSample* batch, size_t count, bool) override {
+        if (!canPublish()) return false;
+        batched.insert(batched.end(), batch, batch + count);
+        return true;
+    }
+
+    bool publishTemperatureSummary(const WindowStatistics& statistics) override {
+        if (!canPublish()) return false;
+        summaries.push_back(statistics);
+        return true;
+    }
+
+    bool publishStatus(const char* statusMessage) override {
+        if (!canPublish()) return false;
+        statuses.push_back(statusMessage);
+        return true;
+    }
+
+    bool publishStatusReport(const StatusReport& report) override {
+        if (!canPublish()) return false;
+        reports.push_back(report);
+        return true;
+    }
+
+    bool publishLoopMetrics(const LoopProfiler&, unsigned long windowMs) override {
+        if (!canPublish()) return false;
+        metricsWindows.push_back(windowMs);
+        return true;
+    }
+
+    bool getNewSamplingIntervalMs(unsigned long& newIntervalMs) override {
+        if (!hasInterval) return false;
+        hasInterval = false;
+        newIntervalMs = intervalMs;
+        return true;
+    }
+
+    bool getNewSamplingPolicy(SamplingPolicy& newPolicy) override {
+        if (!hasPolicy) return false;
+        hasPolicy = false;
+        newPolicy = policy;
+        return true;
+    }
+
+    unsigned long getConfigMessageCount() const override { return configMessages; }
+    bool isConfigSynced() const override { return configSynced; }
+
+private:
+    bool canPublish() const { return connected && acceptPublish; }
+};
+
+#endif // FAKE_MQTT_MANAGER_H
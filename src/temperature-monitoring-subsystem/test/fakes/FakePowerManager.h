@@ -0,0 +1,38 @@
+#ifndef FAKE_POWER_MANAGER_H
+#define FAKE_POWER_MANAGER_H
+
+#include "kernel/api/PowerManager.h"
+
+/**
+ * @class FakePowerManager
+ * @brief Records deep sleep requests instead of sleeping.
+ *
+ * deepSleep() returns, so a test can build a new FSM around a copy of
+ * this fake with woke set to simulate the wake-up.
+ */
+class FakePowerManager : public PowerManager {
+public:
+    bool woke = false;                  ///< Result of wokeFromDeepSleep().
+    bool hasState = false;              ///< True once a state was saved.
+    DutyCycleState saved = {};          ///< State of the last deepSleep() call.
+    unsigned long sleepCalls = 0;       ///< Number of deepSleep() calls.
+    unsigned long lastSleepMs = 0;      ///< Duration of the last deepSleep() call.
+
+    void setup() override {}
+    bool wokeFromDeepSleep() const override { return woke; }
+
+    bool loadState(DutyCycleState& out) override {
+        if (!woke || !hasState) return false;
+        out = saved;
+        return true;
+    }
+
+    void deepSleep(const DutyCycleState& state, unsigned long durationMs) override {
+        saved = state;
+        hasState = true;
+        sleepCalls++;
+        lastSleepMs = durationMs;
+    }
+};
+
+#endif // FAKE_POWER_MANAGER_H
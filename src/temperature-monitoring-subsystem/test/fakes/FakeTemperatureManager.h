@@ -0,0 +1,26 @@
+#ifndef FAKE_TEMPERATURE_MANAGER_H
+#define FAKE_TEMPERATURE_MANAGER_H
+
+#include "devices/api/TemperatureManager.h"
+#include <math.h>
+
+/**
+ * @class FakeTemperatureManager
+ * @brief Returns a temperature set by the test.
+ */
+class FakeTemperatureManager : public TemperatureManager {
+public:
+    float temperature = 21.5f;  ///< Value readFrame() returns on every channel.
+    unsigned long reads = 0;    ///< Number of readFrame() calls.
+
+    void setup() override {}
+
+    void readFrame(TemperatureFrame& frame) override {
+        reads++;
+        for (int channel = 0; channel < TEMP_CHANNEL_COUNT; channel++) {
+            frame.centiDegrees[channel] = (int16_t)lroundf(temperature * 100.0f);
+        }
+    }
+};
+
+#endif // FAKE_TEMPERATURE_MANAGER_H
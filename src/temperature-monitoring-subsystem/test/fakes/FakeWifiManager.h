@@ -0,0 +1,43 @@
+#ifndef FAKE_WIFI_MANAGER_H
+#define FAKE_WIFI_MANAGER_H
+
+#include "kernel/connection/api/WifiManager.h"
+
+/**
+ * @class FakeWifiManager
+ * @brief Scripted WiFi connection: the test decides how each step ends.
+ */
+class FakeWifiManager : public WifiManager {
+public:
+    bool acceptBegin = true;                            ///< Result of beginConnect().
+    WifiConnectStatus pollResult = WIFI_CONNECT_PENDING; ///< Result of pollConnect() while connecting.
+    bool connected = false;                             ///< Result of isConnected().
+    unsigned long beginCalls = 0;                       ///< Number of beginConnect() calls.
+    unsigned long disconnectCalls = 0;                  ///< Number of disconnect() calls.
+    WifiConnectMetrics metrics = {};                    ///< Returned by getConnectMetrics().
+
+    void setup() override {}
+
+    bool beginConnect() override {
+        beginCalls++;
+        return acceptBegin;
+    }
+
+    WifiConnectStatus pollConnect() override {
+        if (pollResult == WIFI_CONNECT_SUCCESS) {
+            connected = true;
+        }
+        return pollResult;
+    }
+
+    bool isConnected() override { return connected; }
+    IPAddress getLocalIP() override { return connected ? IPAddress(192, 168, 1, 50) : IPAddress(); }
+    const WifiConnectMetrics& getConnectMetrics() const override { return metrics; }
+
+    void disconnect() override {
+        disconnectCalls++;
+        connected = false;
+    }
+};
+
+#endif // FAKE_WIFI_MANAGER_H
@@ -0,0 +1,26 @@
+#ifndef FAKE_IPADDRESS_H
+#define FAKE_IPADDRESS_H
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @class IPAddress
+ * @brief Minimal IPv4 address value type.
+ */
+class IPAddress {
+public:
+    IPAddress() : _value(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+        uint8_t bytes[4] = {a, b, c, d};
+        memcpy(&_value, bytes, sizeof(_value));
+    }
+    IPAddress(uint32_t value) : _value(value) {}
+    operator uint32_t() const { return _value; }
+    uint8_t operator[](int index) const { return reinterpret_cast<const uint8_t*>(&_value)[index]; }
+
+private:
+    uint32_t _value;
+};
+
+#endif // FAKE_IPADDRESS_H
@@ -0,0 +1,70 @@
+#ifndef FAKE_PREFERENCES_H
+#define FAKE_PREFERENCES_H
+
+#include <stdint.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace fake {
+
+/** @brief NVS contents: namespace -> key -> bytes. Survives Preferences instances like flash does. */
+inline std::map<std::string, std::map<std::string, std::vector<uint8_t>>> nvs;
+inline unsigned long nvsWrites = 0;     ///< Number of put operations, to check flash wear.
+
+} // namespace fake
+
+/**
+ * @class Preferences
+ * @brief In-memory replacement for the ESP32 NVS Preferences library.
+ */
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false) {
+        if (readOnly && fake::nvs.find(name) == fake::nvs.end()) {
+            return false;
+        }
+        _namespace = &fake::nvs[name];
+        return true;
+    }
+
+    void end() { _namespace = nullptr; }
+
+    bool remove(const char* key) { return _namespace && _namespace->erase(key) > 0; }
+
+    size_t putBytes(const char* key, const void* value, size_t length) {
+        if (!_namespace) return 0;
+        const uint8_t* bytes = static_cast<const uint8_t*>(value);
+        (*_namespace)[key].assign(bytes, bytes + length);
+        fake::nvsWrites++;
+        return length;
+    }
+
+    size_t getBytesLength(const char* key) {
+        if (!_namespace || _namespace->find(key) == _namespace->end()) return 0;
+        return (*_namespace)[key].size();
+    }
+
+    size_t getBytes(const char* key, void* buffer, size_t maxLength) {
+        size_t length = getBytesLength(key);
+        if (length == 0 || length > maxLength) return 0;
+        memcpy(buffer, (*_namespace)[key].data(), length);
+        return length;
+    }
+
+    size_t putUInt(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0) {
+        uint32_t value = defaultValue;
+        if (getBytesLength(key) == sizeof(value)) {
+            getBytes(key, &value, sizeof(value));
+        }
+        return value;
+    }
+
+private:
+    std::map<std::string, std::vector<uint8_t>>* _namespace = nullptr;
+};
+
+#endif // FAKE_PREFERENCES_H
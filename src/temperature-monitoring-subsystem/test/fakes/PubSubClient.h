@@ -0,0 +1,112 @@
+#ifndef FAKE_PUBSUBCLIENT_H
+#define FAKE_PUBSUBCLIENT_H
+
+/**
+ * @file PubSubClient.h
+ * @brief Host replacement for the PubSubClient MQTT library.
+ *
+ * Records publishes and subscriptions in the fake namespace and lets tests
+ * deliver messages through the callback registered by the firmware.
+ */
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#define MQTT_CALLBACK_SIGNATURE void (*callback)(char*, uint8_t*, unsigned int)
+
+namespace fake {
+
+/** @brief One message passed to PubSubClient::publish(). */
+struct MqttPublish {
+    std::string topic;
+    std::string payload;
+    bool retained;
+};
+
+inline bool mqttAcceptConnect = true;               ///< Result of the next connect() calls.
+inline bool mqttConnected = false;                  ///< Value of connected().
+inline bool mqttCleanSession = true;                ///< Clean session flag of the last connect().
+inline bool mqttAcceptPublish = true;               ///< Result of publish() while connected.
+inline std::vector<MqttPublish> mqttPublished;      ///< Accepted publishes, oldest first.
+inline std::vector<std::string> mqttSubscriptions;  ///< Subscribed topics.
+inline std::vector<uint8_t> mqttSubscriptionQos;    ///< QoS of each subscription.
+inline void (*mqttCallback)(char*, uint8_t*, unsigned int) = nullptr; ///< Registered message callback.
+
+inline void resetMqtt() {
+    mqttAcceptConnect = true;
+    mqttConnected = false;
+    mqttCleanSession = true;
+    mqttAcceptPublish = true;
+    mqttPublished.clear();
+    mqttSubscriptions.clear();
+    mqttSubscriptionQos.clear();
+}
+
+/** @brief Delivers a message to the firmware as if it arrived from the broker. */
+inline void deliverMqtt(const char* topic, const char* payload) {
+    if (!mqttCallback) return;
+    std::string topicCopy(topic);
+    std::vector<uint8_t> payloadCopy(payload, payload + strlen(payload));
+    mqttCallback(&topicCopy[0], payloadCopy.data(), (unsigned int)payloadCopy.size());
+}
+
+} // namespace fake
+
+class PubSubClient {
+public:
+    PubSubClient() {}
+    explicit PubSubClient(WiFiClient&) {}
+
+    PubSubClient& setServer(const char*, uint16_t) { return *this; }
+    PubSubClient& setCallback(MQTT_CALLBACK_SIGNATURE) {
+        fake::mqttCallback = callback;
+        return *this;
+    }
+    PubSubClient& setKeepAlive(uint16_t) { return *this; }
+    PubSubClient& setSocketTimeout(uint16_t) { return *this; }
+    bool setBufferSize(uint16_t size) {
+        _bufferSize = size;
+        return true;
+    }
+    uint16_t getBufferSize() { return _bufferSize; }
+
+    bool connect(const char*) {
+        return connect(nullptr, nullptr, nullptr, nullptr, 0, false, nullptr, true);
+    }
+    bool connect(const char*, const char*, const char*, const char*, uint8_t, bool, const char*, bool cleanSession) {
+        fake::mqttCleanSession = cleanSession;
+        fake::mqttConnected = fake::mqttAcceptConnect;
+        return fake::mqttConnected;
+    }
+    void disconnect() { fake::mqttConnected = false; }
+    bool connected() { return fake::mqttConnected; }
+    bool loop() { return fake::mqttConnected; }
+    int state() { return fake::mqttConnected ? 0 : -2; }
+
+    bool subscribe(const char* topic, uint8_t qos = 0) {
+        fake::mqttSubscriptions.push_back(topic);
+        fake::mqttSubscriptionQos.push_back(qos);
+        return fake::mqttConnected;
+    }
+
+    bool publish(const char* topic, const char* payload, bool retained = false) {
+        return publish(topic, reinterpret_cast<const uint8_t*>(payload), (unsigned int)strlen(payload), retained);
+    }
+
+    bool publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained) {
+        // The real client drops packets larger than its buffer
+        if (!fake::mqttConnected || !fake::mqttAcceptPublish || 5 + 2 + strlen(topic) + length > _bufferSize) {
+            return false;
+        }
+        fake::mqttPublished.push_back({topic, std::string(reinterpret_cast<const char*>(payload), length), retained});
+        return true;
+    }
+
+private:
+    uint16_t _bufferSize = 256;
+};
+
+#endif // FAKE_PUBSUBCLIENT_H
@@ -0,0 +1,14 @@
+#ifndef FAKE_WIFI_CLIENT_H
+#define FAKE_WIFI_CLIENT_H
+
+/**
+ * @class WiFiClient
+ * @brief Placeholder TCP client; the fake PubSubClient never touches it.
+ */
+class WiFiClient {
+public:
+    bool connected() { return false; }
+    void setNoDelay(bool) {}
+};
+
+#endif // FAKE_WIFI_CLIENT_H
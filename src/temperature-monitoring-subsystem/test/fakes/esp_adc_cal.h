@@ -0,0 +1,62 @@
+#ifndef FAKE_ESP_ADC_CAL_H
+#define FAKE_ESP_ADC_CAL_H
+
+#include <stdint.h>
+
+/**
+ * @file esp_adc_cal.h
+ * @brief Host replacement for the ESP-IDF ADC calibration API.
+ *
+ * Characterizes every chip with a linear curve of fake::adcCoeffA / 65536
+ * millivolts per code (the same fixed-point scaling the IDF uses) plus
+ * fake::adcCoeffB millivolts.
+ */
+
+typedef enum { ADC_UNIT_1, ADC_UNIT_2 } adc_unit_t;
+typedef enum { ADC_ATTEN_DB_0, ADC_ATTEN_DB_2_5, ADC_ATTEN_DB_6, ADC_ATTEN_DB_11 } adc_atten_t;
+typedef enum { ADC_WIDTH_BIT_12 = 3 } adc_bits_width_t;
+typedef enum {
+    ESP_ADC_CAL_VAL_EFUSE_VREF,
+    ESP_ADC_CAL_VAL_EFUSE_TP,
+    ESP_ADC_CAL_VAL_DEFAULT_VREF,
+    ESP_ADC_CAL_VAL_EFUSE_TP_FIT
+} esp_adc_cal_value_t;
+
+typedef struct {
+    adc_unit_t adc_num;
+    adc_atten_t atten;
+    adc_bits_width_t bit_width;
+    uint32_t coeff_a;
+    uint32_t coeff_b;
+    uint32_t vref;
+    const uint32_t* low_curve;
+    const uint32_t* high_curve;
+    uint8_t version;
+} esp_adc_cal_characteristics_t;
+
+namespace fake {
+
+inline uint32_t adcCoeffA = 49152;          ///< 0.75 mV per code.
+inline uint32_t adcCoeffB = 0;              ///< Offset in mV.
+inline unsigned long adcCalConversions = 0; ///< Calls to esp_adc_cal_raw_to_voltage().
+
+} // namespace fake
+
+inline esp_adc_cal_value_t esp_adc_cal_characterize(adc_unit_t unit, adc_atten_t atten, adc_bits_width_t width,
+                                                    uint32_t defaultVref, esp_adc_cal_characteristics_t* chars) {
+    *chars = {};
+    chars->adc_num = unit;
+    chars->atten = atten;
+    chars->bit_width = width;
+    chars->coeff_a = fake::adcCoeffA;
+    chars->coeff_b = fake::adcCoeffB;
+    chars->vref = defaultVref;
+    return ESP_ADC_CAL_VAL_EFUSE_TP_FIT;
+}
+
+inline uint32_t esp_adc_cal_raw_to_voltage(uint32_t raw, const esp_adc_cal_characteristics_t* chars) {
+    fake::adcCalConversions++;
+    return (uint32_t)(((uint64_t)raw * chars->coeff_a + 32768) / 65536) + chars->coeff_b;
+}
+
+#endif // FAKE_ESP_ADC_CAL_H
@@ -0,0 +1,130 @@
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "kernel/connection/api/BinaryTelemetry.h"
+
+namespace {
+
+uint8_t record[256];
+
+uint32_t readU32(const uint8_t* in) {
+    return in[0] | (in[1] << 8) | (in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+} // namespace
+
+void setUp() {
+    memset(record, 0xAA, sizeof(record));
+}
+
+void tearDown() {}
+
+void test_single_sample_layout() {
+    TemperatureSample sample = {0x01020304, 23.45f, 0x0A0B0C0D};
+    size_t length = BinaryTelemetry::encodeSamples(record, sizeof(record), &sample, 1, 0, 3);
+    const uint8_t expected[] = {
+        BINARY_TELEMETRY_VERSION, 0x00, 0x03, 0x00,     // version, flags, suppressed
+        0x0D, 0x0C, 0x0B, 0x0A,                         // sequence
+        0x04, 0x03, 0x02, 0x01,                         // timestamp
+        0x29, 0x09,                                     // 2345 centi-degrees
+    };
+    TEST_ASSERT_EQUAL(sizeof(expected), length);
+    TEST_ASSERT_EQUAL_MEMORY(expected, record, sizeof(expected));
+}
+
+void test_batch_flags_and_entries() {
+    TemperatureSample samples[3] = {{1000, 20.0f, 7}, {2000, -5.5f, 8}, {3000, 21.0f, 9}};
+    size_t length = BinaryTelemetry::encodeSamples(record, sizeof(record), samples, 3,
+                                                   BINARY_FLAG_BATCH | BINARY_FLAG_BACKLOG, 0);
+    TEST_ASSERT_EQUAL(BINARY_TEMPERATURE_HEADER_LEN + 3 * BINARY_SAMPLE_ENTRY_LEN, length);
+    TEST_ASSERT_EQUAL(BINARY_FLAG_BATCH | BINARY_FLAG_BACKLOG, record[1] & 0x0F);
+
+    const uint8_t* second = record + BINARY_TEMPERATURE_HEADER_LEN + BINARY_SAMPLE_ENTRY_LEN;
+    TEST_ASSERT_EQUAL(8, readU32(second));
+    TEST_ASSERT_EQUAL(2000, readU32(second + 4));
+    TEST_ASSERT_EQUAL(-550, (int16_t)(second[8] | (second[9] << 8)));
+}
+
+void test_channel_readings_follow_control_temperature() {
+    TemperatureSample samples[2] = {{1000, 23.0f, 7}, {2000, 24.0f, 8}};
+    for (int channel = 0; channel < TEMP_CHANNEL_COUNT; channel++) {
+        samples[1].frame.centiDegrees[channel] = (int16_t)(2100 + 100 * channel);
+    }
+    size_t length = BinaryTelemetry::encodeSamples(record, sizeof(record), samples, 2, BINARY_FLAG_BATCH, 0);
+    TEST_ASSERT_EQUAL(BINARY_TEMPERATURE_HEADER_LEN + 2 * BINARY_SAMPLE_ENTRY_LEN, length);
+    TEST_ASSERT_EQUAL(BINARY_SAMPLE_CHANNELS, record[1] >> BINARY_FLAG_CHANNELS_SHIFT);
+
+    const uint8_t* second = record + BINARY_TEMPERATURE_HEADER_LEN + BINARY_SAMPLE_ENTRY_LEN;
+    TEST_ASSERT_EQUAL(8, readU32(second));
+    TEST_ASSERT_EQUAL(2400, (int16_t)(second[8] | (second[9] << 8)));
+    for (size_t channel = 0; channel < BINARY_SAMPLE_CHANNELS; channel++) {
+        const uint8_t* value = second + 10 + 2 * channel;
+        TEST_ASSERT_EQUAL((int)(2100 + 100 * channel), (int16_t)(value[0] | (value[1] << 8)));
+    }
+}
+
+void test_encoding_rejects_small_buffer() {
+    TemperatureSample sample = {1, 20.0f, 1};
+    TEST_ASSERT_EQUAL(0, BinaryTelemetry::encodeSamples(record, 13, &sample, 1, 0, 0));
+    TEST_ASSERT_EQUAL(0, BinaryTelemetry::encodeSamples(record, sizeof(record), &sample, 0, 0, 0));
+}
+
+void test_centi_degrees_rounded_and_clamped() {
+    TEST_ASSERT_EQUAL(2346, BinaryTelemetry::toCentiDegrees(23.456f));
+    TEST_ASSERT_EQUAL(-1, BinaryTelemetry::toCentiDegrees(-0.006f));
+    TEST_ASSERT_EQUAL(INT16_MAX, BinaryTelemetry::toCentiDegrees(1000.0f));
+    TEST_ASSERT_EQUAL(INT16_MIN, BinaryTelemetry::toCentiDegrees(-1000.0f));
+}
+
+void test_suppressed_saturates() {
+    TemperatureSample sample = {1, 20.0f, 1};
+    BinaryTelemetry::encodeSamples(record, sizeof(record), &sample, 1, 0, 70000);
+    TEST_ASSERT_EQUAL(0xFF, record[2]);
+    TEST_ASSERT_EQUAL(0xFF, record[3]);
+}
+
+void test_plain_status() {
+    size_t length = BinaryTelemetry::encodeStatus(record, sizeof(record), "online", nullptr, HeapMetrics());
+    TEST_ASSERT_EQUAL(BINARY_STATUS_HEADER_LEN, length);
+    TEST_ASSERT_EQUAL(BINARY_TELEMETRY_VERSION, record[0]);
+    TEST_ASSERT_EQUAL(BINARY_STATUS_ONLINE, record[1]);
+    BinaryTelemetry::encodeStatus(record, sizeof(record), "rebooting", nullptr, HeapMetrics());
+    TEST_ASSERT_EQUAL(BINARY_STATUS_OTHER, record[1]);
+}
+
+void test_status_report_fields() {
+    StatusReport report = {};
+    report.status = "online";
+    report.uptimeMs = 123456;
+    report.wifi.fastPath = true;
+    report.wifi.totalMs = 850;
+    report.suppressedSamples = 42;
+    report.reconnectBackoffMs = 7300;
+    HeapMetrics heap = {200000, 150000, 100000};
+
+    size_t length = BinaryTelemetry::encodeStatus(record, sizeof(record), report.status, &report, heap);
+    TEST_ASSERT_EQUAL(BINARY_STATUS_HEADER_LEN + 4 * BINARY_STATUS_FIELD_COUNT, length);
+    TEST_ASSERT_EQUAL(BINARY_FLAG_WIFI_FAST_PATH, record[2]);
+
+    const uint8_t* fields = record + BINARY_STATUS_HEADER_LEN;
+    TEST_ASSERT_EQUAL(123456, readU32(fields + 4 * BINARY_STATUS_UPTIME_MS));
+    TEST_ASSERT_EQUAL(150000, readU32(fields + 4 * BINARY_STATUS_MIN_FREE_HEAP));
+    TEST_ASSERT_EQUAL(850, readU32(fields + 4 * BINARY_STATUS_WIFI_TOTAL_MS));
+    TEST_ASSERT_EQUAL(42, readU32(fields + 4 * BINARY_STATUS_SUPPRESSED_SAMPLES));
+    TEST_ASSERT_EQUAL(7300, readU32(fields + 4 * BINARY_STATUS_RECONNECT_BACKOFF_MS));
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    if (TEMP_CHANNEL_COUNT == 1) {
+        RUN_TEST(test_single_sample_layout);
+    }
+    RUN_TEST(test_batch_flags_and_entries);
+    RUN_TEST(test_channel_readings_follow_control_temperature);
+    RUN_TEST(test_encoding_rejects_small_buffer);
+    RUN_TEST(test_centi_degrees_rounded_and_clamped);
+    RUN_TEST(test_suppressed_saturates);
+    RUN_TEST(test_plain_status);
+    RUN_TEST(test_status_report_fields);
+    return UNITY_END();
+}
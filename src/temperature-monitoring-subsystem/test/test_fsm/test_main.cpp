@@ -0,0 +1,791 @@
+#include <unity.h>
+#include <Arduino.h>
+#include "FakeLedStatus.h"
+#include "FakeMqttManager.h"
+#include "FakePowerManager.h"
+#include "FakeTemperatureManager.h"
+#include "FakeWifiManager.h"
+#include "kernel/api/FsmManagerImpl.h"
+#include "kernel/api/LoopProfiler.h"
+#include "kernel/api/PolledSampleSourceImpl.h"
+#include "kernel/api/RtcSampleStoreImpl.h"
+
+namespace {
+
+const unsigned long BOOT_TIME_MS = 1000;    ///< Clock value when the FSM is set up.
+
+/**
+ * @struct Rig
+ * @brief The FSM wired to fakes, rebuilt for every test.
+ */
+struct Rig {
+    FakeLedStatus led;
+    FakeTemperatureManager temperature;
+    FakeWifiManager wifi;
+    FakeMqttManager mqtt;
+    PolledSampleSourceImpl source{temperature};
+    RtcSampleStoreImpl store;
+    LoopProfiler profiler;
+    FakePowerManager power;
+    FsmManagerImpl fsm;
+
+    explicit Rig(bool dutyCycled = false)
+        : fsm(led, source, wifi, mqtt, store, &profiler, dutyCycled ? &power : nullptr) {}
+};
+
+Rig* rig = nullptr;
+
+/** @brief Runs one FSM cycle and returns the resulting state. */
+SystemState step() {
+    rig->fsm.run();
+    return rig->fsm.getCurrentState();
+}
+
+/** @brief Drives a fresh FSM through the connection sequence into STATE_OPERATIONAL. */
+void connect() {
+    rig->wifi.pollResult = WIFI_CONNECT_SUCCESS;
+    for (int i = 0; i < 10 && rig->fsm.getCurrentState() != STATE_OPERATIONAL; i++) {
+        step();
+    }
+}
+
+/**
+ * @brief Replaces the rig with a deep sleeping one, booted at bootTime.
+ * @param slept Power manager of the rig that went to sleep, to simulate its wake-up; nullptr for a cold boot.
+ */
+void startDutyCycled(unsigned long bootTime, const FakePowerManager* slept = nullptr) {
+    FakePowerManager previous;
+    if (slept) {
+        previous = *slept;
+    }
+    delete rig;
+
+    // The RTC sample queue is kept, like across a real deep sleep
+    fake::setMillis(bootTime);
+    rig = new Rig(true);
+    if (slept) {
+        rig->power = previous;
+        rig->power.woke = true;
+    }
+    rig->store.setup();
+    rig->fsm.setup();
+    rig->source.setup();
+}
+
+/** @brief Advances to the next sampling period and runs its sample through STATE_SENDING_DATA. */
+void sampleNext(float temperature) {
+    rig->temperature.temperature = temperature;
+    fake::advanceMillis(rig->fsm.getCurrentSamplingInterval());
+    while (step() != STATE_OPERATIONAL) {}
+}
+
+/** @brief Policy with one threshold at 25 °C: 10 s below it, 2 s at or above it. */
+SamplingPolicy twoBandPolicy() {
+    SamplingPolicy policy = {};
+    policy.bandCount = 2;
+    policy.thresholds[0] = 25.0f;
+    policy.intervalsMs[0] = 10000;
+    policy.intervalsMs[1] = 2000;
+    return policy;
+}
+
+} // namespace
+
+void setUp() {
+    fake::reset();
+    fake::setMillis(BOOT_TIME_MS);
+    rig = new Rig();
+    rig->store.setup();
+    rig->store.discard(rig->store.size()); // RTC queue state outlives the previous test
+    rig->fsm.setup();
+    rig->source.setup();
+}
+
+void tearDown() {
+    delete rig;
+    rig = nullptr;
+}
+
+void test_initializing_to_wifi_connecting() {
+    TEST_ASSERT_EQUAL(STATE_INITIALIZING, rig->fsm.getCurrentState());
+    TEST_ASSERT_EQUAL(STATE_WIFI_CONNECTING, step());
+    TEST_ASSERT_EQUAL(1, rig->wifi.beginCalls);
+    TEST_ASSERT_EQUAL(FakeLedStatus::WIFI_CONNECTING, rig->led.last);
+}
+
+void test_initializing_to_network_error_when_begin_fails() {
+    rig->wifi.acceptBegin = false;
+    TEST_ASSERT_EQUAL(STATE_NETWORK_ERROR, step());
+    TEST_ASSERT_EQUAL(FakeLedStatus::NETWORK_ERROR, rig->led.last);
+}
+
+void test_wifi_connecting_waits_while_pending() {
+    step();
+    for (int i = 0; i < 100; i++) {
+        fake::advanceMillis(10);
+        TEST_ASSERT_EQUAL(STATE_WIFI_CONNECTING, step());
+    }
+}
+
+void test_wifi_connecting_to_wifi_connected() {
+    step();
+    rig->wifi.pollResult = WIFI_CONNECT_SUCCESS;
+    TEST_ASSERT_EQUAL(STATE_WIFI_CONNECTED, step());
+}
+
+void test_wifi_connecting_to_network_error_on_failure() {
+    step();
+    rig->wifi.pollResult = WIFI_CONNECT_FAILED;
+    TEST_ASSERT_EQUAL(STATE_NETWORK_ERROR, step());
+    TEST_ASSERT_EQUAL(FakeLedStatus::NETWORK_ERROR, rig->led.last);
+}
+
+void test_wifi_connected_to_mqtt_connecting() {
+    rig->wifi.pollResult = WIFI_CONNECT_SUCCESS;
+    step();
+    step();
+    TEST_ASSERT_EQUAL(STATE_MQTT_CONNECTING, step());
+    TEST_ASSERT_EQUAL(FakeLedStatus::MQTT_CONNECTING, rig->led.last);
+}
+
+void test_mqtt_connecting_to_operational() {
+    connect();
+    TEST_ASSERT_EQUAL(STATE_OPERATIONAL, rig->fsm.getCurrentState());
+    TEST_ASSERT_EQUAL(FakeLedStatus::OPERATIONAL, rig->led.last);
+    TEST_ASSERT_EQUAL(1, rig->mqtt.reports.size());
+    TEST_ASSERT_EQUAL_STRING("online", rig->mqtt.reports[0].status);
+}
+
+void test_mqtt_connecting_retries_after_interval() {
+    rig->wifi.pollResult = WIFI_CONNECT_SUCCESS;
+    rig->mqtt.acceptConnect = false;
+    step();
+    step();
+    step();
+    TEST_ASSERT_EQUAL(STATE_MQTT_CONNECTING, step());
+    TEST_ASSERT_EQUAL(1, rig->mqtt.connectCalls);
+
+    // The jittered wait is between half and all of the base interval
+    fake::advanceMillis(MQTT_RECONNECT_INTERVAL_MS / 2 - 1);
+    TEST_ASSERT_EQUAL(STATE_MQTT_CONNECTING, step());
+    TEST_ASSERT_EQUAL(1, rig->mqtt.connectCalls);
+
+    fake::advanceMillis(MQTT_RECONNECT_INTERVAL_MS - MQTT_RECONNECT_INTERVAL_MS / 2 + 1);
+    rig->mqtt.acceptConnect = true;
+    step();
+    TEST_ASSERT_EQUAL(2, rig->mqtt.connectCalls);
+    TEST_ASSERT_EQUAL(STATE_OPERATIONAL, step());
+}
+
+void test_mqtt_connecting_to_network_error_when_wifi_lost() {
+    rig->wifi.pollResult = WIFI_CONNECT_SUCCESS;
+    rig->mqtt.acceptConnect = false;
+    step();
+    step();
+    step();
+    step();
+    rig->wifi.connected = false;
+    TEST_ASSERT_EQUAL(STATE_NETWORK_ERROR, step());
+}
+
+void test_mqtt_connecting_waits_for_retained_config() {
+    rig->mqtt.configSynced = false;
+    connect();
+    TEST_ASSERT_EQUAL(STATE_MQTT_CONNECTING, rig->fsm.getCurrentState());
+
+    // The retained override arrives: the run that goes operational has already applied it
+    fake::advanceMillis(30);
+    rig->mqtt.hasInterval = true;
+    rig->mqtt.intervalMs = 3000;
+    rig->mqtt.configSynced = true;
+    TEST_ASSERT_EQUAL(STATE_OPERATIONAL, step());
+    TEST_ASSERT_EQUAL(3000, rig->fsm.getCurrentSamplingInterval());
+    TEST_ASSERT_EQUAL(1, rig->mqtt.connectCalls);
+}
+
+void test_mqtt_connecting_gives_up_on_missing_config() {
+    rig->mqtt.configSynced = false;
+    connect();
+    fake::advanceMillis(MQTT_CONFIG_SYNC_TIMEOUT_MS - 1);
+    TEST_ASSERT_EQUAL(STATE_MQTT_CONNECTING, step());
+
+    fake::advanceMillis(1);
+    TEST_ASSERT_EQUAL(STATE_OPERATIONAL, step());
+    TEST_ASSERT_EQUAL(TEMP_SAMPLE_INTERVAL_DEFAULT_MS, rig->fsm.getCurrentSamplingInterval());
+    TEST_ASSERT_EQUAL(1, rig->mqtt.connectCalls);
+}
+
+void test_operational_to_sampling_to_sending() {
+    connect();
+    fake::advanceMillis(TEMP_SAMPLE_INTERVAL_DEFAULT_MS);
+    rig->temperature.temperature = 23.25f;
+
+    TEST_ASSERT_EQUAL(STATE_SAMPLING_TEMPERATURE, step());
+    TEST_ASSERT_EQUAL(STATE_SENDING_DATA, step());
+    TEST_ASSERT_EQUAL_FLOAT(23.25f, rig->fsm.getCurrentTemperature());
+    TEST_ASSERT_EQUAL(STATE_OPERATIONAL, step());
+
+    TEST_ASSERT_EQUAL(1, rig->mqtt.samples.size());
+    TEST_ASSERT_EQUAL_FLOAT(23.25f, rig->mqtt.samples[0].temperature);
+    TEST_ASSERT_EQUAL(BOOT_TIME_MS + TEMP_SAMPLE_INTERVAL_DEFAULT_MS, rig->mqtt.samples[0].timestampMs);
+}
+
+void test_operational_stays_until_sample_due() {
+    connect();
+    fake::advanceMillis(TEMP_SAMPLE_INTERVAL_DEFAULT_MS - 1);
+    TEST_ASSERT_EQUAL(STATE_OPERATIONAL, step());
+    TEST_ASSERT_EQUAL(0, rig->mqtt.samples.size());
+}
+
+void test_sending_failure_queues_sample() {
+    connect();
+    step(); // Drains the sample taken while connecting
+    size_t backlog = rig->store.size();
+
+    fake::advanceMillis(TEMP_SAMPLE_INTERVAL_DEFAULT_MS);
+    rig->mqtt.acceptPublish = false;
+    step();
+    step();
+    TEST_ASSERT_EQUAL(STATE_OPERATIONAL, step());
+    TEST_ASSERT_EQUAL(backlog + 1, rig->store.size());
+}
+
+void test_backlog_drained_when_operational() {
+    // The sample due at boot is taken offline while WiFi connects
+    step();
+    TEST_ASSERT_EQUAL(1, rig->store.size());
+
+    connect();
+    fake::advanceMillis(STORE_FORWARD_DRAIN_INTERVAL_MS);
+    step();
+    TEST_ASSERT_EQUAL(0, rig->store.size());
+    TEST_ASSERT_EQUAL(1, rig->mqtt.batched.size());
+}
+
+void test_operational_to_network_error_on_mqtt_loss() {
+    connect();
+    rig->mqtt.connected = false;
+    TEST_ASSERT_EQUAL(STATE_NETWORK_ERROR, step());
+    TEST_ASSERT_EQUAL(FakeLedStatus::NETWORK_ERROR, rig->led.last);
+}
+
+void test_operational_to_network_error_on_wifi_loss() {
+    connect();
+    rig->wifi.connected = false;
+    TEST_ASSERT_EQUAL(STATE_NETWORK_ERROR, step());
+}
+
+void test_network_error_to_wait_reconnect() {
+    connect();
+    rig->wifi.connected = false;
+    step();
+    TEST_ASSERT_EQUAL(STATE_WAIT_RECONNECT, step());
+    TEST_ASSERT_FALSE(rig->mqtt.isConnected());
+}
+
+void test_wait_reconnect_to_initializing_after_interval() {
+    rig->wifi.acceptBegin = false;
+    step();
+    TEST_ASSERT_EQUAL(STATE_WAIT_RECONNECT, step());
+
+    fake::advanceMillis(WIFI_RECONNECT_INTERVAL_MS / 2 - 1);
+    TEST_ASSERT_EQUAL(STATE_WAIT_RECONNECT, step());
+
+    fake::advanceMillis(WIFI_RECONNECT_INTERVAL_MS - WIFI_RECONNECT_INTERVAL_MS / 2 + 1);
+    TEST_ASSERT_EQUAL(STATE_INITIALIZING, step());
+    rig->wifi.acceptBegin = true;
+    TEST_ASSERT_EQUAL(STATE_WIFI_CONNECTING, step());
+    TEST_ASSERT_EQUAL(2, rig->wifi.beginCalls);
+}
+
+void test_samples_stored_while_offline() {
+    rig->wifi.acceptBegin = false;
+    for (int i = 0; i < 5; i++) {
+        step();
+        fake::advanceMillis(TEMP_SAMPLE_INTERVAL_DEFAULT_MS);
+    }
+    TEST_ASSERT_EQUAL(5, rig->store.size());
+    TEST_ASSERT_EQUAL(0, rig->source.getOverrunCount());
+}
+
+void test_run_never_blocks() {
+    // A full connect, sample, outage and reconnect cycle without delay() and without time passing inside run()
+    rig->wifi.pollResult = WIFI_CONNECT_SUCCESS;
+    for (int i = 0; i < 50; i++) {
+        unsigned long before = millis();
+        step();
+        TEST_ASSERT_EQUAL(before, millis());
+        if (i == 20) {
+            rig->wifi.connected = false;
+        }
+        fake::advanceMillis(TEMP_SAMPLE_INTERVAL_DEFAULT_MS / 4);
+    }
+    TEST_ASSERT_EQUAL(0, fake::delayCalls);
+    TEST_ASSERT_EQUAL(2, rig->wifi.beginCalls);
+    TEST_ASSERT_TRUE(rig->mqtt.samples.size() > 0);
+}
+
+void test_deadline_immediate_in_transient_states() {
+    TEST_ASSERT_EQUAL(millis(), rig->fsm.getNextDeadline(millis())); // INITIALIZING
+
+    rig->wifi.pollResult = WIFI_CONNECT_SUCCESS;
+    step();
+    TEST_ASSERT_EQUAL(STATE_WIFI_CONNECTED, step());
+    TEST_ASSERT_EQUAL(millis(), rig->fsm.getNextDeadline(millis()));
+}
+
+void test_deadline_operational_polls_until_sample_due() {
+    connect();
+    while (step() != STATE_OPERATIONAL) {} // Publish the sample due at boot
+    unsigned long now = millis();
+    TEST_ASSERT_EQUAL(now + IDLE_POLL_INTERVAL_MS, rig->fsm.getNextDeadline(now));
+
+    fake::setMillis(BOOT_TIME_MS + TEMP_SAMPLE_INTERVAL_DEFAULT_MS - 5);
+    TEST_ASSERT_EQUAL(millis() + 5, rig->fsm.getNextDeadline(millis()));
+
+    fake::advanceMillis(5);
+    TEST_ASSERT_EQUAL(millis(), rig->fsm.getNextDeadline(millis()));
+    TEST_ASSERT_EQUAL(STATE_SAMPLING_TEMPERATURE, step());
+}
+
+void test_deadline_offline_sleeps_until_sample_or_retry() {
+    rig->wifi.acceptBegin = false;
+    TEST_ASSERT_EQUAL(STATE_NETWORK_ERROR, step()); // Also stores the sample due at boot
+    rig->source.setIntervalMs(4000);
+    TEST_ASSERT_EQUAL(STATE_WAIT_RECONNECT, step());
+
+    // No polling while offline: only the next offline sample and the retry are deadlines
+    TEST_ASSERT_EQUAL(BOOT_TIME_MS + 4000, rig->fsm.getNextDeadline(millis()));
+
+    fake::setMillis(BOOT_TIME_MS + 4000);
+    step();
+    TEST_ASSERT_EQUAL(BOOT_TIME_MS + 8000, rig->fsm.getNextDeadline(millis()));
+
+    // The retry comes before the sample due at 12000, within the jittered range
+    fake::setMillis(BOOT_TIME_MS + 4000);
+    unsigned long retry = rig->fsm.getNextDeadline(millis() + 4000) - BOOT_TIME_MS;
+    TEST_ASSERT_TRUE(retry >= WIFI_RECONNECT_INTERVAL_MS / 2 && retry <= WIFI_RECONNECT_INTERVAL_MS);
+}
+
+void test_backoff_grows_per_failure_and_resets_when_operational() {
+    rig->wifi.pollResult = WIFI_CONNECT_SUCCESS;
+    rig->mqtt.acceptConnect = false;
+    connect();
+    TEST_ASSERT_EQUAL(STATE_MQTT_CONNECTING, rig->fsm.getCurrentState());
+
+    // Each failure waits longer, until the cap
+    unsigned long waits[8];
+    for (int i = 0; i < 8; i++) {
+        unsigned long attempts = rig->mqtt.connectCalls;
+        unsigned long start = millis();
+        while (rig->mqtt.connectCalls == attempts) {
+            fake::setMillis(rig->fsm.getNextDeadline(millis()));
+            step();
+        }
+        waits[i] = millis() - start;
+    }
+    unsigned long ceiling = MQTT_RECONNECT_INTERVAL_MS;
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_TRUE(waits[i] >= ceiling / 2 && waits[i] <= ceiling);
+        ceiling = ceiling * 2 > MQTT_RECONNECT_MAX_INTERVAL_MS ? MQTT_RECONNECT_MAX_INTERVAL_MS : ceiling * 2;
+    }
+
+    // The outage is reported once operational
+    rig->mqtt.acceptConnect = true;
+    while (!rig->mqtt.connected) {
+        fake::setMillis(rig->fsm.getNextDeadline(millis()));
+        step();
+    }
+    TEST_ASSERT_EQUAL(STATE_OPERATIONAL, step());
+    TEST_ASSERT_EQUAL(9, rig->mqtt.reports.back().reconnectFailures);
+    TEST_ASSERT_TRUE(rig->mqtt.reports.back().reconnectBackoffMs >= MQTT_RECONNECT_MAX_INTERVAL_MS / 2);
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_TRUE(rig->mqtt.reports.back().reconnectBackoffMs >= waits[i]);
+    }
+
+    // The next outage starts over from the base interval
+    rig->mqtt.connected = false;
+    rig->mqtt.acceptConnect = false;
+    step();
+    TEST_ASSERT_EQUAL(STATE_WAIT_RECONNECT, step());
+    unsigned long attempts = rig->mqtt.connectCalls;
+    while (rig->mqtt.connectCalls == attempts) {
+        fake::setMillis(rig->fsm.getNextDeadline(millis()));
+        step();
+    }
+    unsigned long start = millis();
+    while (rig->mqtt.connectCalls == attempts + 1) {
+        fake::setMillis(rig->fsm.getNextDeadline(millis()));
+        step();
+    }
+    TEST_ASSERT_TRUE(millis() - start <= MQTT_RECONNECT_INTERVAL_MS);
+}
+
+void test_jitter_differs_between_devices() {
+    unsigned long waits[2];
+    for (int device = 0; device < 2; device++) {
+        delete rig;
+        fake::setMillis(BOOT_TIME_MS);
+        fake::efuseMac = 0x0000A1B2C3D4E5F6ULL + ((uint64_t)device << 40);
+        rig = new Rig();
+        rig->store.setup();
+        rig->fsm.setup();
+        rig->source.setup();
+
+        rig->wifi.acceptBegin = false;
+        step();
+        step();
+        waits[device] = rig->fsm.getNextDeadline(millis()) - millis();
+    }
+    TEST_ASSERT_TRUE(waits[0] != waits[1]);
+}
+
+void test_policy_switches_interval_on_band_change() {
+    rig->mqtt.policy = twoBandPolicy();
+    rig->mqtt.hasPolicy = true;
+    connect();
+    TEST_ASSERT_EQUAL(10000, rig->fsm.getCurrentSamplingInterval());
+
+    rig->temperature.temperature = 26.0f;
+    fake::advanceMillis(10000);
+    step();
+    step();
+    TEST_ASSERT_EQUAL(2000, rig->fsm.getCurrentSamplingInterval());
+
+    rig->temperature.temperature = 24.0f;
+    step();
+    fake::advanceMillis(2000);
+    step();
+    step();
+    TEST_ASSERT_EQUAL(10000, rig->fsm.getCurrentSamplingInterval());
+}
+
+void test_override_takes_precedence_over_policy() {
+    rig->mqtt.policy = twoBandPolicy();
+    rig->mqtt.hasPolicy = true;
+    connect();
+    rig->mqtt.intervalMs = 5000;
+    rig->mqtt.hasInterval = true;
+    step();
+    TEST_ASSERT_EQUAL(5000, rig->fsm.getCurrentSamplingInterval());
+
+    rig->temperature.temperature = 26.0f;
+    fake::advanceMillis(5000);
+    step();
+    step();
+    TEST_ASSERT_EQUAL(5000, rig->fsm.getCurrentSamplingInterval());
+
+    // Clearing the override hands control back to the policy with the next sample
+    rig->mqtt.intervalMs = 0;
+    rig->mqtt.hasInterval = true;
+    step();
+    fake::advanceMillis(5000);
+    step();
+    step();
+    TEST_ASSERT_EQUAL(2000, rig->fsm.getCurrentSamplingInterval());
+}
+
+void test_loop_metrics_published_periodically() {
+    connect();
+    rig->profiler.record(STATE_OPERATIONAL, 20);
+
+    fake::setMillis(LOOP_METRICS_INTERVAL_MS - 1);
+    step();
+    TEST_ASSERT_EQUAL(0, rig->mqtt.metricsWindows.size());
+
+    fake::setMillis(LOOP_METRICS_INTERVAL_MS);
+    while (rig->fsm.getCurrentState() != STATE_OPERATIONAL) {
+        step();
+    }
+    step();
+    TEST_ASSERT_EQUAL(1, rig->mqtt.metricsWindows.size());
+    TEST_ASSERT_EQUAL(LOOP_METRICS_INTERVAL_MS, rig->mqtt.metricsWindows[0]);
+
+    LatencySummary summary;
+    rig->profiler.summarize(STATE_OPERATIONAL, summary);
+    TEST_ASSERT_EQUAL(0, summary.count);
+}
+
+void test_failed_loop_metrics_keep_accumulating() {
+    connect();
+    rig->profiler.record(STATE_OPERATIONAL, 20);
+    rig->mqtt.acceptPublish = false;
+    fake::setMillis(LOOP_METRICS_INTERVAL_MS);
+    for (int i = 0; i < 4; i++) {
+        step();
+    }
+
+    LatencySummary summary;
+    rig->profiler.summarize(STATE_OPERATIONAL, summary);
+    TEST_ASSERT_EQUAL(1, summary.count);
+
+    // The next report covers both windows
+    rig->mqtt.acceptPublish = true;
+    fake::setMillis(2 * LOOP_METRICS_INTERVAL_MS);
+    for (int i = 0; i < 4 && rig->mqtt.metricsWindows.empty(); i++) {
+        step();
+    }
+    TEST_ASSERT_EQUAL(1, rig->mqtt.metricsWindows.size());
+    TEST_ASSERT_EQUAL(2 * LOOP_METRICS_INTERVAL_MS, rig->mqtt.metricsWindows[0]);
+}
+
+void test_deep_sleep_once_published_and_lingered() {
+    startDutyCycled(BOOT_TIME_MS);
+    connect();
+    step(); // Publishes the sample taken while connecting from the backlog
+    TEST_ASSERT_EQUAL(1, rig->mqtt.batched.size());
+    TEST_ASSERT_EQUAL(0, rig->power.sleepCalls);
+
+    fake::advanceMillis(DEEP_SLEEP_CONFIG_LINGER_MS);
+    step();
+    TEST_ASSERT_EQUAL(1, rig->power.sleepCalls);
+    TEST_ASSERT_EQUAL(TEMP_SAMPLE_INTERVAL_DEFAULT_MS - DEEP_SLEEP_CONFIG_LINGER_MS, rig->power.lastSleepMs);
+    TEST_ASSERT_FALSE(rig->mqtt.isConnected());
+    TEST_ASSERT_EQUAL(FakeLedStatus::OFF, rig->led.last);
+
+    TEST_ASSERT_EQUAL(1, rig->power.saved.sleepCycles);
+    TEST_ASSERT_EQUAL(1, rig->power.saved.nextSequence);
+    TEST_ASSERT_EQUAL(BOOT_TIME_MS, rig->power.saved.wakeToPublishMs);
+    TEST_ASSERT_EQUAL(0, rig->power.saved.wakeBudgetOverruns);
+    TEST_ASSERT_EQUAL(1, rig->power.saved.statistics.count);
+}
+
+void test_summary_window_spans_wakes() {
+    startDutyCycled(BOOT_TIME_MS);
+    unsigned long wakePeriodMs = 0;
+    unsigned long wakes = 0;
+    while (rig->mqtt.summaries.empty() && wakes < 2 * STATS_WINDOW_MS / TEMP_SAMPLE_INTERVAL_DEFAULT_MS) {
+        if (wakes > 0) {
+            FakePowerManager slept = rig->power;
+            startDutyCycled(BOOT_TIME_MS, &slept);
+        }
+        wakes++;
+        connect();
+        step();
+        fake::advanceMillis(DEEP_SLEEP_CONFIG_LINGER_MS);
+        step();
+        if (wakes == 1) {
+            wakePeriodMs = rig->power.saved.clockOffsetMs;
+        }
+    }
+
+    // Closed by the first wake at which the window is over, timed across the sleeps
+    TEST_ASSERT_EQUAL(1, rig->mqtt.summaries.size());
+    const WindowStatistics& summary = rig->mqtt.summaries[0];
+    TEST_ASSERT_EQUAL(wakes, summary.count);
+    TEST_ASSERT_EQUAL(0, summary.firstSequence);
+    TEST_ASSERT_EQUAL(wakes - 1, summary.lastSequence);
+    TEST_ASSERT_EQUAL(BOOT_TIME_MS, summary.firstTimestampMs);
+    TEST_ASSERT_EQUAL(BOOT_TIME_MS + (wakes - 1) * wakePeriodMs, summary.lastTimestampMs);
+    TEST_ASSERT_TRUE(summary.lastTimestampMs - summary.firstTimestampMs >= STATS_WINDOW_MS);
+    TEST_ASSERT_TRUE(summary.lastTimestampMs - summary.firstTimestampMs < STATS_WINDOW_MS + wakePeriodMs);
+    TEST_ASSERT_EQUAL(0, rig->power.saved.statistics.count);
+}
+
+void test_wake_restores_duty_cycle_state() {
+    startDutyCycled(BOOT_TIME_MS);
+    connect();
+    rig->mqtt.intervalMs = 20000; // Delivered after subscribing
+    rig->mqtt.hasInterval = true;
+    step();
+    fake::advanceMillis(DEEP_SLEEP_CONFIG_LINGER_MS);
+    step();
+    TEST_ASSERT_EQUAL(1, rig->power.sleepCalls);
+
+    FakePowerManager slept = rig->power;
+    startDutyCycled(BOOT_TIME_MS, &slept);
+    TEST_ASSERT_EQUAL(20000, rig->fsm.getCurrentSamplingInterval());
+
+    connect();
+    step();
+    TEST_ASSERT_EQUAL(1, rig->mqtt.batched.size());
+    TEST_ASSERT_EQUAL(1, rig->mqtt.batched[0].sequence);
+
+    // The connect report carries the previous wake's measurement
+    TEST_ASSERT_EQUAL(1, rig->mqtt.reports[0].deepSleepCycles);
+    TEST_ASSERT_EQUAL(BOOT_TIME_MS, rig->mqtt.reports[0].wakeToPublishMs);
+}
+
+void test_slow_wake_counts_budget_overrun() {
+    startDutyCycled(DEEP_SLEEP_WAKE_BUDGET_MS + 1);
+    connect();
+    step();
+    fake::advanceMillis(DEEP_SLEEP_CONFIG_LINGER_MS);
+    step();
+    TEST_ASSERT_EQUAL(DEEP_SLEEP_WAKE_BUDGET_MS + 1, rig->power.saved.wakeToPublishMs);
+    TEST_ASSERT_EQUAL(1, rig->power.saved.wakeBudgetOverruns);
+}
+
+void test_deep_sleep_while_offline() {
+    startDutyCycled(BOOT_TIME_MS);
+    rig->wifi.acceptBegin = false;
+    step();
+    TEST_ASSERT_EQUAL(STATE_WAIT_RECONNECT, step());
+    TEST_ASSERT_EQUAL(0, rig->power.sleepCalls);
+
+    step(); // Retrying is left to the next wake-up
+    TEST_ASSERT_EQUAL(1, rig->power.sleepCalls);
+    TEST_ASSERT_EQUAL(TEMP_SAMPLE_INTERVAL_DEFAULT_MS, rig->power.lastSleepMs);
+    TEST_ASSERT_EQUAL(0, rig->power.saved.wakeToPublishMs);
+    TEST_ASSERT_EQUAL(1, rig->store.size());
+}
+
+void test_short_interval_stays_awake() {
+    startDutyCycled(BOOT_TIME_MS);
+    connect();
+    rig->mqtt.intervalMs = DEEP_SLEEP_MIN_DURATION_MS - 1000; // Delivered after subscribing
+    rig->mqtt.hasInterval = true;
+    for (int i = 0; i < 20; i++) {
+        fake::advanceMillis(DEEP_SLEEP_CONFIG_LINGER_MS);
+        step();
+    }
+    TEST_ASSERT_EQUAL(0, rig->power.sleepCalls);
+    TEST_ASSERT_TRUE(rig->mqtt.samples.size() > 0);
+}
+
+void test_unchanged_samples_suppressed_until_heartbeat() {
+    connect();
+    step(); // Publishes the sample taken while connecting from the backlog
+    sampleNext(21.0f);
+    TEST_ASSERT_EQUAL(1, rig->mqtt.samples.size());
+
+    unsigned long perHeartbeat = PUBLISH_HEARTBEAT_MS / TEMP_SAMPLE_INTERVAL_DEFAULT_MS;
+    for (unsigned long i = 1; i < perHeartbeat; i++) {
+        sampleNext(21.0f + PUBLISH_DEADBAND_C / 2);
+    }
+    TEST_ASSERT_EQUAL(1, rig->mqtt.samples.size());
+
+    sampleNext(21.0f);
+    TEST_ASSERT_EQUAL(2, rig->mqtt.samples.size());
+    TEST_ASSERT_EQUAL(perHeartbeat - 1, rig->mqtt.suppressed[1]);
+    TEST_ASSERT_EQUAL(rig->mqtt.samples[0].sequence + perHeartbeat, rig->mqtt.samples[1].sequence);
+}
+
+void test_change_beyond_deadband_published() {
+    connect();
+    step();
+    sampleNext(21.0f);
+    sampleNext(21.0f + PUBLISH_DEADBAND_C / 2);
+    sampleNext(21.0f + PUBLISH_DEADBAND_C);
+    TEST_ASSERT_EQUAL(2, rig->mqtt.samples.size());
+    TEST_ASSERT_EQUAL(1, rig->mqtt.suppressed[1]);
+
+    // The reference moves with every published sample, so slow drifts are still reported
+    sampleNext(21.0f + PUBLISH_DEADBAND_C * 1.5f);
+    TEST_ASSERT_EQUAL(2, rig->mqtt.samples.size());
+}
+
+void test_policy_band_crossing_published_within_deadband() {
+    rig->mqtt.policy = twoBandPolicy();
+    rig->mqtt.hasPolicy = true;
+    connect();
+    step();
+    sampleNext(24.95f);
+    sampleNext(25.0f);
+    TEST_ASSERT_EQUAL(2, rig->mqtt.samples.size());
+}
+
+void test_suppressed_samples_in_status_report() {
+    connect();
+    step();
+    sampleNext(21.0f);
+    sampleNext(21.0f);
+    sampleNext(21.0f);
+
+    // Reconnecting publishes a report and restarts the deadband
+    rig->mqtt.connected = false;
+    step();
+    TEST_ASSERT_EQUAL(STATE_WAIT_RECONNECT, step());
+    fake::advanceMillis(WIFI_RECONNECT_INTERVAL_MS);
+    connect();
+    TEST_ASSERT_EQUAL(2, rig->mqtt.reports.back().suppressedSamples);
+    step();
+    sampleNext(21.0f);
+    TEST_ASSERT_EQUAL(2, rig->mqtt.samples.size());
+}
+
+void test_summary_covers_every_sample_taken() {
+    // The first sample is taken offline while connecting, the rest falls within the deadband
+    rig->temperature.temperature = 20.0f;
+    connect();
+    step();
+    unsigned long perWindow = STATS_WINDOW_MS / TEMP_SAMPLE_INTERVAL_DEFAULT_MS;
+    for (unsigned long i = 1; i < perWindow; i++) {
+        sampleNext(i % 2 ? 20.1f : 20.0f);
+    }
+    TEST_ASSERT_EQUAL(0, rig->mqtt.summaries.size());
+
+    sampleNext(25.0f); // Due at the window end, falls into the next window
+    TEST_ASSERT_EQUAL(1, rig->mqtt.summaries.size());
+    const WindowStatistics& summary = rig->mqtt.summaries[0];
+    TEST_ASSERT_EQUAL(perWindow, summary.count);
+    TEST_ASSERT_EQUAL(BOOT_TIME_MS, summary.firstTimestampMs);
+    TEST_ASSERT_EQUAL(0, summary.firstSequence);
+    TEST_ASSERT_EQUAL(perWindow - 1, summary.lastSequence);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 20.0f, summary.min);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 20.1f, summary.max);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 20.05f, summary.mean);
+    TEST_ASSERT_TRUE(rig->mqtt.samples.size() < perWindow);
+}
+
+void test_failed_summary_keeps_window_open() {
+    connect();
+    step();
+    rig->mqtt.acceptPublish = false;
+    unsigned long perWindow = STATS_WINDOW_MS / TEMP_SAMPLE_INTERVAL_DEFAULT_MS;
+    for (unsigned long i = 0; i < perWindow; i++) {
+        sampleNext(21.0f);
+    }
+
+    rig->mqtt.acceptPublish = true;
+    sampleNext(21.0f);
+    TEST_ASSERT_EQUAL(1, rig->mqtt.summaries.size());
+    TEST_ASSERT_EQUAL(perWindow + 1, rig->mqtt.summaries[0].count);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_initializing_to_wifi_connecting);
+    RUN_TEST(test_initializing_to_network_error_when_begin_fails);
+    RUN_TEST(test_wifi_connecting_waits_while_pending);
+    RUN_TEST(test_wifi_connecting_to_wifi_connected);
+    RUN_TEST(test_wifi_connecting_to_network_error_on_failure);
+    RUN_TEST(test_wifi_connected_to_mqtt_connecting);
+    RUN_TEST(test_mqtt_connecting_to_operational);
+    RUN_TEST(test_mqtt_connecting_retries_after_interval);
+    RUN_TEST(test_mqtt_connecting_to_network_error_when_wifi_lost);
+    RUN_TEST(test_mqtt_connecting_waits_for_retained_config);
+    RUN_TEST(test_mqtt_connecting_gives_up_on_missing_config);
+    RUN_TEST(test_operational_to_sampling_to_sending);
+    RUN_TEST(test_operational_stays_until_sample_due);
+    RUN_TEST(test_sending_failure_queues_sample);
+    RUN_TEST(test_backlog_drained_when_operational);
+    RUN_TEST(test_operational_to_network_error_on_mqtt_loss);
+    RUN_TEST(test_operational_to_network_error_on_wifi_loss);
+    RUN_TEST(test_network_error_to_wait_reconnect);
+    RUN_TEST(test_wait_reconnect_to_initializing_after_interval);
+    RUN_TEST(test_samples_stored_while_offline);
+    RUN_TEST(test_run_never_blocks);
+    RUN_TEST(test_deadline_immediate_in_transient_states);
+    RUN_TEST(test_deadline_operational_polls_until_sample_due);
+    RUN_TEST(test_deadline_offline_sleeps_until_sample_or_retry);
+    RUN_TEST(test_backoff_grows_per_failure_and_resets_when_operational);
+    RUN_TEST(test_jitter_differs_between_devices);
+    RUN_TEST(test_policy_switches_interval_on_band_change);
+    RUN_TEST(test_override_takes_precedence_over_policy);
+    RUN_TEST(test_loop_metrics_published_periodically);
+    RUN_TEST(test_failed_loop_metrics_keep_accumulating);
+    RUN_TEST(test_deep_sleep_once_published_and_lingered);
+    RUN_TEST(test_summary_window_spans_wakes);
+    RUN_TEST(test_wake_restores_duty_cycle_state);
+    RUN_TEST(test_slow_wake_counts_budget_overrun);
+    RUN_TEST(test_deep_sleep_while_offline);
+    RUN_TEST(test_short_interval_stays_awake);
+    RUN_TEST(test_unchanged_samples_suppressed_until_heartbeat);
+    RUN_TEST(test_change_beyond_deadband_published);
+    RUN_TEST(test_policy_band_crossing_published_within_deadband);
+    RUN_TEST(test_suppressed_samples_in_status_report);
+    RUN_TEST(test_summary_covers_every_sample_taken);
+    RUN_TEST(test_failed_summary_keeps_window_open);
+    return UNITY_END();
+}
@@ -0,0 +1,112 @@
+#include <unity.h>
+#include "devices/api/LedPatternPlayer.h"
+
+namespace {
+
+const LedPattern STEADY_GREEN = {100, 1, 0x1, 0x0, true};
+const LedPattern STEADY_RED = {100, 1, 0x0, 0x1, true};
+const LedPattern SINGLE_BLINK = {100, 20, 0x0, 0x1, true};
+const LedPattern DOUBLE_BLINK = {100, 20, 0x0, 0x5, true};
+const LedPattern FLASH = {250, 1, 0x1, 0x1, false};
+
+LedPatternPlayer* player = nullptr;
+
+} // namespace
+
+void setUp() {
+    player = new LedPatternPlayer();
+}
+
+void tearDown() {
+    delete player;
+    player = nullptr;
+}
+
+void test_idle_player_is_off() {
+    TEST_ASSERT_EQUAL(0, player->levels());
+    TEST_ASSERT_EQUAL(0, player->holdMs());
+}
+
+void test_steady_pattern_needs_no_timer() {
+    TEST_ASSERT_TRUE(player->request(STEADY_GREEN));
+    TEST_ASSERT_EQUAL(LED_LEVEL_GREEN, player->levels());
+    TEST_ASSERT_EQUAL(0, player->holdMs());
+}
+
+void test_repeated_request_is_ignored() {
+    TEST_ASSERT_TRUE(player->request(STEADY_RED));
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_FALSE(player->request(STEADY_RED));
+    }
+}
+
+void test_single_blink_merges_off_steps() {
+    player->request(SINGLE_BLINK);
+    TEST_ASSERT_EQUAL(LED_LEVEL_RED, player->levels());
+    TEST_ASSERT_EQUAL(100, player->holdMs());
+
+    player->advance();
+    TEST_ASSERT_EQUAL(0, player->levels());
+    TEST_ASSERT_EQUAL(1900, player->holdMs());
+
+    player->advance(); // Wraps to the blink
+    TEST_ASSERT_EQUAL(LED_LEVEL_RED, player->levels());
+    TEST_ASSERT_EQUAL(100, player->holdMs());
+}
+
+void test_double_blink_sequence() {
+    player->request(DOUBLE_BLINK);
+    const uint8_t expectedLevels[] = {LED_LEVEL_RED, 0, LED_LEVEL_RED, 0, LED_LEVEL_RED};
+    const uint32_t expectedHold[] = {100, 100, 100, 1700, 100};
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL(expectedLevels[i], player->levels());
+        TEST_ASSERT_EQUAL(expectedHold[i], player->holdMs());
+        player->advance();
+    }
+}
+
+void test_one_shot_hands_over_to_latest_request() {
+    player->request(FLASH);
+    TEST_ASSERT_EQUAL(LED_LEVEL_GREEN | LED_LEVEL_RED, player->levels());
+    TEST_ASSERT_EQUAL(250, player->holdMs());
+
+    // Queued behind the flash, the latest request wins
+    TEST_ASSERT_FALSE(player->request(SINGLE_BLINK));
+    TEST_ASSERT_FALSE(player->request(DOUBLE_BLINK));
+    TEST_ASSERT_EQUAL(&FLASH, player->current());
+
+    player->advance();
+    TEST_ASSERT_EQUAL(&DOUBLE_BLINK, player->current());
+    TEST_ASSERT_EQUAL(LED_LEVEL_RED, player->levels());
+}
+
+void test_one_shot_without_request_ends_off() {
+    player->request(FLASH);
+    player->advance();
+    TEST_ASSERT_EQUAL(nullptr, player->current());
+    TEST_ASSERT_EQUAL(0, player->levels());
+    TEST_ASSERT_TRUE(player->request(STEADY_GREEN));
+}
+
+void test_preempt_interrupts_one_shot() {
+    player->request(FLASH);
+    player->request(SINGLE_BLINK);
+    TEST_ASSERT_TRUE(player->request(STEADY_RED, true));
+    TEST_ASSERT_EQUAL(LED_LEVEL_RED, player->levels());
+
+    player->advance(); // The queued request was dropped
+    TEST_ASSERT_EQUAL(&STEADY_RED, player->current());
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_player_is_off);
+    RUN_TEST(test_steady_pattern_needs_no_timer);
+    RUN_TEST(test_repeated_request_is_ignored);
+    RUN_TEST(test_single_blink_merges_off_steps);
+    RUN_TEST(test_double_blink_sequence);
+    RUN_TEST(test_one_shot_hands_over_to_latest_request);
+    RUN_TEST(test_one_shot_without_request_ends_off);
+    RUN_TEST(test_preempt_interrupts_one_shot);
+    return UNITY_END();
+}
@@ -0,0 +1,142 @@
+#include <unity.h>
+#include <string>
+#include <Arduino.h>
+#include "kernel/api/Log.h"
+
+namespace {
+
+/** @brief Formats the oldest queued message, without the timestamp prefix and line terminator. */
+std::string popMessage() {
+    LogRecord record;
+    if (!Log::pop(record)) {
+        return "<empty>";
+    }
+    char line[LOG_LINE_MAX_LEN];
+    size_t length = Log::format(record, line, sizeof(line));
+    std::string text(line, length);
+    return text.substr(text.find(']') + 2, text.size() - text.find(']') - 4);
+}
+
+int evaluations = 0;
+
+int countEvaluation() {
+    return ++evaluations;
+}
+
+} // namespace
+
+void setUp() {
+    fake::reset();
+    Log::clear();
+    evaluations = 0;
+}
+
+void tearDown() {}
+
+void test_formats_typed_arguments() {
+    LOG_INFO("int %d uint %lu float %.2f str %s", -42, 4000000000UL, 21.456f, "ok");
+    TEST_ASSERT_EQUAL_STRING("I int -42 uint 4000000000 float 21.46 str ok", popMessage().c_str());
+}
+
+void test_line_has_timestamp_level_and_terminator() {
+    fake::setMillis(1234);
+    LOG_WARN("WiFi: Connection attempt timed out");
+
+    LogRecord record;
+    TEST_ASSERT_TRUE(Log::pop(record));
+    char line[LOG_LINE_MAX_LEN];
+    Log::format(record, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("[1234] W WiFi: Connection attempt timed out\r\n", line);
+}
+
+void test_argument_type_wins_over_conversion() {
+    // Mismatched conversions must not read the argument as the wrong C type
+    LOG_INFO("%s|%d|%u|%5.1f%%", 7, 3.5f, -1, 2.25);
+    TEST_ASSERT_EQUAL_STRING("I 7|3.500000|4294967295|  2.2%", popMessage().c_str());
+}
+
+void test_missing_arguments_are_marked() {
+    LOG_ERROR("a=%d b=%d", 1);
+    TEST_ASSERT_EQUAL_STRING("E a=1 b=?", popMessage().c_str());
+}
+
+void test_long_lines_are_truncated() {
+    std::string longText(LOG_LINE_MAX_LEN * 2, 'x');
+    LOG_INFO("%s", longText.c_str());
+
+    LogRecord record;
+    TEST_ASSERT_TRUE(Log::pop(record));
+    char line[LOG_LINE_MAX_LEN];
+    size_t length = Log::format(record, line, sizeof(line));
+    TEST_ASSERT_EQUAL(LOG_LINE_MAX_LEN - 1, length);
+    TEST_ASSERT_EQUAL_STRING("\r\n", line + length - 2);
+}
+
+void test_disabled_level_does_not_evaluate_arguments() {
+    TEST_ASSERT_TRUE(LOG_LEVEL < LOG_LEVEL_DEBUG);
+    LOG_DEBUG("never %d", countEvaluation());
+    LOG_INFO("once %d", countEvaluation());
+
+    TEST_ASSERT_EQUAL(1, evaluations);
+    TEST_ASSERT_EQUAL_STRING("I once 1", popMessage().c_str());
+    TEST_ASSERT_EQUAL_STRING("<empty>", popMessage().c_str());
+}
+
+void test_overflow_drops_oldest_and_reports() {
+    for (int i = 0; i < LOG_BUFFER_RECORDS + 3; i++) {
+        LOG_INFO("message %d", i);
+    }
+    TEST_ASSERT_EQUAL(3, Log::getDroppedCount());
+
+    fake::serialOutput.clear();
+    Log::flush();
+    TEST_ASSERT_EQUAL(0, fake::serialOutput.find("[0] W Log: 3 records dropped\r\n"));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, fake::serialOutput.find("I message 3\r\n"));
+    TEST_ASSERT_EQUAL(std::string::npos, fake::serialOutput.find("I message 2\r\n"));
+}
+
+void test_drain_never_writes_more_than_the_uart_accepts() {
+    LOG_INFO("first");
+    LOG_INFO("second");
+
+    fake::serialTxRoom = 0;
+    Log::drain();
+    TEST_ASSERT_EQUAL_STRING("", fake::serialOutput.c_str());
+
+    // A partial line is resumed where it stopped on the next drain
+    fake::serialTxRoom = 6;
+    Log::drain();
+    TEST_ASSERT_EQUAL_STRING("[0] I ", fake::serialOutput.c_str());
+
+    fake::serialTxRoom = SIZE_MAX;
+    Log::drain();
+    TEST_ASSERT_EQUAL_STRING("[0] I first\r\n[0] I second\r\n", fake::serialOutput.c_str());
+}
+
+void test_drain_is_bounded_per_call() {
+    for (int i = 0; i < LOG_DRAIN_MAX_RECORDS + 2; i++) {
+        LOG_INFO("line");
+    }
+    Log::drain();
+
+    LogRecord record;
+    size_t left = 0;
+    while (Log::pop(record)) {
+        left++;
+    }
+    TEST_ASSERT_EQUAL(2, left);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_formats_typed_arguments);
+    RUN_TEST(test_line_has_timestamp_level_and_terminator);
+    RUN_TEST(test_argument_type_wins_over_conversion);
+    RUN_TEST(test_missing_arguments_are_marked);
+    RUN_TEST(test_long_lines_are_truncated);
+    RUN_TEST(test_disabled_level_does_not_evaluate_arguments);
+    RUN_TEST(test_overflow_drops_oldest_and_reports);
+    RUN_TEST(test_drain_never_writes_more_than_the_uart_accepts);
+    RUN_TEST(test_drain_is_bounded_per_call);
+    return UNITY_END();
+}
@@ -0,0 +1,90 @@
+#include <unity.h>
+#include "kernel/api/LoopProfiler.h"
+
+namespace {
+
+LoopProfiler profiler;
+
+} // namespace
+
+void setUp() {
+    profiler.reset();
+}
+
+void tearDown() {}
+
+void test_bucket_boundaries() {
+    TEST_ASSERT_EQUAL(0, LoopProfiler::bucketFor(0));
+    TEST_ASSERT_EQUAL(1, LoopProfiler::bucketFor(1));
+    TEST_ASSERT_EQUAL(2, LoopProfiler::bucketFor(2));
+    TEST_ASSERT_EQUAL(2, LoopProfiler::bucketFor(3));
+    TEST_ASSERT_EQUAL(11, LoopProfiler::bucketFor(1024));
+    TEST_ASSERT_EQUAL(32, LoopProfiler::bucketFor(UINT32_MAX));
+}
+
+void test_empty_slot_summary_is_zero() {
+    LatencySummary summary;
+    profiler.summarize(STATE_OPERATIONAL, summary);
+    TEST_ASSERT_EQUAL(0, summary.count);
+    TEST_ASSERT_EQUAL(0, summary.minUs);
+    TEST_ASSERT_EQUAL(0, summary.maxUs);
+}
+
+void test_percentiles_from_buckets() {
+    // 98 fast cycles, one slow and one stalled: the stall shows in max but not in p99
+    for (int i = 0; i < 98; i++) {
+        profiler.record(STATE_OPERATIONAL, 12);
+    }
+    profiler.record(STATE_OPERATIONAL, 700);
+    profiler.record(STATE_OPERATIONAL, 250000);
+
+    LatencySummary summary;
+    profiler.summarize(STATE_OPERATIONAL, summary);
+    TEST_ASSERT_EQUAL(100, summary.count);
+    TEST_ASSERT_EQUAL(12, summary.minUs);
+    TEST_ASSERT_EQUAL(15, summary.p50Us);     // Upper bound of [8, 16)
+    TEST_ASSERT_EQUAL(1023, summary.p99Us);   // Upper bound of [512, 1024)
+    TEST_ASSERT_EQUAL(250000, summary.maxUs);
+}
+
+void test_percentiles_capped_at_max() {
+    profiler.record(STATE_MQTT_CONNECTING, 600);
+    LatencySummary summary;
+    profiler.summarize(STATE_MQTT_CONNECTING, summary);
+    TEST_ASSERT_EQUAL(600, summary.p50Us);
+    TEST_ASSERT_EQUAL(600, summary.p99Us);
+}
+
+void test_slots_are_independent() {
+    profiler.record(LOOP_PROFILE_SLOT_MQTT_LOOP, 40);
+    profiler.record(LOOP_PROFILE_SLOT_COUNT, 40); // Out of range, ignored
+    LatencySummary summary;
+    profiler.summarize(STATE_OPERATIONAL, summary);
+    TEST_ASSERT_EQUAL(0, summary.count);
+    profiler.summarize(LOOP_PROFILE_SLOT_MQTT_LOOP, summary);
+    TEST_ASSERT_EQUAL(1, summary.count);
+    TEST_ASSERT_EQUAL_STRING("mqtt_loop", LoopProfiler::slotName(LOOP_PROFILE_SLOT_MQTT_LOOP));
+    TEST_ASSERT_EQUAL_STRING("config_wake", LoopProfiler::slotName(LOOP_PROFILE_SLOT_CONFIG_WAKE));
+    TEST_ASSERT_EQUAL_STRING("sampling", LoopProfiler::slotName(STATE_SAMPLING_TEMPERATURE));
+}
+
+void test_reset_clears_histograms() {
+    profiler.record(STATE_OPERATIONAL, 5);
+    profiler.reset();
+    profiler.record(STATE_OPERATIONAL, 9);
+    LatencySummary summary;
+    profiler.summarize(STATE_OPERATIONAL, summary);
+    TEST_ASSERT_EQUAL(1, summary.count);
+    TEST_ASSERT_EQUAL(9, summary.minUs);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_bucket_boundaries);
+    RUN_TEST(test_empty_slot_summary_is_zero);
+    RUN_TEST(test_percentiles_from_buckets);
+    RUN_TEST(test_percentiles_capped_at_max);
+    RUN_TEST(test_slots_are_independent);
+    RUN_TEST(test_reset_clears_histograms);
+    return UNITY_END();
+}
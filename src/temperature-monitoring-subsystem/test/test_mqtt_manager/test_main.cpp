@@ -0,0 +1,253 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <PubSubClient.h>
+#include <stdint.h>
+#include <string>
+#include "FakeWifiManager.h"
+#include "kernel/connection/api/MqttManagerImpl.h"
+
+namespace {
+
+FakeWifiManager* wifi = nullptr;
+MqttManagerImpl* mqtt = nullptr;
+
+/** @brief Largest value of a 32-bit unsigned long, the widest field the ESP32 prints. */
+const unsigned long MAX_ULONG32 = 4294967295UL;
+
+} // namespace
+
+void setUp() {
+    fake::reset();
+    fake::resetMqtt();
+    wifi = new FakeWifiManager();
+    wifi->connected = true;
+    mqtt = new MqttManagerImpl("broker.local", 1883, "esp32-", wifi);
+    mqtt->setup();
+    mqtt->connect();
+    fake::mqttPublished.clear();
+}
+
+void tearDown() {
+    delete mqtt;
+    delete wifi;
+}
+
+void test_connect_subscribes_to_config_topics() {
+    TEST_ASSERT_TRUE(mqtt->isConnected());
+    TEST_ASSERT_EQUAL(2, fake::mqttSubscriptions.size());
+    TEST_ASSERT_EQUAL_STRING(MQTT_TOPIC_CONFIG_F, fake::mqttSubscriptions[0].c_str());
+    TEST_ASSERT_EQUAL_STRING(MQTT_TOPIC_CONFIG_POLICY, fake::mqttSubscriptions[1].c_str());
+}
+
+void test_connect_keeps_session_for_queued_config() {
+    TEST_ASSERT_EQUAL(!MQTT_PERSISTENT_SESSION, fake::mqttCleanSession);
+    TEST_ASSERT_EQUAL(1, fake::mqttSubscriptionQos[0]);
+    TEST_ASSERT_EQUAL(1, fake::mqttSubscriptionQos[1]);
+}
+
+void test_config_synced_once_both_topics_received() {
+    TEST_ASSERT_FALSE(mqtt->isConfigSynced());
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_F, "{\"frequency\":0}");
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_F, "{\"frequency\":30}");
+    TEST_ASSERT_FALSE(mqtt->isConfigSynced());
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_POLICY, "{\"thresholds\":[],\"intervals\":[10]}");
+    TEST_ASSERT_TRUE(mqtt->isConfigSynced());
+
+    // A new connection waits for the retained config again
+    mqtt->disconnect();
+    mqtt->connect();
+    TEST_ASSERT_FALSE(mqtt->isConfigSynced());
+}
+
+void test_connect_requires_wifi() {
+    mqtt->disconnect();
+    wifi->connected = false;
+    TEST_ASSERT_FALSE(mqtt->connect());
+}
+
+void test_frequency_sets_override() {
+    unsigned long intervalMs = 0;
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_F, "{\"frequency\":30}");
+    TEST_ASSERT_TRUE(mqtt->getNewSamplingIntervalMs(intervalMs));
+    TEST_ASSERT_EQUAL(30000, intervalMs);
+    TEST_ASSERT_FALSE(mqtt->getNewSamplingIntervalMs(intervalMs));
+}
+
+void test_frequency_zero_clears_override() {
+    unsigned long intervalMs = 1;
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_F, "{\"frequency\":0}");
+    TEST_ASSERT_TRUE(mqtt->getNewSamplingIntervalMs(intervalMs));
+    TEST_ASSERT_EQUAL(0, intervalMs);
+}
+
+void test_invalid_frequency_ignored() {
+    unsigned long intervalMs;
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_F, "{\"frequency\":100000}");
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_F, "{\"frequency\":-5}");
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_F, "{\"frequency\":\"fast\"}");
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_F, "{\"frequency\":");
+    fake::deliverMqtt("assignment3/other", "{\"frequency\":30}");
+    TEST_ASSERT_FALSE(mqtt->getNewSamplingIntervalMs(intervalMs));
+}
+
+void test_config_messages_counted() {
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_F, "{\"frequency\":30}");
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_POLICY, "{\"thresholds\":[],\"intervals\":[10]}");
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_F, "{\"frequency\":");  // Invalid, still received
+    fake::deliverMqtt("assignment3/other", "{\"frequency\":30}");
+    TEST_ASSERT_EQUAL(3, mqtt->getConfigMessageCount());
+}
+
+void test_policy_parsed() {
+    SamplingPolicy policy;
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_POLICY, "{\"thresholds\":[20,25.5],\"intervals\":[10,5,2]}");
+    TEST_ASSERT_TRUE(mqtt->getNewSamplingPolicy(policy));
+    TEST_ASSERT_EQUAL(3, policy.bandCount);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, policy.thresholds[0]);
+    TEST_ASSERT_EQUAL_FLOAT(25.5f, policy.thresholds[1]);
+    TEST_ASSERT_EQUAL(10000, policy.intervalsMs[0]);
+    TEST_ASSERT_EQUAL(2000, policy.intervalsMs[2]);
+    TEST_ASSERT_EQUAL(1, policy.bandFor(20.0f));
+}
+
+void test_invalid_policy_ignored() {
+    SamplingPolicy policy;
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_POLICY, "{\"thresholds\":[20],\"intervals\":[10,5,2]}");
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_POLICY, "{\"thresholds\":[25,20],\"intervals\":[10,5,2]}");
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_POLICY, "{\"thresholds\":[20],\"intervals\":[10,0]}");
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_POLICY, "{\"thresholds\":[1,2,3,4],\"intervals\":[5,5,5,5,5]}");
+    fake::deliverMqtt(MQTT_TOPIC_CONFIG_POLICY, "{\"intervals\":[]}");
+    TEST_ASSERT_FALSE(mqtt->getNewSamplingPolicy(policy));
+}
+
+void test_temperature_payload() {
+    TemperatureSample sample = {123456, 21.5f, 42};
+    TEST_ASSERT_TRUE(mqtt->publishTemperature(sample, 3));
+    TEST_ASSERT_EQUAL(1, fake::mqttPublished.size());
+    TEST_ASSERT_EQUAL_STRING(MQTT_TOPIC_TEMPERATURE, fake::mqttPublished[0].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("{\"temperature\":21.50,\"ts\":123456,\"seq\":42,\"sup\":3}",
+                             fake::mqttPublished[0].payload.c_str());
+    TEST_ASSERT_TRUE(fake::mqttPublished[0].retained);
+}
+
+void test_channel_readings_in_temperature_payload() {
+    TemperatureSample sample = {1000, 23.0f, 7};
+    for (int channel = 0; channel < TEMP_CHANNEL_COUNT; channel++) {
+        sample.frame.centiDegrees[channel] = (int16_t)(2100 + 100 * channel);
+    }
+    TEST_ASSERT_TRUE(mqtt->publishTemperature(sample, 0));
+    const std::string& payload = fake::mqttPublished[0].payload;
+    // A single channel is the control temperature itself and is not repeated
+    bool hasChannels = payload.find(",\"ch\":[21.00,22.00") != std::string::npos;
+    TEST_ASSERT_EQUAL(TEMP_CHANNEL_COUNT > 1, hasChannels);
+    TEST_ASSERT_EQUAL('}', payload.back());
+}
+
+void test_full_batch_fits_packet_buffer() {
+    TemperatureSample samples[TELEMETRY_BATCH_MAX_SAMPLES];
+    for (size_t i = 0; i < TELEMETRY_BATCH_MAX_SAMPLES; i++) {
+        samples[i] = {MAX_ULONG32, -327.68f, (uint32_t)MAX_ULONG32};
+        for (int channel = 0; channel < TEMP_CHANNEL_COUNT; channel++) {
+            samples[i].frame.centiDegrees[channel] = INT16_MIN;
+        }
+    }
+    TEST_ASSERT_TRUE(mqtt->publishTemperatureBatch(samples, TELEMETRY_BATCH_MAX_SAMPLES, true));
+    TEST_ASSERT_FALSE(fake::mqttPublished[0].retained);
+    const std::string first = "{\"backlog\":true,\"samples\":[{\"ts\":4294967295,\"seq\":4294967295,\"t\":-327.68},";
+    TEST_ASSERT_EQUAL_STRING(first.c_str(), fake::mqttPublished[0].payload.substr(0, first.size()).c_str());
+}
+
+void test_largest_status_report_fits() {
+    StatusReport report = {};
+    report.status = "online";
+    report.uptimeMs = MAX_ULONG32;
+    report.bootToOperationalMs = MAX_ULONG32;
+    report.connectToOperationalMs = MAX_ULONG32;
+    report.reconnectFailures = MAX_ULONG32;
+    report.reconnectBackoffMs = MAX_ULONG32;
+    report.backlogSamples = MAX_ULONG32;
+    report.lostSamples = MAX_ULONG32;
+    report.samplingOverruns = MAX_ULONG32;
+    report.wifi = {MAX_ULONG32, MAX_ULONG32, MAX_ULONG32, false, false};
+    report.deepSleepCycles = MAX_ULONG32;
+    report.wakeToPublishMs = MAX_ULONG32;
+    report.wakeBudgetOverruns = MAX_ULONG32;
+    report.suppressedSamples = MAX_ULONG32;
+    TEST_ASSERT_TRUE(mqtt->publishStatusReport(report));
+}
+
+void test_loop_metrics_payload() {
+    LoopProfiler profiler;
+    profiler.record(STATE_OPERATIONAL, 12);
+    profiler.record(LOOP_PROFILE_SLOT_MQTT_LOOP, 300);
+    TEST_ASSERT_TRUE(mqtt->publishLoopMetrics(profiler, 300000));
+    TEST_ASSERT_EQUAL_STRING(MQTT_TOPIC_METRICS, fake::mqttPublished[0].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("{\"window_ms\":300000,\"slots\":{\"operational\":[1,12,12,12,12],"
+                             "\"mqtt_loop\":[1,300,300,300,300]}}",
+                             fake::mqttPublished[0].payload.c_str());
+}
+
+void test_largest_loop_metrics_fit() {
+    LoopProfiler profiler;
+    for (uint8_t slot = 0; slot < LOOP_PROFILE_SLOT_COUNT; slot++) {
+        profiler.record(slot, 1000000000UL);
+        profiler.record(slot, 4000000000UL);
+    }
+    TEST_ASSERT_TRUE(mqtt->publishLoopMetrics(profiler, MAX_ULONG32));
+}
+
+void test_summary_payload() {
+    WindowStatistics statistics = {};
+    statistics.add({1000, 20.0f, 5});
+    statistics.add({2000, 21.0f, 6});
+    TEST_ASSERT_TRUE(mqtt->publishTemperatureSummary(statistics));
+    TEST_ASSERT_EQUAL_STRING(MQTT_TOPIC_STATS, fake::mqttPublished[0].topic.c_str());
+    TEST_ASSERT_EQUAL_STRING("{\"ts\":[1000,2000],\"seq\":[5,6],\"n\":2,\"mean\":20.500,\"var\":0.5000,"
+                             "\"min\":20.00,\"max\":21.00,\"last\":21.00,\"raw\":true}",
+                             fake::mqttPublished[0].payload.c_str());
+    TEST_ASSERT_FALSE(fake::mqttPublished[0].retained);
+}
+
+void test_largest_summary_fits() {
+    WindowStatistics statistics = {};
+    statistics.add({0, -327.68f, 0});
+    statistics.add({MAX_ULONG32, 327.67f, (uint32_t)MAX_ULONG32});
+    statistics.count = (uint32_t)MAX_ULONG32;
+    statistics.firstSequence = (uint32_t)MAX_ULONG32;
+    statistics.firstTimestampMs = MAX_ULONG32;
+    TEST_ASSERT_TRUE(mqtt->publishTemperatureSummary(statistics));
+}
+
+void test_publish_fails_when_disconnected() {
+    TemperatureSample sample = {1, 20.0f, 1};
+    mqtt->disconnect();
+    TEST_ASSERT_FALSE(mqtt->publishTemperature(sample, 0));
+    TEST_ASSERT_FALSE(mqtt->publishStatus("online"));
+    TEST_ASSERT_EQUAL(0, fake::mqttPublished.size());
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_connect_subscribes_to_config_topics);
+    RUN_TEST(test_connect_keeps_session_for_queued_config);
+    RUN_TEST(test_config_synced_once_both_topics_received);
+    RUN_TEST(test_connect_requires_wifi);
+    RUN_TEST(test_frequency_sets_override);
+    RUN_TEST(test_frequency_zero_clears_override);
+    RUN_TEST(test_invalid_frequency_ignored);
+    RUN_TEST(test_config_messages_counted);
+    RUN_TEST(test_policy_parsed);
+    RUN_TEST(test_invalid_policy_ignored);
+    if (TEMP_CHANNEL_COUNT == 1) {
+        RUN_TEST(test_temperature_payload);
+    }
+    RUN_TEST(test_channel_readings_in_temperature_payload);
+    RUN_TEST(test_full_batch_fits_packet_buffer);
+    RUN_TEST(test_largest_status_report_fits);
+    RUN_TEST(test_loop_metrics_payload);
+    RUN_TEST(test_largest_loop_metrics_fit);
+    RUN_TEST(test_summary_payload);
+    RUN_TEST(test_largest_summary_fits);
+    RUN_TEST(test_publish_fails_when_disconnected);
+    return UNITY_END();
+}
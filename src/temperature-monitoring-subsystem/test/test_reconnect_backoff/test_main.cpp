@@ -0,0 +1,120 @@
+#include <unity.h>
+#include "kernel/api/ReconnectBackoff.h"
+
+namespace {
+
+const unsigned long BASE_MS = 1000;
+const unsigned long MAX_MS = 30000;
+
+} // namespace
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_no_wait_before_first_failure() {
+    ReconnectBackoff backoff(BASE_MS, MAX_MS);
+    TEST_ASSERT_EQUAL(0, backoff.getDelayMs());
+    TEST_ASSERT_EQUAL(0, backoff.getFailures());
+}
+
+void test_wait_within_upper_half_of_doubling_ceiling() {
+    ReconnectBackoff backoff(BASE_MS, MAX_MS);
+    backoff.seed(0x12345678);
+
+    unsigned long ceiling = BASE_MS;
+    for (int i = 0; i < 12; i++) {
+        unsigned long wait = backoff.fail();
+        TEST_ASSERT_TRUE(wait >= ceiling / 2 && wait <= ceiling);
+        TEST_ASSERT_EQUAL(wait, backoff.getDelayMs());
+        ceiling = ceiling * 2 > MAX_MS ? MAX_MS : ceiling * 2;
+    }
+    TEST_ASSERT_EQUAL(12, backoff.getFailures());
+}
+
+void test_reset_starts_over_from_base() {
+    ReconnectBackoff backoff(BASE_MS, MAX_MS);
+    for (int i = 0; i < 8; i++) {
+        backoff.fail();
+    }
+    backoff.reset();
+    TEST_ASSERT_EQUAL(0, backoff.getDelayMs());
+    TEST_ASSERT_EQUAL(0, backoff.getFailures());
+    TEST_ASSERT_TRUE(backoff.fail() <= BASE_MS);
+}
+
+void test_longest_wait_kept_until_reset() {
+    ReconnectBackoff backoff(BASE_MS, MAX_MS);
+    backoff.seed(0x12345678);
+    TEST_ASSERT_EQUAL(0, backoff.getLongestDelayMs());
+
+    unsigned long longest = 0;
+    for (int i = 0; i < 12; i++) {
+        unsigned long wait = backoff.fail();
+        longest = wait > longest ? wait : longest;
+        TEST_ASSERT_EQUAL(longest, backoff.getLongestDelayMs());
+    }
+
+    backoff.reset();
+    TEST_ASSERT_EQUAL(0, backoff.getLongestDelayMs());
+}
+
+void test_same_seed_same_waits() {
+    ReconnectBackoff first(BASE_MS, MAX_MS);
+    ReconnectBackoff second(BASE_MS, MAX_MS);
+    first.seed(42);
+    second.seed(42);
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL(first.fail(), second.fail());
+    }
+}
+
+void test_different_seeds_spread_waits() {
+    // Devices seeded with consecutive chip IDs must not retry in lockstep
+    unsigned long waits[16];
+    for (uint32_t device = 0; device < 16; device++) {
+        ReconnectBackoff backoff(BASE_MS, MAX_MS);
+        backoff.seed(0xC3D4E5F6 + device);
+        for (int i = 0; i < 5; i++) {
+            waits[device] = backoff.fail();
+        }
+    }
+
+    int distinct = 0;
+    for (int i = 0; i < 16; i++) {
+        bool seen = false;
+        for (int j = 0; j < i; j++) {
+            seen = seen || waits[j] == waits[i];
+        }
+        if (!seen) distinct++;
+    }
+    TEST_ASSERT_TRUE(distinct >= 14);
+}
+
+void test_zero_seed_still_jitters() {
+    ReconnectBackoff zero(BASE_MS, MAX_MS);
+    zero.seed(0);
+    for (int i = 0; i < 6; i++) {
+        zero.fail(); // Up to the cap, so only the jitter changes the wait
+    }
+    unsigned long previous = zero.fail();
+    bool changed = false;
+    for (int i = 0; i < 8; i++) {
+        unsigned long wait = zero.fail();
+        changed = changed || wait != previous;
+        previous = wait;
+    }
+    TEST_ASSERT_TRUE(changed);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_no_wait_before_first_failure);
+    RUN_TEST(test_wait_within_upper_half_of_doubling_ceiling);
+    RUN_TEST(test_reset_starts_over_from_base);
+    RUN_TEST(test_longest_wait_kept_until_reset);
+    RUN_TEST(test_same_seed_same_waits);
+    RUN_TEST(test_different_seeds_spread_waits);
+    RUN_TEST(test_zero_seed_still_jitters);
+    return UNITY_END();
+}
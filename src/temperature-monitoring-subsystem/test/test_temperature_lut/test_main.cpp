@@ -0,0 +1,64 @@
+#include <unity.h>
+#include "devices/api/TemperatureLut.h"
+
+namespace {
+
+TemperatureLut lut;
+
+/** @brief Ideal converter: one millivolt per ADC code. */
+uint32_t identityMillivolts(uint32_t raw, const void*) {
+    return raw;
+}
+
+/** @brief Converter scaled by a context factor, like a per-chip gain. */
+uint32_t scaledMillivolts(uint32_t raw, const void* context) {
+    return raw * *static_cast<const uint32_t*>(context) / 1000;
+}
+
+} // namespace
+
+void setUp() {
+    lut.build(identityMillivolts, nullptr, 500.0f, 10.0f);
+}
+
+void tearDown() {}
+
+void test_tmp36_reference_points() {
+    TEST_ASSERT_EQUAL_INT16(0, lut.toCentiDegrees(500));      // 500 mV = 0 °C
+    TEST_ASSERT_EQUAL_INT16(2500, lut.toCentiDegrees(750));   // 750 mV = 25 °C
+    TEST_ASSERT_EQUAL_INT16(-5000, lut.toCentiDegrees(0));    // 0 mV = -50 °C
+    TEST_ASSERT_EQUAL_INT16(10, lut.toCentiDegrees(501));     // 10 mV/°C = 0.1 °C per mV
+}
+
+void test_saturates_instead_of_wrapping() {
+    // 4095 mV would be 359.5 °C = 35950 centi-degrees, beyond int16
+    TEST_ASSERT_EQUAL_INT16(32767, lut.toCentiDegrees(4095));
+}
+
+void test_clamps_codes_above_table() {
+    TEST_ASSERT_EQUAL_INT16(lut.toCentiDegrees(4095), lut.toCentiDegrees(70000));
+}
+
+void test_uses_calibration_context() {
+    const uint32_t gainPermille = 800; // 0.8 mV per code
+    lut.build(scaledMillivolts, &gainPermille, 500.0f, 10.0f);
+
+    TEST_ASSERT_EQUAL_INT16(0, lut.toCentiDegrees(625));      // 625 * 0.8 = 500 mV
+    TEST_ASSERT_EQUAL_INT16(3000, lut.toCentiDegrees(1000));  // 1000 * 0.8 = 800 mV = 30 °C
+}
+
+void test_monotonic_check_rejects_corruption() {
+    TEST_ASSERT_TRUE(lut.isMonotonic());
+    lut.data()[1000] = lut.data()[999] - 1;
+    TEST_ASSERT_FALSE(lut.isMonotonic());
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_tmp36_reference_points);
+    RUN_TEST(test_saturates_instead_of_wrapping);
+    RUN_TEST(test_clamps_codes_above_table);
+    RUN_TEST(test_uses_calibration_context);
+    RUN_TEST(test_monotonic_check_rejects_corruption);
+    return UNITY_END();
+}
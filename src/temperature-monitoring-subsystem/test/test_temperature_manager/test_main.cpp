@@ -0,0 +1,130 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <Preferences.h>
+#include <esp_adc_cal.h>
+#include "devices/api/TemperatureManagerImpl.h"
+
+namespace {
+
+/** @brief Raw code giving 750 mV (25 °C) with the default fake calibration of 0.75 mV per code. */
+const int CODE_25C = 1000;
+
+/** @brief Queues one oversampling burst of steady readings with a few spikes mixed in. */
+void scriptBurst(int steady, int spike, size_t spikes) {
+    for (size_t i = 0; i < TEMP_FILTER_OVERSAMPLES; i++) {
+        fake::analogScripts[TEMP_SENSOR_PIN].push_back(i < spikes ? spike : steady);
+    }
+}
+
+/** @brief Reads a frame and returns the temperature of channel 0 in Celsius. */
+float read(TemperatureManager& sensor) {
+    TemperatureFrame frame;
+    sensor.readFrame(frame);
+    return frame.centiDegrees[0] / 100.0f;
+}
+
+} // namespace
+
+void setUp() {
+    fake::reset();
+    fake::nvs.clear();
+    fake::nvsWrites = 0;
+    fake::adcCoeffA = 49152;
+    fake::adcCoeffB = 0;
+    fake::adcCalConversions = 0;
+    fake::analogValues[TEMP_SENSOR_PIN] = CODE_25C;
+}
+
+void tearDown() {}
+
+void test_converts_steady_reading() {
+    TemperatureManagerImpl sensor;
+    sensor.setup();
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 25.0f, read(sensor));
+}
+
+void test_rejects_spikes_in_burst() {
+    TemperatureManagerImpl sensor;
+    sensor.setup();
+    scriptBurst(CODE_25C, 4095, 3);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 25.0f, read(sensor));
+    scriptBurst(CODE_25C, 0, 3);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 25.0f, read(sensor));
+}
+
+void test_out_of_range_kept_out_of_average() {
+    TemperatureManagerImpl sensor;
+    sensor.setup();
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 25.0f, read(sensor));
+
+    scriptBurst(2000, 2000, 0); // 1500 mV = 100 °C
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 100.0f, read(sensor));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 25.0f, read(sensor));
+}
+
+void test_reads_every_channel_in_one_frame() {
+    // 25 °C on channel 0, about one degree more on each further channel (13.3 codes per degree)
+    const int pins[] = TEMP_CHANNEL_PINS;
+    for (int channel = 0; channel < TEMP_CHANNEL_COUNT; channel++) {
+        fake::analogValues[pins[channel]] = CODE_25C + 40 * channel / 3;
+    }
+    TemperatureManagerImpl sensor;
+    sensor.setup();
+
+    TemperatureFrame frame;
+    sensor.readFrame(frame);
+    for (int channel = 0; channel < TEMP_CHANNEL_COUNT; channel++) {
+        TEST_ASSERT_INT_WITHIN(5, 2500 + 100 * channel, frame.centiDegrees[channel]);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, TEMP_CHANNEL_AGGREGATE_MAX ? 24.0f + TEMP_CHANNEL_COUNT
+                                                               : 25.0f + (TEMP_CHANNEL_COUNT - 1) / 2.0f,
+                             frame.aggregate());
+}
+
+void test_table_cached_in_nvs() {
+    TemperatureManagerImpl first;
+    first.setup();
+    TEST_ASSERT_EQUAL(4096, fake::adcCalConversions);
+    unsigned long writes = fake::nvsWrites;
+
+    TemperatureManagerImpl second;
+    second.setup();
+    TEST_ASSERT_EQUAL(4096, fake::adcCalConversions);
+    TEST_ASSERT_EQUAL(writes, fake::nvsWrites);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 25.0f, read(second));
+}
+
+void test_table_rebuilt_when_calibration_changes() {
+    TemperatureManagerImpl first;
+    first.setup();
+
+    fake::adcCoeffA = 52429; // 0.8 mV per code
+    TemperatureManagerImpl second;
+    second.setup();
+    TEST_ASSERT_EQUAL(2 * 4096, fake::adcCalConversions);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 30.0f, read(second));
+}
+
+void test_corrupt_cached_table_rebuilt() {
+    TemperatureManagerImpl first;
+    first.setup();
+
+    std::vector<uint8_t>& table = fake::nvs[ADC_CAL_NVS_NAMESPACE]["lut"];
+    table[2000] ^= 0x80; // Breaks monotonicity
+    TemperatureManagerImpl second;
+    second.setup();
+    TEST_ASSERT_EQUAL(2 * 4096, fake::adcCalConversions);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 25.0f, read(second));
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_converts_steady_reading);
+    RUN_TEST(test_rejects_spikes_in_burst);
+    RUN_TEST(test_out_of_range_kept_out_of_average);
+    RUN_TEST(test_reads_every_channel_in_one_frame);
+    RUN_TEST(test_table_cached_in_nvs);
+    RUN_TEST(test_table_rebuilt_when_calibration_changes);
+    RUN_TEST(test_corrupt_cached_table_rebuilt);
+    return UNITY_END();
+}
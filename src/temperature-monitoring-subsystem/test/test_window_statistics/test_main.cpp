@@ -0,0 +1,90 @@
+#include <unity.h>
+#include <math.h>
+#include "kernel/api/WindowStatistics.h"
+
+namespace {
+
+WindowStatistics statistics;
+
+/** @brief Adds a sample taken every second, numbered from 0. */
+void add(float temperature) {
+    TemperatureSample sample = {1000UL * statistics.count, temperature, statistics.count};
+    statistics.add(sample);
+}
+
+} // namespace
+
+void setUp() {
+    statistics.reset();
+}
+
+void tearDown() {}
+
+void test_empty_window() {
+    TEST_ASSERT_EQUAL(0, statistics.count);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, statistics.variance());
+}
+
+void test_single_sample() {
+    add(22.5f);
+    TEST_ASSERT_EQUAL(1, statistics.count);
+    TEST_ASSERT_EQUAL_FLOAT(22.5f, statistics.mean);
+    TEST_ASSERT_EQUAL_FLOAT(22.5f, statistics.min);
+    TEST_ASSERT_EQUAL_FLOAT(22.5f, statistics.max);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, statistics.variance());
+}
+
+void test_matches_two_pass_statistics() {
+    const float values[] = {21.3f, 22.8f, 20.9f, 24.1f, 23.0f, 22.2f, 21.7f};
+    const int count = sizeof(values) / sizeof(values[0]);
+    double sum = 0;
+    for (int i = 0; i < count; i++) {
+        add(values[i]);
+        sum += values[i];
+    }
+    double mean = sum / count;
+    double squares = 0;
+    for (int i = 0; i < count; i++) {
+        squares += (values[i] - mean) * (values[i] - mean);
+    }
+
+    TEST_ASSERT_EQUAL(count, statistics.count);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, (float)mean, statistics.mean);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, (float)(squares / (count - 1)), statistics.variance());
+    TEST_ASSERT_EQUAL_FLOAT(20.9f, statistics.min);
+    TEST_ASSERT_EQUAL_FLOAT(24.1f, statistics.max);
+    TEST_ASSERT_EQUAL_FLOAT(21.7f, statistics.last);
+}
+
+void test_variance_stable_for_small_changes() {
+    // A sum of squares in single precision would lose these 0.01 °C steps entirely
+    for (int i = 0; i < 1000; i++) {
+        add(i % 2 ? 25.01f : 25.0f);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(2e-6f, 0.000025f, statistics.variance());
+}
+
+void test_tracks_first_and_last_sample() {
+    add(20.0f);
+    add(21.0f);
+    add(22.0f);
+    TEST_ASSERT_EQUAL(0, statistics.firstTimestampMs);
+    TEST_ASSERT_EQUAL(2000, statistics.lastTimestampMs);
+    TEST_ASSERT_EQUAL(0, statistics.firstSequence);
+    TEST_ASSERT_EQUAL(2, statistics.lastSequence);
+
+    statistics.reset();
+    TEST_ASSERT_EQUAL(0, statistics.count);
+    add(30.0f);
+    TEST_ASSERT_EQUAL_FLOAT(30.0f, statistics.min);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_window);
+    RUN_TEST(test_single_sample);
+    RUN_TEST(test_matches_two_pass_statistics);
+    RUN_TEST(test_variance_stable_for_small_changes);
+    RUN_TEST(test_tracks_first_and_last_sample);
+    return UNITY_END();
+}
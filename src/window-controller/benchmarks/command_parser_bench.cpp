@@ -0,0 +1,197 @@
+/**
+ * @file command_parser_bench.cpp
+ * @brief Host-side benchmark of the serial command receive path.
+ *
+ * Feeds a mix of the Control Unit's commands through SerialCommandParser,
+ * each line first copied into a buffer the way ArduinoSerialLink assembles
+ * it in internalBuffer, and reports commands per second and heap
+ * allocations per command. The previous String-based path is modeled for
+ * comparison with the allocations the AVR String class makes for it: the
+ * String built from the buffer, its copy returned by readCommand() and the
+ * substring() holding the argument.
+ *
+ * The allocation count interposes malloc() and friends (glibc). The parser
+ * must make none: the run fails if it does, since on the Uno every heap
+ * allocation on the receive path fragments the 2 KB of SRAM over time.
+ * Absolute figures are host CPU time; compare them with each other only.
+ *
+ * Build and run from the window-controller directory:
+ *   g++ -O2 -std=gnu++17 -Isrc benchmarks/command_parser_bench.cpp src/devices/impl/SerialCommandParser.cpp \
+ *       -o command_parser_bench
+ *   ./command_parser_bench [commands]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+#include "devices/api/SerialCommandParser.h"
+
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* pointer, size_t size);
+
+namespace {
+
+const unsigned long DEFAULT_COMMANDS = 2000000;
+const size_t LINE_BUFFER_SIZE = 64;     ///< SERIAL_COMMAND_BUFFER_SIZE.
+
+bool countingAllocations = false;
+unsigned long allocations = 0;
+
+volatile int sink; ///< Keeps the optimizer from discarding the parsed values.
+
+/** @brief Traffic as the backend sends it: positions and temperatures dominate. */
+const char* const LINES[] = {
+    "SET_POS:42",
+    "TEMP:23.45",
+    "SET_POS:100",
+    "TEMP:27.10",
+    "ALARM_STATE:0",
+    "MODE:AUTOMATIC",
+    "MODE:MANUAL",
+    " TEMP:19.80 ",
+};
+const size_t LINE_COUNT = sizeof(LINES) / sizeof(LINES[0]);
+
+/** @brief Heap copy of text, as the AVR String constructor and copy constructor make. */
+char* heapCopy(const char* text, size_t length) {
+    char* copy = (char*)malloc(length + 1);
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+/** @brief Model of the previous path: String(internalBuffer), trim(), copy, startsWith/substring/toInt. */
+int parseStringModel(const char* buffer) {
+    const char* start = buffer;
+    while (*start == ' ') start++;
+    size_t length = strlen(start);
+    while (length > 0 && start[length - 1] == ' ') length--;
+
+    char* pending = heapCopy(start, length);                // pendingCommand = String(internalBuffer)
+    char* command = heapCopy(pending, length);              // readCommand() returns a copy
+    free(pending);
+
+    int value = 0;
+    if (strncmp(command, "SET_POS:", 8) == 0) {
+        char* argument = heapCopy(command + 8, length - 8); // substring(8)
+        value = atoi(argument);
+        free(argument);
+    } else if (strncmp(command, "TEMP:", 5) == 0) {
+        char* argument = heapCopy(command + 5, length - 5); // substring(5)
+        value = (int)lroundf((float)atof(argument) * 100);
+        free(argument);
+    } else if (strncmp(command, "ALARM_STATE:", 12) == 0) {
+        char* argument = heapCopy(command + 12, length - 12);
+        value = atoi(argument);
+        free(argument);
+    } else if (strcasecmp(command, "MODE:AUTOMATIC") == 0) {
+        value = 1;
+    } else if (strcasecmp(command, "MODE:MANUAL") == 0) {
+        value = 2;
+    }
+    free(command);
+    return value;
+}
+
+int parseInPlace(char* buffer) {
+    SerialCommand command;
+    if (!SerialCommandParser::parse(buffer, command)) {
+        return 0;
+    }
+    switch (command.type) {
+        case SerialCommandType::SET_POS: return command.position;
+        case SerialCommandType::SET_TEMP: return (int)lroundf(command.temperature * 100);
+        case SerialCommandType::ALARM_STATE: return command.alarm ? 1 : 0;
+        case SerialCommandType::MODE_AUTOMATIC: return 1;
+        case SerialCommandType::MODE_MANUAL: return 2;
+        default: return 0;
+    }
+}
+
+struct Result {
+    double commandsPerS;
+    double allocationsPerCommand;
+};
+
+template <typename Parse>
+Result run(unsigned long commands, Parse parse) {
+    char buffer[LINE_BUFFER_SIZE];
+    allocations = 0;
+    countingAllocations = true;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < commands; i++) {
+        // The link assembles each line in its buffer before it is parsed
+        strcpy(buffer, LINES[i % LINE_COUNT]);
+        sink = parse(buffer);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    countingAllocations = false;
+
+    Result result;
+    result.commandsPerS = commands / std::chrono::duration<double>(elapsed).count();
+    result.allocationsPerCommand = (double)allocations / commands;
+    return result;
+}
+
+/** @brief Both paths must agree on every line of the mix. */
+bool sameResults() {
+    char buffer[LINE_BUFFER_SIZE];
+    for (size_t i = 0; i < LINE_COUNT; i++) {
+        strcpy(buffer, LINES[i]);
+        int inPlace = parseInPlace(buffer);
+        if (inPlace != parseStringModel(LINES[i])) {
+            std::fprintf(stderr, "Mismatch on \"%s\"\n", LINES[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+void print(const char* name, const Result& result) {
+    std::printf("%-34s %14.0f %16.2f\n", name, result.commandsPerS, result.allocationsPerCommand);
+}
+
+} // namespace
+
+extern "C" void* malloc(size_t size) {
+    if (countingAllocations) allocations++;
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+    if (countingAllocations) allocations++;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* pointer, size_t size) {
+    if (countingAllocations) allocations++;
+    return __libc_realloc(pointer, size);
+}
+
+int main(int argc, char** argv) {
+    unsigned long commands = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : DEFAULT_COMMANDS;
+    if (commands == 0) {
+        std::fprintf(stderr, "Usage: %s [commands]\n", argv[0]);
+        return 1;
+    }
+    if (!sameResults()) {
+        return 1;
+    }
+
+    std::printf("%lu commands, %zu-line mix\n", commands, LINE_COUNT);
+    std::printf("%-34s %14s %16s\n", "receive path", "commands/s", "allocs/command");
+    print("String model (copy, substring)", run(commands, parseStringModel));
+    Result inPlace = run(commands, parseInPlace);
+    print("SerialCommandParser (in place)", inPlace);
+
+    if (inPlace.allocationsPerCommand != 0.0) {
+        std::fprintf(stderr, "SerialCommandParser allocated on the receive path\n");
+        return 1;
+    }
+    return 0;
+}
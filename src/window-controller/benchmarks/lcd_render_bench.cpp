@@ -0,0 +1,273 @@
+/**
+ * @file lcd_render_bench.cpp
+ * @brief Host-side benchmark of the I2C LCD renderers.
+ *
+ * Replays a session of display updates through the previous renderer
+ * (whole lines, clearRestOfLine() padding, lcd.clear() on mode changes)
+ * and the shadow buffer renderer, and reports LCD and I2C bytes per update
+ * and the time the loop spends blocked in them.
+ *
+ * Both renderers compose the lines exactly as I2CLcdView does, against a
+ * counting LCD that prices each call the way LiquidCrystal_I2C drives the
+ * PCF8574 backpack in 4-bit mode: an LCD byte (character or command) is two
+ * nibbles of three expander writes each, every write an I2C transaction of
+ * address plus data byte at 100 kHz, plus the 2 x 50 us enable pulses;
+ * clear() waits a further 2 ms.
+ *
+ * The session runs loop() every 5 ms for 120 s in MANUAL mode with the
+ * potentiometer swept now and then, a new temperature every 10 s, a switch
+ * to AUTOMATIC and back, and 10 s of ALARM. Reported per renderer: updates
+ * that wrote to the LCD, LCD and I2C bytes per such update, I2C bytes per
+ * second, the milliseconds per second loop() spends blocked in the LCD and
+ * the longest single update.
+ *
+ * Build and run from the window-controller directory:
+ *   g++ -O2 -std=gnu++17 -Isrc benchmarks/lcd_render_bench.cpp -o lcd_render_bench
+ *   ./lcd_render_bench
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "devices/api/LcdShadowBuffer.h"
+
+namespace {
+
+const int LCD_ROWS = 4;                         ///< As config.h.
+const int LCD_COLUMNS = 16;                     ///< As config.h.
+const unsigned long LCD_REFRESH_INTERVAL_MS = 250;
+const unsigned long LOOP_PERIOD_MS = 5;
+const unsigned long SESSION_MS = 120000;
+
+const double I2C_BIT_US = 10.0;                 ///< 100 kHz.
+const int I2C_BYTES_PER_LCD_BYTE = 12;          ///< 6 transactions of address + data.
+const double I2C_TRANSACTION_US = 20 * I2C_BIT_US; ///< 2 x 9 bits, start and stop.
+const double LCD_BYTE_US = 6 * I2C_TRANSACTION_US + 2 * 51.0;
+const double LCD_CLEAR_WAIT_US = 2000.0;
+
+const float INVALID_TEMPERATURE = -1000.0f;
+const float TEMPERATURE_UPDATE_THRESHOLD = 0.05f;
+
+/** @brief LCD stand-in that prices every call in LCD bytes and blocking time. */
+class CountingLcd {
+public:
+    unsigned long lcdBytes = 0;
+    double blockedUs = 0.0;
+
+    void setCursor(uint8_t, uint8_t) { send(); }
+    size_t write(uint8_t) { send(); return 1; }
+    void clear() { send(); blockedUs += LCD_CLEAR_WAIT_US; }
+    void print(const char* text) { while (*text) write((uint8_t)*text++); }
+
+private:
+    void send() {
+        lcdBytes++;
+        blockedUs += LCD_BYTE_US;
+    }
+};
+
+struct Inputs {
+    bool isAutoMode;
+    int windowPercentage;
+    float temperature;
+    bool isAlarmState;
+};
+
+/** @brief Previous values and refresh interval, as the I2CLcdView members. */
+struct ViewState {
+    bool forceUpdate = true;
+    unsigned long lastUpdateTimeMs = 0;
+    bool prevIsAutoMode = false;
+    int prevWindowPercentage = -1;
+    float prevCurrentTemperature = INVALID_TEMPERATURE;
+    bool prevIsAlarmState = false;
+
+    bool contentChanged(const Inputs& in) const {
+        return in.isAutoMode != prevIsAutoMode || in.windowPercentage != prevWindowPercentage ||
+               (!in.isAutoMode && std::fabs(in.temperature - prevCurrentTemperature) > TEMPERATURE_UPDATE_THRESHOLD);
+    }
+
+    void store(const Inputs& in, unsigned long now) {
+        lastUpdateTimeMs = now;
+        prevIsAutoMode = in.isAutoMode;
+        prevWindowPercentage = in.windowPercentage;
+        prevCurrentTemperature = in.temperature;
+    }
+};
+
+/** @brief The previous I2CLcdView::update(): lcd.clear() and whole lines padded with spaces. */
+class LineRenderer {
+public:
+    void update(CountingLcd& lcd, const Inputs& in, unsigned long now) {
+        bool modeChanged = in.isAutoMode != s.prevIsAutoMode;
+        bool alarmStateChanged = in.isAlarmState != s.prevIsAlarmState;
+        if (!s.forceUpdate && !s.contentChanged(in) && now - s.lastUpdateTimeMs < LCD_REFRESH_INTERVAL_MS) {
+            return;
+        }
+
+        if (in.isAlarmState) {
+            if (alarmStateChanged || s.forceUpdate) {
+                lcd.clear();
+                lcd.setCursor(0, 0);
+                lcd.print("ALARM STATE");
+                lcd.setCursor(0, 1);
+                lcd.print("Reset Required");
+                s.forceUpdate = false;
+            }
+            s.prevIsAlarmState = in.isAlarmState;
+            return;
+        }
+        if (alarmStateChanged) {
+            lcd.clear();
+            s.forceUpdate = true;
+        }
+        if (s.forceUpdate || modeChanged) {
+            lcd.clear();
+        }
+        s.forceUpdate = false;
+        s.prevIsAlarmState = in.isAlarmState;
+
+        char text[24];
+        lcd.setCursor(0, 0);
+        lcd.print("Mode: ");
+        lcd.print(in.isAutoMode ? "AUTO  " : "MANUAL");
+        clearRestOfLine(lcd, 12);
+
+        snprintf(text, sizeof(text), "%d%%", in.windowPercentage);
+        lcd.setCursor(0, 1);
+        lcd.print("Pos: ");
+        lcd.print(text);
+        clearRestOfLine(lcd, 5 + (int)strlen(text));
+
+        lcd.setCursor(0, 2);
+        if (!in.isAutoMode) {
+            if (in.temperature > INVALID_TEMPERATURE + 100.0f) {
+                snprintf(text, sizeof(text), "%.1f", in.temperature);
+                lcd.print("Temp: ");
+                lcd.print(text);
+                lcd.print(" C");
+                clearRestOfLine(lcd, 6 + (int)strlen(text) + 2);
+            } else {
+                lcd.print("Temp: --- C");
+                clearRestOfLine(lcd, 11);
+            }
+        } else {
+            clearRestOfLine(lcd, 0);
+        }
+        s.store(in, now);
+    }
+
+private:
+    ViewState s;
+
+    void clearRestOfLine(CountingLcd& lcd, int startColumn) {
+        for (int i = startColumn; i < LCD_COLUMNS; i++) {
+            lcd.print(" ");
+        }
+    }
+};
+
+/** @brief The current I2CLcdView::update(): compose the screen, then send the differences. */
+class ShadowRenderer {
+public:
+    ShadowRenderer() { frame.markCleared(); }
+
+    void update(CountingLcd& lcd, const Inputs& in, unsigned long now) {
+        bool alarmStateChanged = in.isAlarmState != s.prevIsAlarmState;
+        if (!s.forceUpdate && !s.contentChanged(in) && !alarmStateChanged &&
+            now - s.lastUpdateTimeMs < LCD_REFRESH_INTERVAL_MS) {
+            return;
+        }
+        s.forceUpdate = false;
+
+        char line[LCD_COLUMNS + 1];
+        frame.clearFrame();
+        if (in.isAlarmState) {
+            frame.print(0, 0, "ALARM STATE");
+            frame.print(1, 0, "Reset Required");
+        } else {
+            snprintf(line, sizeof(line), "Mode: %s", in.isAutoMode ? "AUTO" : "MANUAL");
+            frame.print(0, 0, line);
+            snprintf(line, sizeof(line), "Pos: %d%%", in.windowPercentage);
+            frame.print(1, 0, line);
+            if (!in.isAutoMode) {
+                if (in.temperature > INVALID_TEMPERATURE + 100.0f) {
+                    snprintf(line, sizeof(line), "Temp: %.1f C", in.temperature);
+                } else {
+                    snprintf(line, sizeof(line), "Temp: --- C");
+                }
+                frame.print(2, 0, line);
+            }
+        }
+        frame.flush(lcd);
+
+        s.store(in, now);
+        s.prevIsAlarmState = in.isAlarmState;
+    }
+
+private:
+    ViewState s;
+    LcdShadowBuffer<LCD_ROWS, LCD_COLUMNS> frame;
+};
+
+/** @brief Display inputs at a point of the session. */
+Inputs inputsAt(unsigned long now) {
+    Inputs in;
+    in.isAutoMode = now >= 40000 && now < 60000;
+    in.isAlarmState = now >= 90000 && now < 100000;
+    in.temperature = now < 2000 ? INVALID_TEMPERATURE : 21.0f + 0.1f * (float)((now / 10000) % 7);
+
+    // Potentiometer sweeps for 3 s every 15 s, 2 % steps as MANUAL_PERCENTAGE_CHANGE_THRESHOLD
+    unsigned long phase = now % 15000;
+    int sweep = phase < 3000 ? (int)(phase / 100) * 2 : 60;
+    in.windowPercentage = in.isAutoMode ? 40 : (sweep > 100 ? 100 : sweep);
+    return in;
+}
+
+struct Result {
+    unsigned long renders = 0;      ///< Updates that wrote to the LCD
+    unsigned long lcdBytes = 0;
+    double blockedUs = 0.0;
+    double worstUs = 0.0;
+};
+
+template <typename Renderer>
+Result run() {
+    Renderer renderer;
+    CountingLcd lcd;
+    Result result;
+    for (unsigned long now = 0; now < SESSION_MS; now += LOOP_PERIOD_MS) {
+        double before = lcd.blockedUs;
+        unsigned long bytesBefore = lcd.lcdBytes;
+        renderer.update(lcd, inputsAt(now), now);
+        if (lcd.lcdBytes != bytesBefore) {
+            result.renders++;
+            result.worstUs = std::fmax(result.worstUs, lcd.blockedUs - before);
+        }
+    }
+    result.lcdBytes = lcd.lcdBytes;
+    result.blockedUs = lcd.blockedUs;
+    return result;
+}
+
+void print(const char* name, const Result& result) {
+    double seconds = SESSION_MS / 1000.0;
+    std::printf("%-14s %8lu %10.1f %10.1f %10.0f %10.1f %10.1f\n", name, result.renders,
+                (double)result.lcdBytes / result.renders,
+                (double)result.lcdBytes * I2C_BYTES_PER_LCD_BYTE / result.renders,
+                (double)result.lcdBytes * I2C_BYTES_PER_LCD_BYTE / seconds, result.blockedUs / 1000.0 / seconds,
+                result.worstUs / 1000.0);
+}
+
+} // namespace
+
+int main() {
+    std::printf("%lu s session, loop() every %lu ms\n", SESSION_MS / 1000, LOOP_PERIOD_MS);
+    std::printf("%-14s %8s %10s %10s %10s %10s %10s\n", "renderer", "updates", "LCD B/upd", "I2C B/upd",
+                "I2C B/s", "ms/s", "worst ms");
+    print("whole lines", run<LineRenderer>());
+    print("shadow buffer", run<ShadowRenderer>());
+    return 0;
+}
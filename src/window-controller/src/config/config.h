@@ -69,6 +69,41 @@ const long SERIAL_COM_BAUD_RATE = 115200;
 /** @brief Buffer size for incoming serial command assembly */
 const unsigned int SERIAL_COMMAND_BUFFER_SIZE = 64;
 
+/**
+ * @brief Link to the Control Unit: 0 text command lines, 1 COBS-framed binary packets with CRC-8
+ *
+ * A preprocessor constant so that only the selected link is built. The
+ * Control Unit detects the binary link when it connects (SERIAL_PROTOCOL
+ * "auto" in its configuration).
+ */
+#ifndef SERIAL_BINARY_PROTOCOL
+#define SERIAL_BINARY_PROTOCOL 0
+#endif
+
+//=============================================================================
+// LOGGING CONFIGURATION
+//=============================================================================
+
+/**
+ * @brief Most verbose log level compiled in: 0 none, 1 error, 2 warning, 3 info, 4 debug
+ *
+ * A preprocessor constant so that disabled levels generate no code.
+ */
+#ifndef LOG_LEVEL
+#define LOG_LEVEL 3
+#endif
+
+/** @brief Log messages queued between drains before the oldest are dropped (12 bytes each) */
+const uint8_t LOG_BUFFER_RECORDS = 8;
+
+/**
+ * @brief Maximum length of one formatted log line
+ *
+ * Must stay below the 64 byte UART transmit buffer: lines are only written
+ * whole, so they never interleave with protocol messages on the link.
+ */
+const uint8_t LOG_LINE_MAX_LEN = 48;
+
 //=============================================================================
 // SYSTEM TIMING CONFIGURATION
 //=============================================================================
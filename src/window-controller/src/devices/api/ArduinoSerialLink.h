@@ -13,6 +13,9 @@
  * Arduino's built-in HardwareSerial interface. It implements
  * robust command parsing with overflow protection and proper
  * message formatting according to the defined protocol.
+ * 
+ * The receive path does not allocate: a complete line stays in
+ * internalBuffer until readCommand() parses it there.
  */
 class ArduinoSerialLink : public ControlUnitLink {
 public:
@@ -32,7 +35,7 @@ public:
     // ControlUnitLink interface implementation
     void setup(long baudRate) override;
     bool commandAvailable() override;
-    String readCommand() override;
+    bool readCommand(SerialCommand& command) override;
     void sendPotentiometerValue(int percentage) override;
     void sendModeChangedNotification(SystemOpMode newMode) override;
     void sendAckModeChange(SystemOpMode acknowledgedMode) override;
@@ -44,10 +47,7 @@ private:
     /** @brief Current write position in internal buffer */
     byte bufferIndex;
     
-    /** @brief Storage for complete, parsed command */
-    String pendingCommand;
-    
-    /** @brief Flag indicating complete command is ready for reading */
+    /** @brief Flag indicating a complete, null-terminated command is in internalBuffer */
     bool cmdReady;
 
     /**
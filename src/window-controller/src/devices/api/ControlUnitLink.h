@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "config/config.h"
+#include "SerialCommandParser.h"
 
 /**
  * @class ControlUnitLink
@@ -13,10 +14,12 @@
  * (position settings, mode changes) and outgoing notifications
  * (status updates, user input events).
  * 
- * Communication Protocol:
+ * Communication Protocol (text lines; FramedSerialLink carries the same
+ * messages as binary packets, see SerialFrame.h):
  * - Incoming Commands:
  *   - "SET_POS:<percentage>\\n" - Set window position (0-100%)
  *   - "TEMP:<temperature>\\n" - Update temperature reading
+ *   - "ALARM_STATE:<0|1>\\n" - Enter or leave the ALARM state
  *   - "MODE:AUTOMATIC\\n" - Switch to automatic mode
  *   - "MODE:MANUAL\\n" - Switch to manual mode
  * 
@@ -52,15 +55,17 @@ public:
     virtual bool commandAvailable() = 0;
 
     /**
-     * @brief Read complete command from buffer
+     * @brief Read and parse complete command from buffer
      * 
      * Retrieves and consumes the oldest complete command from
      * the internal buffer. Command is removed from buffer after reading.
+     * Parsing must not allocate: it runs on every received line.
      * 
-     * @return Complete command string (without termination characters)
-     * @return Empty string if no command available
+     * @param command Parsed command (type NONE if not recognized)
+     * @return true if a known command was read
+     * @return false if no command available or the line was not recognized
      */
-    virtual String readCommand() = 0;
+    virtual bool readCommand(SerialCommand& command) = 0;
 
     /**
      * @brief Send potentiometer value to Control Unit
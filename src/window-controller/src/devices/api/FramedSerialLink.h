@@ -0,0 +1,72 @@
+#ifndef FRAMED_SERIAL_LINK_H
+#define FRAMED_SERIAL_LINK_H
+
+#include "ControlUnitLink.h"
+#include "SerialFrame.h"
+#include <Arduino.h>
+#include "config/config.h"
+
+/**
+ * @class FramedSerialLink
+ * @brief Binary HardwareSerial implementation of ControlUnitLink
+ *
+ * Exchanges COBS-framed packets with a CRC-8 (see SerialFrame.h) instead
+ * of text lines, so a corrupted byte drops the packet instead of changing
+ * a command. Arguments are fixed-width integers: no number parsing on the
+ * receive path. HELLO packets are answered here and never reach the FSM.
+ * Selected with SERIAL_BINARY_PROTOCOL.
+ */
+class FramedSerialLink : public ControlUnitLink {
+public:
+    /**
+     * @brief Construct binary serial communication handler
+     */
+    FramedSerialLink();
+
+    /**
+     * @brief Default destructor
+     */
+    virtual ~FramedSerialLink() = default;
+
+    // ControlUnitLink interface implementation
+    void setup(long baudRate) override;
+    bool commandAvailable() override;
+    bool readCommand(SerialCommand& command) override;
+    void sendPotentiometerValue(int percentage) override;
+    void sendModeChangedNotification(SystemOpMode newMode) override;
+    void sendAckModeChange(SystemOpMode acknowledgedMode) override;
+
+private:
+    /** @brief Frame being received, decoded in place once its delimiter arrives */
+    uint8_t frameBuffer[SERIAL_FRAME_MAX_LEN];
+
+    /** @brief Bytes received of the current frame */
+    uint8_t frameLength;
+
+    /** @brief Set when the current frame outgrew frameBuffer; it is dropped at its delimiter */
+    bool frameOverflow;
+
+    /** @brief Command of the last valid packet, until read */
+    SerialCommand pendingCommand;
+
+    /** @brief Flag indicating pendingCommand is ready for reading */
+    bool cmdReady;
+
+    /**
+     * @brief Read available bytes until a command is complete
+     */
+    void processIncomingSerial();
+
+    /**
+     * @brief Turn a decoded packet into pendingCommand, or answer it
+     * @return true if the packet is a command for the FSM
+     */
+    bool handlePacket(const uint8_t* packet, size_t length);
+
+    /**
+     * @brief Send a packet with a one byte payload, delimited on both sides
+     */
+    void sendPacket(uint8_t type, uint8_t value);
+};
+
+#endif // FRAMED_SERIAL_LINK_H
@@ -2,6 +2,7 @@
 #define I2C_LCD_VIEW_H
 
 #include "LcdView.h"
+#include "LcdShadowBuffer.h"
 #include <LiquidCrystal_I2C.h>
 #include "config/config.h"
 
@@ -10,8 +11,10 @@
  * @brief I2C LCD implementation of LcdView interface
  * 
  * This class provides concrete LCD display control using I2C communication.
- * It implements optimized display updates that minimize flickering by
- * tracking previous display state and only updating changed content.
+ * Each update composes the whole screen into a shadow buffer and sends only
+ * the characters that differ from what is on the glass: every LCD byte
+ * costs six I2C transactions through the PCF8574 backpack, so redrawing
+ * whole lines blocked the loop for tens of milliseconds.
  */
 class I2CLcdView : public LcdView {
 public:
@@ -38,6 +41,7 @@ public:
 
 private:
     LiquidCrystal_I2C lcd;              ///< I2C LCD library instance
+    LcdShadowBuffer<LCD_ROWS, LCD_COLUMNS> frame;  ///< Glass contents and the frame being composed
     unsigned long lastUpdateTimeMs;     ///< Timestamp of last display update
     
     // Previous display values for change detection
@@ -55,15 +59,12 @@ private:
     static constexpr float TEMPERATURE_UPDATE_THRESHOLD = 0.05f;
 
     /**
-     * @brief Clear remaining characters on LCD line
-     * 
-     * Clears characters from specified column to end of line to prevent
-     * display artifacts when new text is shorter than previous text.
+     * @brief Compose one line of the next frame from a flash string
      * 
      * @param row LCD row number (0-based)
-     * @param startColumn Starting column for clearing (0-based)
+     * @param text Line text in flash, clipped to LCD_COLUMNS
      */
-    void clearRestOfLine(int row, int startColumn);
+    void printLine(uint8_t row, PGM_P text);
 };
 
 #endif // I2C_LCD_VIEW_H
\ No newline at end of file
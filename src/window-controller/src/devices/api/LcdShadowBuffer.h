@@ -0,0 +1,136 @@
+#ifndef LCD_SHADOW_BUFFER_H
+#define LCD_SHADOW_BUFFER_H
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @class LcdShadowBuffer
+ * @brief Shadow of a character LCD: sends only the characters that change
+ *
+ * Holds two frames: what is on the glass and the next frame being
+ * composed. flush() compares them and writes the changed runs of each row,
+ * moving the cursor only where a run does not start at the position the
+ * previous write left it. On an I2C backpack every character and every
+ * cursor move is a full LCD byte (a dozen bus bytes), so an unchanged
+ * screen costs nothing and a changed value costs its own characters.
+ *
+ * Header-only so that it builds on the host with any LCD type offering
+ * setCursor(column, row) and write(uint8_t), as LiquidCrystal_I2C does.
+ *
+ * @tparam Rows Number of character rows
+ * @tparam Columns Number of character columns
+ */
+template <uint8_t Rows, uint8_t Columns>
+class LcdShadowBuffer {
+public:
+    LcdShadowBuffer() {
+        invalidate();
+        clearFrame();
+    }
+
+    /**
+     * @brief Starts a new frame: every character blank
+     */
+    void clearFrame() {
+        memset(next, ' ', sizeof(next));
+    }
+
+    /**
+     * @brief Writes text into the next frame, clipped at the end of the row
+     */
+    void print(uint8_t row, uint8_t column, const char* text) {
+        if (row >= Rows) {
+            return;
+        }
+        while (*text && column < Columns) {
+            next[row][column++] = *text++;
+        }
+    }
+
+    /**
+     * @brief Records that the display was cleared (all blank, cursor home)
+     */
+    void markCleared() {
+        memset(shown, ' ', sizeof(shown));
+        cursorRow = 0;
+        cursorColumn = 0;
+    }
+
+    /**
+     * @brief Forgets what is on the glass, so the next flush() rewrites everything
+     */
+    void invalidate() {
+        memset(shown, UNKNOWN, sizeof(shown));
+        cursorRow = UNKNOWN_POSITION;
+    }
+
+    /**
+     * @brief Sends the differences between the next frame and the glass
+     * @param lcd Display to write to
+     * @return LCD bytes sent: characters plus cursor moves
+     */
+    template <typename Lcd>
+    uint16_t flush(Lcd& lcd) {
+        uint16_t lcdBytes = 0;
+        for (uint8_t row = 0; row < Rows; row++) {
+            uint8_t column = 0;
+            while (column < Columns) {
+                if (next[row][column] == shown[row][column]) {
+                    column++;
+                    continue;
+                }
+
+                uint8_t end = runEnd(row, column);
+                if (row != cursorRow || column != cursorColumn) {
+                    lcd.setCursor(column, row);
+                    lcdBytes++;
+                }
+                for (; column < end; column++) {
+                    lcd.write((uint8_t)next[row][column]);
+                    shown[row][column] = next[row][column];
+                    lcdBytes++;
+                }
+                // The LCD advances its cursor with each character
+                cursorRow = row;
+                cursorColumn = end;
+            }
+        }
+        return lcdBytes;
+    }
+
+private:
+    /** @brief Marks a glass character as unknown; the views never compose it (full block in the LCD ROM) */
+    static const char UNKNOWN = (char)0xFF;
+
+    /** @brief cursorRow value when the cursor position is unknown */
+    static const uint8_t UNKNOWN_POSITION = 0xFF;
+
+    /**
+     * @brief Unchanged characters a run absorbs instead of ending
+     *
+     * Rewriting one unchanged character costs one LCD byte, the same as the
+     * cursor move that would skip it, so a gap of one is written through.
+     */
+    static const uint8_t MAX_REWRITTEN_GAP = 1;
+
+    char shown[Rows][Columns];  ///< Characters on the glass
+    char next[Rows][Columns];   ///< Frame being composed
+    uint8_t cursorRow;          ///< Row of the LCD cursor, UNKNOWN_POSITION if unknown
+    uint8_t cursorColumn;       ///< Column of the LCD cursor
+
+    /**
+     * @brief End (exclusive) of the run of changes starting at column
+     */
+    uint8_t runEnd(uint8_t row, uint8_t column) const {
+        uint8_t end = column + 1;
+        for (uint8_t i = end; i < Columns && i - end < MAX_REWRITTEN_GAP + 1; i++) {
+            if (next[row][i] != shown[row][i]) {
+                end = i + 1;
+            }
+        }
+        return end;
+    }
+};
+
+#endif // LCD_SHADOW_BUFFER_H
@@ -0,0 +1,54 @@
+#ifndef SERIAL_COMMAND_PARSER_H
+#define SERIAL_COMMAND_PARSER_H
+
+#include <stdint.h>
+
+/**
+ * @enum SerialCommandType
+ * @brief Commands the Control Unit sends to the window controller
+ */
+enum class SerialCommandType : uint8_t {
+    NONE,           ///< Empty or unrecognized line
+    SET_POS,        ///< "SET_POS:<percentage>"
+    SET_TEMP,       ///< "TEMP:<temperature>"
+    ALARM_STATE,    ///< "ALARM_STATE:<0|1>"
+    MODE_AUTOMATIC, ///< "MODE:AUTOMATIC"
+    MODE_MANUAL     ///< "MODE:MANUAL"
+};
+
+/**
+ * @struct SerialCommand
+ * @brief Parsed command with its typed argument
+ */
+struct SerialCommand {
+    SerialCommandType type;     ///< Command kind, NONE if the line was not recognized
+    union {
+        int position;           ///< SET_POS: window position in percent (not range-checked)
+        float temperature;      ///< SET_TEMP: temperature in Celsius
+        bool alarm;             ///< ALARM_STATE: true for "1"
+    };
+};
+
+/**
+ * @class SerialCommandParser
+ * @brief Allocation-free parser of Control Unit command lines
+ *
+ * Parses in place: the line is only trimmed (a terminator written after
+ * the last non-blank character), never copied. The first byte selects the
+ * candidate entries of a command table kept in flash, so a line is compared
+ * against one or two prefixes at most. Arguments are read as toInt() and
+ * toFloat() did: digits up to the first invalid character, 0 if none.
+ * Argument-less commands match the whole line, ignoring case.
+ */
+class SerialCommandParser {
+public:
+    /**
+     * @brief Parses one command line
+     * @param line Null-terminated line without its line terminator; modified (trimmed)
+     * @param command Parsed command, type NONE if the line is not a command
+     * @return True if the line is a known command
+     */
+    static bool parse(char* line, SerialCommand& command);
+};
+
+#endif // SERIAL_COMMAND_PARSER_H
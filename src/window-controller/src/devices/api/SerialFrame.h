@@ -0,0 +1,88 @@
+#ifndef SERIAL_FRAME_H
+#define SERIAL_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Binary protocol between the Control Unit and the window controller.
+ *
+ * A packet is a type byte, the fixed-width little-endian payload of that
+ * type and a CRC-8 (polynomial 0x07, initial value 0) over both. Packets
+ * are COBS-encoded, so they contain no zero byte, and sent as
+ * 0x00 <frame> 0x00: the leading delimiter separates a frame from any log
+ * line written before it on the same UART.
+ *
+ * The Control Unit sends HELLO when it connects; a controller built with
+ * SERIAL_BINARY_PROTOCOL answers HELLO_ACK, otherwise the Control Unit
+ * falls back to the text commands.
+ */
+
+/** @brief Protocol version exchanged in HELLO / HELLO_ACK */
+const uint8_t SERIAL_FRAME_VERSION = 1;
+
+/** @brief Frame delimiter, the only byte COBS removes from the packets */
+const uint8_t SERIAL_FRAME_DELIMITER = 0x00;
+
+/** @brief Largest packet: type, 2 payload bytes, CRC */
+const size_t SERIAL_PACKET_MAX_LEN = 4;
+
+/** @brief Largest encoded frame, delimiters excluded (COBS adds one byte per 254) */
+const size_t SERIAL_FRAME_MAX_LEN = SERIAL_PACKET_MAX_LEN + 1;
+
+/**
+ * @enum SerialPacketType
+ * @brief Type byte of a packet and the payload it carries
+ */
+enum SerialPacketType : uint8_t {
+    // Control Unit -> window controller
+    SERIAL_PACKET_HELLO = 0x01,         ///< u8 protocol version
+    SERIAL_PACKET_SET_POS = 0x02,       ///< u8 window position in percent
+    SERIAL_PACKET_TEMP = 0x03,          ///< i16 temperature in hundredths of a degree Celsius
+    SERIAL_PACKET_ALARM_STATE = 0x04,   ///< u8 1 in ALARM, 0 otherwise
+    SERIAL_PACKET_MODE = 0x05,          ///< u8 SERIAL_MODE_*
+
+    // Window controller -> Control Unit
+    SERIAL_PACKET_HELLO_ACK = 0x81,     ///< u8 protocol version
+    SERIAL_PACKET_POT = 0x82,           ///< u8 potentiometer position in percent
+    SERIAL_PACKET_MODE_CHANGED = 0x83,  ///< u8 SERIAL_MODE_*, mode changed with the button
+    SERIAL_PACKET_ACK_MODE = 0x84       ///< u8 SERIAL_MODE_*, MODE packet applied
+};
+
+/** @brief Mode values of MODE, MODE_CHANGED and ACK_MODE */
+const uint8_t SERIAL_MODE_AUTOMATIC = 0;
+const uint8_t SERIAL_MODE_MANUAL = 1;
+
+/**
+ * @class SerialFrame
+ * @brief Packet framing: CRC-8 and COBS encoding, without allocation
+ */
+class SerialFrame {
+public:
+    /**
+     * @brief CRC-8 with polynomial 0x07 and initial value 0 (CRC-8/SMBUS)
+     */
+    static uint8_t crc8(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Builds a packet and COBS-encodes it
+     * @param type Packet type
+     * @param payload Payload bytes of the type
+     * @param payloadLength Number of payload bytes
+     * @param out Encoded frame, without delimiters
+     * @param capacity Size of out, at least SERIAL_FRAME_MAX_LEN for any packet
+     * @return Frame length, 0 if the packet does not fit
+     */
+    static size_t encode(uint8_t type, const uint8_t* payload, size_t payloadLength,
+                         uint8_t* out, size_t capacity);
+
+    /**
+     * @brief COBS-decodes a received frame in place and checks its CRC
+     * @param frame Frame without delimiters; replaced by the packet (type and payload)
+     * @param length Frame length
+     * @return Length of type and payload, 0 for a malformed frame or a CRC mismatch
+     */
+    static size_t decode(uint8_t* frame, size_t length);
+};
+
+#endif // SERIAL_FRAME_H
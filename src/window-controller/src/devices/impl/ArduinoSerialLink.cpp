@@ -1,4 +1,5 @@
 #include "../api/ArduinoSerialLink.h"
+#include "../../kernel/api/Log.h"
 #include "config/config.h"
 
 ArduinoSerialLink::ArduinoSerialLink()
@@ -20,19 +21,23 @@ bool ArduinoSerialLink::commandAvailable() {
     return cmdReady;
 }
 
-String ArduinoSerialLink::readCommand() {
+bool ArduinoSerialLink::readCommand(SerialCommand& command) {
     // Ensure any pending serial data is processed
     processIncomingSerial();
     
-    if (cmdReady) {
-        // Consume the command and reset state
-        cmdReady = false;
-        String commandToReturn = pendingCommand;
-        pendingCommand = "";
-        return commandToReturn;
+    if (!cmdReady) {
+        command.type = SerialCommandType::NONE;
+        return false;  // No command available
     }
-    
-    return "";  // No command available
+
+    // Consume the command and reset state; nothing is received until the next call
+    cmdReady = false;
+    bufferIndex = 0;
+    if (!SerialCommandParser::parse(internalBuffer, command)) {
+        LOG_DEBUG("Unknown serial command ignored");
+        return false;
+    }
+    return true;
 }
 
 void ArduinoSerialLink::sendPotentiometerValue(int percentage) {
@@ -89,17 +94,10 @@ void ArduinoSerialLink::processIncomingSerial() {
             
             // Only process if buffer contains data
             if (bufferIndex > 0) {
-                // Null-terminate the command string
+                // Null-terminate the command string; readCommand() parses it in place
                 internalBuffer[bufferIndex] = '\0';
                 
-                // Convert to String and trim whitespace
-                pendingCommand = String(internalBuffer);
-                pendingCommand.trim();
-                
-                // Reset buffer for next command
-                bufferIndex = 0;
-                
-                // Mark command as ready
+                // Mark command as ready, the buffer is reset once it is read
                 cmdReady = true;
             }
             // If buffer is empty, ignore the termination character
@@ -110,7 +108,7 @@ void ArduinoSerialLink::processIncomingSerial() {
                 internalBuffer[bufferIndex++] = incomingChar;
             } else {
                 // Buffer overflow: report error and reset
-                Serial.println(F("ERR:CMD_BUFFER_OVERFLOW"));
+                LOG_WARN("ERR:CMD_BUFFER_OVERFLOW");
                 bufferIndex = 0;
                 internalBuffer[0] = '\0';
             }
@@ -0,0 +1,127 @@
+#include "../api/FramedSerialLink.h"
+#include "../../kernel/api/Log.h"
+#include "config/config.h"
+
+namespace {
+
+uint8_t modeValue(SystemOpMode mode) {
+    return mode == SystemOpMode::MANUAL ? SERIAL_MODE_MANUAL : SERIAL_MODE_AUTOMATIC;
+}
+
+} // namespace
+
+FramedSerialLink::FramedSerialLink()
+    : frameLength(0)
+    , frameOverflow(false)
+    , cmdReady(false)
+{
+    pendingCommand.type = SerialCommandType::NONE;
+}
+
+void FramedSerialLink::setup(long baudRate) {
+    Serial.begin(baudRate);
+}
+
+bool FramedSerialLink::commandAvailable() {
+    processIncomingSerial();
+    return cmdReady;
+}
+
+bool FramedSerialLink::readCommand(SerialCommand& command) {
+    processIncomingSerial();
+
+    if (!cmdReady) {
+        command.type = SerialCommandType::NONE;
+        return false;
+    }
+    cmdReady = false;
+    command = pendingCommand;
+    return true;
+}
+
+void FramedSerialLink::sendPotentiometerValue(int percentage) {
+    sendPacket(SERIAL_PACKET_POT, (uint8_t)constrain(percentage, 0, 100));
+}
+
+void FramedSerialLink::sendModeChangedNotification(SystemOpMode newMode) {
+    sendPacket(SERIAL_PACKET_MODE_CHANGED, modeValue(newMode));
+}
+
+void FramedSerialLink::sendAckModeChange(SystemOpMode acknowledgedMode) {
+    sendPacket(SERIAL_PACKET_ACK_MODE, modeValue(acknowledgedMode));
+}
+
+void FramedSerialLink::processIncomingSerial() {
+    while (Serial.available() > 0 && !cmdReady) {
+        uint8_t incomingByte = (uint8_t)Serial.read();
+
+        if (incomingByte != SERIAL_FRAME_DELIMITER) {
+            if (frameLength < SERIAL_FRAME_MAX_LEN) {
+                frameBuffer[frameLength++] = incomingByte;
+            } else {
+                frameOverflow = true;
+            }
+            continue;
+        }
+
+        // Delimiter: both ends of a frame carry one, so empty frames are expected
+        if (frameOverflow) {
+            LOG_WARN("ERR:FRAME_OVERFLOW");
+        } else if (frameLength > 0) {
+            size_t packetLength = SerialFrame::decode(frameBuffer, frameLength);
+            if (packetLength == 0) {
+                LOG_WARN("ERR:FRAME_CRC");
+            } else {
+                cmdReady = handlePacket(frameBuffer, packetLength);
+            }
+        }
+        frameLength = 0;
+        frameOverflow = false;
+    }
+}
+
+bool FramedSerialLink::handlePacket(const uint8_t* packet, size_t length) {
+    uint8_t type = packet[0];
+    size_t payloadLength = length - 1;
+    SerialCommand& command = pendingCommand;
+
+    switch (type) {
+        case SERIAL_PACKET_HELLO:
+            if (payloadLength != 1) break;
+            sendPacket(SERIAL_PACKET_HELLO_ACK, SERIAL_FRAME_VERSION);
+            return false;
+        case SERIAL_PACKET_SET_POS:
+            if (payloadLength != 1) break;
+            command.type = SerialCommandType::SET_POS;
+            command.position = packet[1];
+            return true;
+        case SERIAL_PACKET_TEMP:
+            if (payloadLength != 2) break;
+            command.type = SerialCommandType::SET_TEMP;
+            command.temperature = (int16_t)(packet[1] | (packet[2] << 8)) / 100.0f;
+            return true;
+        case SERIAL_PACKET_ALARM_STATE:
+            if (payloadLength != 1) break;
+            command.type = SerialCommandType::ALARM_STATE;
+            command.alarm = (packet[1] == 1);
+            return true;
+        case SERIAL_PACKET_MODE:
+            if (payloadLength != 1 || packet[1] > SERIAL_MODE_MANUAL) break;
+            command.type = packet[1] == SERIAL_MODE_MANUAL ? SerialCommandType::MODE_MANUAL
+                                                           : SerialCommandType::MODE_AUTOMATIC;
+            return true;
+        default:
+            break;
+    }
+    LOG_DEBUG("Unknown serial packet %u of %u bytes", type, (unsigned int)length);
+    return false;
+}
+
+void FramedSerialLink::sendPacket(uint8_t type, uint8_t value) {
+    uint8_t frame[SERIAL_FRAME_MAX_LEN + 2];
+    size_t length = SerialFrame::encode(type, &value, 1, frame + 1, SERIAL_FRAME_MAX_LEN);
+    frame[0] = SERIAL_FRAME_DELIMITER;
+    frame[length + 1] = SERIAL_FRAME_DELIMITER;
+    // One write: a log line drained later can never split the frame
+    Serial.write(frame, length + 2);
+}
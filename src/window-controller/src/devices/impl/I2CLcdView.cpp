@@ -19,6 +19,9 @@ void I2CLcdView::setup() {
     
     // Enable backlight for visibility
     lcd.backlight();
+
+    // init() leaves the display cleared
+    frame.markCleared();
     
     // Display boot message immediately
     displayBootingMessage();
@@ -26,19 +29,20 @@ void I2CLcdView::setup() {
 
 void I2CLcdView::clear() {
     lcd.clear();
+    frame.markCleared();
     forceUpdate = true;  // Force complete refresh on next update
 }
 
 void I2CLcdView::displayBootingMessage() {
-    lcd.clear();
-    lcd.setCursor(0, 0);
-    lcd.print(F("Booting Sys..."));
+    frame.clearFrame();
+    printLine(0, PSTR("Booting Sys..."));
+    frame.flush(lcd);
 }
 
 void I2CLcdView::displayReadyMessage() {
-    lcd.clear();
-    lcd.setCursor(0, 0);
-    lcd.print(F("System Ready"));
+    frame.clearFrame();
+    printLine(0, PSTR("System Ready"));
+    frame.flush(lcd);
     
     // Display message briefly, then clear for normal operation
     delay(1000);
@@ -53,118 +57,71 @@ void I2CLcdView::update(bool isAutoMode, int windowPercentage, float currentTemp
     bool positionChanged = (windowPercentage != prevWindowPercentage);
     bool temperatureChanged = (!isAutoMode && 
                               (abs(currentTemperature - prevCurrentTemperature) > TEMPERATURE_UPDATE_THRESHOLD));
+    bool alarmStateChanged = (isAlarmState != prevIsAlarmState);
 
     // Check if update is needed based on changes or refresh interval
     bool updateNeeded = forceUpdate || 
                        modeChanged || 
                        positionChanged || 
                        temperatureChanged ||
+                       alarmStateChanged ||
                        (currentTimeMs - lastUpdateTimeMs >= LCD_REFRESH_INTERVAL_MS);
 
-    // Check if alarm state changed
-    bool alarmStateChanged = (isAlarmState != prevIsAlarmState);
-
     // Skip update if not needed
     if (!updateNeeded) {
         return;
     }
-
-    // If system is in alarm state, show alarm message
-    if (isAlarmState) {
-        // Only update if alarm state just changed or force update
-        if (alarmStateChanged || forceUpdate) {
-            lcd.clear();
-            lcd.setCursor(0, 0);
-            lcd.print(F("ALARM STATE"));
-            lcd.setCursor(0, 1);
-            lcd.print(F("Reset Required"));
-            forceUpdate = false;
-        }
-        prevIsAlarmState = isAlarmState;
-        return;
-    }
-
-    // If just exited alarm state, clear display
-    if (alarmStateChanged && !isAlarmState) {
-        lcd.clear();
-        forceUpdate = true;
-    }
-
-    // Clear display if mode changed or force update requested
-    if (forceUpdate || modeChanged) {
-        lcd.clear();
-    }
     forceUpdate = false;
 
-    // Update previous alarm state at the end
-    prevIsAlarmState = isAlarmState;
+    // Compose the whole screen; flush() sends only what differs from the glass
+    frame.clearFrame();
+    char line[LCD_COLUMNS + 1];
 
-    //=========================================================================
-    // LINE 0: OPERATIONAL MODE DISPLAY
-    //=========================================================================
-    
-    lcd.setCursor(0, 0);
-    lcd.print(F("Mode: "));
-    
-    String modeString = isAutoMode ? F("AUTO  ") : F("MANUAL");
-    lcd.print(modeString);
-    
-    // Clear remaining characters on line if needed
-    clearRestOfLine(0, 6 + modeString.length());
-
-    //=========================================================================
-    // LINE 1: WINDOW POSITION DISPLAY
-    //=========================================================================
-    
-    lcd.setCursor(0, 1);
-    lcd.print(F("Pos: "));
-    
-    String positionString = String(windowPercentage) + "%";
-    lcd.print(positionString);
-    
-    // Clear remaining characters on line if needed
-    clearRestOfLine(1, 5 + positionString.length());
-
-    //=========================================================================
-    // LINE 2: TEMPERATURE DISPLAY (MANUAL MODE ONLY)
-    //=========================================================================
-    
-    if (LCD_ROWS >= 3) {  // Ensure display has at least 3 rows
-        lcd.setCursor(0, 2);
-        
-        if (!isAutoMode) {  // Show temperature only in MANUAL mode
+    if (isAlarmState) {
+        printLine(0, PSTR("ALARM STATE"));
+        printLine(1, PSTR("Reset Required"));
+    } else {
+        //=====================================================================
+        // LINE 0: OPERATIONAL MODE DISPLAY
+        //=====================================================================
+        snprintf_P(line, sizeof(line), PSTR("Mode: %S"), isAutoMode ? PSTR("AUTO") : PSTR("MANUAL"));
+        frame.print(0, 0, line);
+
+        //=====================================================================
+        // LINE 1: WINDOW POSITION DISPLAY
+        //=====================================================================
+        snprintf_P(line, sizeof(line), PSTR("Pos: %d%%"), windowPercentage);
+        frame.print(1, 0, line);
+
+        //=====================================================================
+        // LINE 2: TEMPERATURE DISPLAY (MANUAL MODE ONLY)
+        //=====================================================================
+        if (LCD_ROWS >= 3 && !isAutoMode) {
             if (currentTemperature > INVALID_TEMPERATURE + 100.0f) {  // Valid temperature
-                lcd.print(F("Temp: "));
-                lcd.print(currentTemperature, 1);  // One decimal place
-                lcd.print(F(" C"));
-                
-                // Calculate and clear remaining characters
-                int tempDisplayLength = 6 + String(currentTemperature, 1).length() + 2;
-                clearRestOfLine(2, tempDisplayLength);
+                char number[8];
+                dtostrf(currentTemperature, 1, 1, number);  // One decimal place
+                snprintf_P(line, sizeof(line), PSTR("Temp: %s C"), number);
+                frame.print(2, 0, line);
             } else {
                 // Invalid temperature - show placeholder
-                lcd.print(F("Temp: --- C"));
-                clearRestOfLine(2, 11);
+                printLine(2, PSTR("Temp: --- C"));
             }
-        } else {
-            // AUTOMATIC mode - clear temperature line
-            clearRestOfLine(2, 0);
         }
     }
-    
+
+    frame.flush(lcd);
+
     // Store current values for next comparison
     lastUpdateTimeMs = currentTimeMs;
     prevIsAutoMode = isAutoMode;
     prevWindowPercentage = windowPercentage;
     prevCurrentTemperature = currentTemperature;
+    prevIsAlarmState = isAlarmState;
 }
 
-void I2CLcdView::clearRestOfLine(int row, int startColumn) {
-    // Calculate number of characters to clear
-    int charactersToClear = LCD_COLUMNS - startColumn;
-    
-    // Clear remaining characters with spaces
-    for (int i = 0; i < charactersToClear; i++) {
-        lcd.print(F(" "));
-    }
-}
\ No newline at end of file
+void I2CLcdView::printLine(uint8_t row, PGM_P text) {
+    char line[LCD_COLUMNS + 1];
+    strncpy_P(line, text, LCD_COLUMNS);
+    line[LCD_COLUMNS] = '\0';
+    frame.print(row, 0, line);
+}
@@ -0,0 +1,123 @@
+#include "../api/SerialCommandParser.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#else
+// Host builds (benchmarks): the command table is ordinary constant data
+#include <strings.h>
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#define strlen_P strlen
+#define strncmp_P strncmp
+#define strcasecmp_P strcasecmp
+#endif
+
+namespace {
+
+/** @brief How the text after a command prefix is read */
+enum ArgKind : uint8_t {
+    ARG_NONE,   ///< No argument: the prefix is the whole command, case-insensitive
+    ARG_INT,    ///< Integer argument follows the prefix
+    ARG_FLOAT   ///< Decimal argument follows the prefix
+};
+
+struct CommandSpec {
+    char prefix[15];
+    SerialCommandType type;
+    ArgKind arg;
+};
+
+/** @brief Command table in flash; entries sharing a first letter must be adjacent */
+constexpr CommandSpec COMMANDS[] PROGMEM = {
+    {"SET_POS:", SerialCommandType::SET_POS, ARG_INT},
+    {"TEMP:", SerialCommandType::SET_TEMP, ARG_FLOAT},
+    {"ALARM_STATE:", SerialCommandType::ALARM_STATE, ARG_INT},
+    {"MODE:AUTOMATIC", SerialCommandType::MODE_AUTOMATIC, ARG_NONE},
+    {"MODE:MANUAL", SerialCommandType::MODE_MANUAL, ARG_NONE},
+};
+
+const uint8_t CMD_SET_POS = 0;
+const uint8_t CMD_TEMP = 1;
+const uint8_t CMD_ALARM_STATE = 2;
+const uint8_t CMD_MODE_FIRST = 3;
+const uint8_t CMD_MODE_COUNT = 2;
+
+// The dispatch switch below indexes the table by first letter
+static_assert(COMMANDS[CMD_SET_POS].prefix[0] == 'S', "COMMANDS order does not match the dispatch");
+static_assert(COMMANDS[CMD_TEMP].prefix[0] == 'T', "COMMANDS order does not match the dispatch");
+static_assert(COMMANDS[CMD_ALARM_STATE].prefix[0] == 'A', "COMMANDS order does not match the dispatch");
+static_assert(COMMANDS[CMD_MODE_FIRST].prefix[0] == 'M' && COMMANDS[CMD_MODE_FIRST + 1].prefix[0] == 'M',
+              "COMMANDS order does not match the dispatch");
+static_assert(sizeof(COMMANDS) / sizeof(COMMANDS[0]) == CMD_MODE_FIRST + CMD_MODE_COUNT,
+              "Every COMMANDS entry needs a case in the dispatch");
+
+/**
+ * @brief Matches a line against one table entry and reads its argument
+ * @return True if the line is this command
+ */
+bool match(const char* line, uint8_t index, SerialCommand& command) {
+    const CommandSpec& spec = COMMANDS[index];
+    ArgKind arg = (ArgKind)pgm_read_byte(&spec.arg);
+
+    if (arg == ARG_NONE) {
+        if (strcasecmp_P(line, spec.prefix) != 0) {
+            return false;
+        }
+    } else {
+        size_t prefixLength = strlen_P(spec.prefix);
+        if (strncmp_P(line, spec.prefix, prefixLength) != 0) {
+            return false;
+        }
+        const char* value = line + prefixLength;
+        if (arg == ARG_FLOAT) {
+            command.temperature = (float)atof(value);
+        } else {
+            command.position = (int)atol(value);
+        }
+    }
+    command.type = (SerialCommandType)pgm_read_byte(&spec.type);
+    return true;
+}
+
+} // namespace
+
+bool SerialCommandParser::parse(char* line, SerialCommand& command) {
+    command.type = SerialCommandType::NONE;
+    command.position = 0;
+
+    // Trim in place, as String::trim() did
+    while (isspace((unsigned char)*line)) {
+        line++;
+    }
+    char* end = line + strlen(line);
+    while (end > line && isspace((unsigned char)end[-1])) {
+        end--;
+    }
+    *end = '\0';
+
+    switch (line[0]) {
+        case 'S':
+            return match(line, CMD_SET_POS, command);
+        case 'T':
+            return match(line, CMD_TEMP, command);
+        case 'A':
+            if (!match(line, CMD_ALARM_STATE, command)) {
+                return false;
+            }
+            command.alarm = (command.position == 1);
+            return true;
+        case 'M':
+        case 'm':
+            for (uint8_t i = CMD_MODE_FIRST; i < CMD_MODE_FIRST + CMD_MODE_COUNT; i++) {
+                if (match(line, i, command)) {
+                    return true;
+                }
+            }
+            return false;
+        default:
+            return false;
+    }
+}
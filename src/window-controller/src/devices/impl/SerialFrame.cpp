@@ -0,0 +1,68 @@
+#include "../api/SerialFrame.h"
+
+uint8_t SerialFrame::crc8(const uint8_t* data, size_t length) {
+    // Bitwise: a 256 byte table would cost an eighth of the Uno's SRAM, or flash reads
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t SerialFrame::encode(uint8_t type, const uint8_t* payload, size_t payloadLength,
+                           uint8_t* out, size_t capacity) {
+    uint8_t packet[SERIAL_PACKET_MAX_LEN];
+    size_t packetLength = payloadLength + 2;
+    if (packetLength > SERIAL_PACKET_MAX_LEN || packetLength + 1 > capacity) {
+        return 0;
+    }
+    packet[0] = type;
+    for (size_t i = 0; i < payloadLength; i++) {
+        packet[1 + i] = payload[i];
+    }
+    packet[packetLength - 1] = crc8(packet, packetLength - 1);
+
+    // COBS: each zero becomes the distance to the next one, starting with a code byte
+    size_t codeIndex = 0;
+    size_t length = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < packetLength; i++) {
+        if (packet[i] != 0) {
+            out[length++] = packet[i];
+            code++;
+        }
+        if (packet[i] == 0 || code == 0xFF) {
+            out[codeIndex] = code;
+            codeIndex = length++;
+            code = 1;
+        }
+    }
+    out[codeIndex] = code;
+    return length;
+}
+
+size_t SerialFrame::decode(uint8_t* frame, size_t length) {
+    size_t read = 0;
+    size_t write = 0;
+    while (read < length) {
+        uint8_t code = frame[read++];
+        if (code == 0 || read + code - 1 > length) {
+            return 0;
+        }
+        for (uint8_t i = 1; i < code; i++) {
+            frame[write++] = frame[read++];
+        }
+        if (code < 0xFF && read < length) {
+            frame[write++] = 0;
+        }
+    }
+
+    // Type and CRC at least
+    if (write < 2 || crc8(frame, write - 1) != frame[write - 1]) {
+        return 0;
+    }
+    return write - 1;
+}
@@ -0,0 +1,98 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <Arduino.h>
+#include "config/config.h"
+
+/** @brief Log levels, compared against LOG_LEVEL at compile time */
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+/** @brief Maximum number of arguments of one log message */
+#define LOG_MAX_ARGS 2
+
+/*
+ * Logging macros. The format must be a string literal: it is kept in flash
+ * (PSTR) and only its address is queued. Arguments are ints, formatted with
+ * %d or %u. Messages above LOG_LEVEL expand to nothing, arguments included.
+ */
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(format, ...) Log::write(LOG_LEVEL_ERROR, PSTR(format), ##__VA_ARGS__)
+#else
+#define LOG_ERROR(format, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(format, ...) Log::write(LOG_LEVEL_WARN, PSTR(format), ##__VA_ARGS__)
+#else
+#define LOG_WARN(format, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(format, ...) Log::write(LOG_LEVEL_INFO, PSTR(format), ##__VA_ARGS__)
+#else
+#define LOG_INFO(format, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(format, ...) Log::write(LOG_LEVEL_DEBUG, PSTR(format), ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(format, ...) do {} while (0)
+#endif
+
+/**
+ * @struct LogRecord
+ * @brief Binary log message: flash address of the format plus raw arguments
+ */
+struct LogRecord {
+    PGM_P format;               ///< Format string in flash, also identifies the message
+    unsigned long timestampMs;  ///< millis() when the message was logged
+    uint8_t level;              ///< LOG_LEVEL_ERROR .. LOG_LEVEL_DEBUG
+    uint8_t argCount;           ///< Number of valid entries in args
+    int args[LOG_MAX_ARGS];     ///< Argument values
+};
+
+/**
+ * @class Log
+ * @brief Deferred logging to the serial link
+ *
+ * Messages are queued as LogRecords and formatted and written from the main
+ * loop only when the UART can take a whole line, so logging never blocks the
+ * FSM and a log line is never split by a protocol message. The link's
+ * protocol messages (POT:, MODE_CHANGED:, ACK_MODE:) do not go through here;
+ * the Control Unit ignores the log lines it does not recognize.
+ * Not for use from interrupt handlers.
+ */
+class Log {
+public:
+    /**
+     * @brief Queues a message (use the LOG_* macros instead)
+     * @param level Severity of the message
+     * @param format Format string in flash
+     * @param args Up to LOG_MAX_ARGS integer arguments
+     */
+    template <typename... Args>
+    static void write(uint8_t level, PGM_P format, Args... args) {
+        static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "Too many log arguments, see LOG_MAX_ARGS");
+        int values[] = {0, (int)args...};
+        push(level, format, values + 1, sizeof...(Args));
+    }
+
+    /**
+     * @brief Writes queued messages as long as whole lines fit in the UART buffer
+     */
+    static void drain();
+
+    /**
+     * @brief Writes all queued messages, blocking until done (setup() only)
+     */
+    static void flush();
+
+private:
+    static void push(uint8_t level, PGM_P format, const int* args, uint8_t argCount);
+};
+
+#endif // LOG_H
@@ -85,12 +85,12 @@ private:
     FsmEvent checkForEvents();
     
     /**
-     * @brief Parse serial command and extract event/value
-     * @param command Raw command string from serial link
+     * @brief Map a parsed serial command to an event/value
+     * @param command Parsed command from serial link
      * @param outEvent Detected event type (output parameter)
      * @param outCmdValue Numeric value from command (output parameter)
      */
-    void processSerialCommand(const String& command, FsmEvent& outEvent, int& outCmdValue);
+    void processSerialCommand(const SerialCommand& command, FsmEvent& outEvent, int& outCmdValue);
     
     /**
      * @brief Handle state transition and entry actions
@@ -0,0 +1,139 @@
+#include "../api/Log.h"
+
+// A line that does not fit in the transmit buffer could never be drained without blocking
+static_assert(LOG_LINE_MAX_LEN < SERIAL_TX_BUFFER_SIZE, "LOG_LINE_MAX_LEN must be below SERIAL_TX_BUFFER_SIZE");
+
+namespace {
+
+LogRecord records[LOG_BUFFER_RECORDS];  ///< Ring of messages waiting to be drained
+uint8_t head = 0;                       ///< Index of the oldest message
+uint8_t count = 0;                      ///< Number of queued messages
+unsigned int droppedCount = 0;          ///< Messages overwritten since the last report
+
+char line[LOG_LINE_MAX_LEN];            ///< Formatted line waiting for UART space
+uint8_t lineLength = 0;                 ///< Length of line, 0 when nothing is pending
+
+const char LEVEL_LETTERS[] = {'-', 'E', 'W', 'I', 'D'};
+const char DROPPED_FORMAT[] PROGMEM = "Log: %u records dropped";
+
+/**
+ * @brief Appends a character, keeping room for the line terminator
+ */
+void appendChar(uint8_t& length, char c) {
+    if (length < LOG_LINE_MAX_LEN - 2) {
+        line[length++] = c;
+    }
+}
+
+void appendText(uint8_t& length, const char* text) {
+    while (*text) {
+        appendChar(length, *text++);
+    }
+}
+
+/**
+ * @brief Formats a record as "[timestamp] L message\r\n" into line
+ *
+ * Supports %d, %u and %%; any other conversion prints its argument as %d.
+ */
+void formatLine(const LogRecord& record) {
+    char number[12];
+    uint8_t length = 0;
+
+    appendChar(length, '[');
+    appendText(length, ultoa(record.timestampMs, number, 10));
+    appendChar(length, ']');
+    appendChar(length, ' ');
+    appendChar(length, record.level < sizeof(LEVEL_LETTERS) ? LEVEL_LETTERS[record.level] : '?');
+    appendChar(length, ' ');
+
+    PGM_P p = record.format;
+    uint8_t argIndex = 0;
+    char c;
+    while ((c = pgm_read_byte(p++)) != '\0') {
+        if (c != '%') {
+            appendChar(length, c);
+            continue;
+        }
+        c = pgm_read_byte(p++);
+        if (c == '\0') {
+            break;
+        }
+        if (c == '%') {
+            appendChar(length, '%');
+        } else if (argIndex >= record.argCount) {
+            appendChar(length, '?');
+        } else if (c == 'u') {
+            appendText(length, utoa((unsigned int)record.args[argIndex++], number, 10));
+        } else {
+            appendText(length, itoa(record.args[argIndex++], number, 10));
+        }
+    }
+
+    line[length++] = '\r';
+    line[length++] = '\n';
+    lineLength = length;
+}
+
+/**
+ * @brief Formats the next line to write (drop notice or oldest message)
+ * @return False if nothing is queued
+ */
+bool loadLine() {
+    LogRecord record;
+    if (droppedCount > 0) {
+        record.format = DROPPED_FORMAT;
+        record.timestampMs = millis();
+        record.level = LOG_LEVEL_WARN;
+        record.argCount = 1;
+        record.args[0] = (int)droppedCount;
+        droppedCount = 0;
+    } else if (count > 0) {
+        record = records[head];
+        head = (head + 1) % LOG_BUFFER_RECORDS;
+        count--;
+    } else {
+        return false;
+    }
+    formatLine(record);
+    return true;
+}
+
+} // namespace
+
+void Log::push(uint8_t level, PGM_P format, const int* args, uint8_t argCount) {
+    uint8_t tail = (head + count) % LOG_BUFFER_RECORDS;
+    if (count < LOG_BUFFER_RECORDS) {
+        count++;
+    } else {
+        head = (head + 1) % LOG_BUFFER_RECORDS; // Oldest message overwritten
+        droppedCount++;
+    }
+
+    LogRecord& record = records[tail];
+    record.format = format;
+    record.timestampMs = millis();
+    record.level = level;
+    record.argCount = argCount;
+    for (uint8_t i = 0; i < argCount; i++) {
+        record.args[i] = args[i];
+    }
+}
+
+void Log::drain() {
+    while (lineLength > 0 || loadLine()) {
+        // Whole lines only: a partial line would merge with the next protocol message
+        if (Serial.availableForWrite() < lineLength) {
+            return;
+        }
+        Serial.write(line, lineLength);
+        lineLength = 0;
+    }
+}
+
+void Log::flush() {
+    while (lineLength > 0 || loadLine()) {
+        Serial.write(line, lineLength);
+        lineLength = 0;
+    }
+}
@@ -41,14 +41,12 @@ void SystemFSMImpl::run() {
     int commandValue = 0;
     
     // Process serial commands if available
-    if (serialLinkCtrl.commandAvailable()) {
-        String serialCommand = serialLinkCtrl.readCommand();
-        if (serialCommand.length() > 0) {
-            FsmEvent serialEvent;
-            processSerialCommand(serialCommand, serialEvent, commandValue);
-            if (serialEvent != FsmEvent::NONE) {
-                event = serialEvent;  // Prioritize serial commands
-            }
+    SerialCommand serialCommand;
+    if (serialLinkCtrl.commandAvailable() && serialLinkCtrl.readCommand(serialCommand)) {
+        FsmEvent serialEvent;
+        processSerialCommand(serialCommand, serialEvent, commandValue);
+        if (serialEvent != FsmEvent::NONE) {
+            event = serialEvent;  // Prioritize serial commands
         }
     }
 
@@ -100,22 +98,30 @@ FsmEvent SystemFSMImpl::checkForEvents() {
     return FsmEvent::NONE;
 }
 
-void SystemFSMImpl::processSerialCommand(const String& command, FsmEvent& outEvent, int& outCmdValue) {
+void SystemFSMImpl::processSerialCommand(const SerialCommand& command, FsmEvent& outEvent, int& outCmdValue) {
     outEvent = FsmEvent::NONE;
     outCmdValue = 0;
 
-    if (command.startsWith(F("SET_POS:"))) {
-        outEvent = FsmEvent::SERIAL_CMD_SET_POS;
-        outCmdValue = command.substring(8).toInt();
-    } else if (command.startsWith(F("TEMP:"))) {
-        outEvent = FsmEvent::SERIAL_CMD_SET_TEMP;
-        receivedTemperature = command.substring(5).toFloat();
-    } else if (command.startsWith(F("ALARM_STATE:"))) {
-        systemInAlarmState = (command.substring(12).toInt() == 1);
-    } else if (command.equalsIgnoreCase(F("MODE:AUTOMATIC"))) {
-        outEvent = FsmEvent::SERIAL_CMD_MODE_AUTO;
-    } else if (command.equalsIgnoreCase(F("MODE:MANUAL"))) {
-        outEvent = FsmEvent::SERIAL_CMD_MODE_MANUAL;
+    switch (command.type) {
+        case SerialCommandType::SET_POS:
+            outEvent = FsmEvent::SERIAL_CMD_SET_POS;
+            outCmdValue = command.position;
+            break;
+        case SerialCommandType::SET_TEMP:
+            outEvent = FsmEvent::SERIAL_CMD_SET_TEMP;
+            receivedTemperature = command.temperature;
+            break;
+        case SerialCommandType::ALARM_STATE:
+            systemInAlarmState = command.alarm;
+            break;
+        case SerialCommandType::MODE_AUTOMATIC:
+            outEvent = FsmEvent::SERIAL_CMD_MODE_AUTO;
+            break;
+        case SerialCommandType::MODE_MANUAL:
+            outEvent = FsmEvent::SERIAL_CMD_MODE_MANUAL;
+            break;
+        case SerialCommandType::NONE:
+            break;
     }
 }
 
@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include "config/config.h"
+#include "kernel/api/Log.h"
 
 // Interface headers for component abstraction
 #include "devices/api/LcdView.h"
@@ -12,7 +13,11 @@
 #include "devices/api/ServoMotorImpl.h"
 #include "devices/api/I2CLcdView.h"
 #include "devices/api/ArduinoPinInput.h"
+#if SERIAL_BINARY_PROTOCOL
+#include "devices/api/FramedSerialLink.h"
+#else
 #include "devices/api/ArduinoSerialLink.h"
+#endif
 #include "kernel/api/SystemFSMImpl.h"
 
 // Pointers to interfaces for component decoupling
@@ -22,6 +27,23 @@ UserInputSource* userInputSource = nullptr;
 ControlUnitLink* controlUnitLink = nullptr;
 ISystemFSM* systemFsm = nullptr;
 
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+extern char __heap_start;
+extern char* __brkval;
+
+/**
+ * @brief Free SRAM between the top of the heap and the stack
+ *
+ * Measured from loop() at a fixed call depth, so it only moves when the
+ * heap grows. It must stay flat under serial traffic: the receive path
+ * parses in place and does not allocate.
+ */
+int freeSram() {
+    char top;
+    return &top - (__brkval ? __brkval : &__heap_start);
+}
+#endif
+
 /**
  * @brief Arduino setup function - runs once at startup
  * 
@@ -31,13 +53,17 @@ ISystemFSM* systemFsm = nullptr;
 void setup() {
     Serial.begin(SERIAL_COM_BAUD_RATE);
     while (!Serial) { ; } // Wait for serial port to be ready
-    Serial.println(F("\n\n[Smart Window Controller - Arduino] System Starting..."));
+    LOG_INFO("[Smart Window Controller - Arduino] System Starting...");
 
     // Create instances of concrete implementations
     lcdView = new I2CLcdView(LCD_I2C_ADDRESS, LCD_COLUMNS, LCD_ROWS);
     servoMotor = new ServoMotorImpl(SERVO_MOTOR_PIN, WINDOW_SERVO_MIN_ANGLE_DEGREES, WINDOW_SERVO_MAX_ANGLE_DEGREES);
     userInputSource = new ArduinoPinInput(MODE_BUTTON_PIN, POTENTIOMETER_PIN, BUTTON_DEBOUNCE_DELAY_MS);
+#if SERIAL_BINARY_PROTOCOL
+    controlUnitLink = new FramedSerialLink();
+#else
     controlUnitLink = new ArduinoSerialLink();
+#endif
 
     // Create FSM instance, passing references to required modules
     systemFsm = new SystemFSMImpl(*servoMotor, *userInputSource, *controlUnitLink);
@@ -55,7 +81,8 @@ void setup() {
     // Display system ready message
     lcdView->displayReadyMessage();
 
-    Serial.println(F("System initialization completed."));
+    LOG_INFO("System initialization completed.");
+    Log::flush();
 }
 
 /**
@@ -64,6 +91,8 @@ void setup() {
  * Executes the main system loop consisting of:
  * 1. FSM execution cycle (event processing, state transitions)
  * 2. Display update with current system status
+ * 3. Free SRAM check (debug builds)
+ * 4. Queued log messages, as far as the UART accepts them
  */
 void loop() {
     // Execute one FSM cycle (event processing + state transitions)
@@ -80,4 +109,16 @@ void loop() {
             systemFsm->isSystemInAlarmState()
         );
     }
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+    // Report every new low, so a heap that keeps growing shows up in the log
+    static int lowestFreeSram = INT16_MAX;
+    int freeBytes = freeSram();
+    if (freeBytes < lowestFreeSram) {
+        lowestFreeSram = freeBytes;
+        LOG_DEBUG("Free SRAM low: %d bytes", freeBytes);
+    }
+#endif
+
+    Log::drain();
 }
\ No newline at end of file